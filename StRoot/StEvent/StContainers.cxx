@@ -138,6 +138,7 @@
 #include "StFttRawHit.h"
 #include "StFttCluster.h"
 #include "StFttPoint.h"
+#include "StFwdTrack.h"
 #include "StFgtHit.h"
 #include "StFgtPoint.h"
 #include "StFgtStrip.h"
@@ -210,6 +211,7 @@ StCollectionImp(FcsPoint)
 StCollectionImp(FttRawHit)
 StCollectionImp(FttCluster)
 StCollectionImp(FttPoint)
+StCollectionImp(FwdTrack)
 StCollectionImp(FgtHit)
 StCollectionImp(FgtPoint)
 StCollectionImp(FgtStrip)
@@ -149,6 +149,7 @@ class StFcsPoint;
 class StFttRawHit;
 class StFttCluster;
 class StFttPoint;
+class StFwdTrack;
 class StFgtHit;
 class StFgtPoint;
 class StFgtStrip;
@@ -226,6 +227,7 @@ StCollectionDef(FcsPoint)
 StCollectionDef(FttRawHit)
 StCollectionDef(FttCluster)
 StCollectionDef(FttPoint)
+StCollectionDef(FwdTrack)
 StCollectionDef(FgtHit)
 StCollectionDef(FgtPoint)
 StCollectionDef(FgtStrip)
@@ -225,6 +225,7 @@
 #include "StEpdCollection.h"
 #include "StFcsCollection.h"
 #include "StFttCollection.h"
+#include "StFwdTrackCollection.h"
 #include "StFmsCollection.h"
 #include "StRHICfCollection.h"
 #include "StRichCollection.h"
@@ -603,6 +604,22 @@ StEvent::fttCollection() const
     return ftt;
 }
 
+StFwdTrackCollection*
+StEvent::fwdTrackCollection()
+{
+    StFwdTrackCollection *fwd = 0;
+    _lookup(fwd, mContent);
+    return fwd;
+}
+
+const StFwdTrackCollection*
+StEvent::fwdTrackCollection() const
+{
+    StFwdTrackCollection *fwd = 0;
+    _lookup(fwd, mContent);
+    return fwd;
+}
+
 StFmsCollection*
 StEvent::fmsCollection()
 {
@@ -1324,6 +1341,12 @@ StEvent::setFttCollection(StFttCollection* val)
   _lookupAndSet(val, mContent);
 }
 
+void
+StEvent::setFwdTrackCollection(StFwdTrackCollection* val)
+{
+  _lookupAndSet(val, mContent);
+}
+
 void
 StEvent::setRHICfCollection(StRHICfCollection* val)
 {
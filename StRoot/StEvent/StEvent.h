@@ -200,6 +200,7 @@ class StEmcCollection;
 class StEpdCollection;
 class StFcsCollection;
 class StFttCollection;
+class StFwdTrackCollection;
 class StFmsCollection;
 class StRHICfCollection;
 class StRichCollection;
@@ -267,6 +268,8 @@ public:
     const StFcsCollection*              fcsCollection() const;
     StFttCollection*                    fttCollection();
     const StFttCollection*              fttCollection() const;
+    StFwdTrackCollection*               fwdTrackCollection();
+    const StFwdTrackCollection*         fwdTrackCollection() const;
     StFmsCollection*                    fmsCollection();
     const StFmsCollection*              fmsCollection() const;
     StRHICfCollection*                  rhicfCollection();
@@ -382,6 +385,7 @@ public:
     void setEpdCollection(StEpdCollection*);
     void setFcsCollection(StFcsCollection*);
     void setFttCollection(StFttCollection*);
+    void setFwdTrackCollection(StFwdTrackCollection*);
     void setFmsCollection(StFmsCollection*);
     void setRHICfCollection(StRHICfCollection*);
     void setRichCollection(StRichCollection*);
@@ -200,6 +200,7 @@ StEventClusteringHints::StEventClusteringHints()
     setBranch("StPhmdCollection",            "evt_aux",      7);
     setBranch("StRpsCollection",             "evt_aux",      7);
     setBranch("StFttCollection",             "evt_aux",      7);
+    setBranch("StFwdTrackCollection",        "evt_aux",      7);
     setBranch("StFstEvtCollection",          "evt_aux",      7);
     setBranch("StSsdHitCollection",          "evt_hits",     8);
     setBranch("StSstHitCollection",          "evt_hits",     8);
@@ -223,6 +224,7 @@ StEventClusteringHints::StEventClusteringHints()
     setBranch("StFmsCollection",             "event", 1);
     setBranch("StFcsCollection",             "event", 1);
     setBranch("StFttCollection",             "event", 1);
+    setBranch("StFwdTrackCollection",        "event", 1);
     setBranch("StRHICfCollection",           "event", 1);
     setBranch("StRichCollection",            "event", 1);
     setBranch("StTofCollection",             "event", 1);
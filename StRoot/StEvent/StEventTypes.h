@@ -194,6 +194,8 @@
 #include "StFcsHit.h"
 #include "StFcsPoint.h"
 #include "StFttRawHit.h"
+#include "StFwdTrackCollection.h"
+#include "StFwdTrack.h"
 #include "StFmsCollection.h"
 #include "StFmsCluster.h"
 #include "StFmsHit.h"
@@ -0,0 +1,38 @@
+/***************************************************************************
+ *
+ * StFwdTrack.cxx
+ *
+ ***************************************************************************
+ *
+ * Description: Implementation of StFwdTrack, the StEvent forward track
+ *
+ ***************************************************************************/
+#include "StFwdTrack.h"
+#include "St_base/StMessMgr.h"
+
+ClassImp(StFwdTrack)
+
+StFwdTrack::StFwdTrack() : StObject(),
+    mStatus(0), mCharge(0), mChi2(0), mNdf(0), mNFttHits(0), mNFstHits(0), mIdTruth(0), mQaTruth(0),
+    mProjected(0), mEcalCluster(0), mHcalCluster(0),
+    mEcalMatchDist(0), mHcalMatchDist(0), mEcalEoverP(0), mHcalEoverP(0) {
+    for ( int i = 0; i < kNProjections; i++ )
+        mProjectionSigmaXY[i] = 0;
+}
+
+StFwdTrack::~StFwdTrack() { /* no op */ }
+
+void StFwdTrack::setProjection(int plane, const StThreeVectorF& x, float sigmaXY) {
+    if ( plane < 0 || plane >= kNProjections )
+        return;
+    mProjected |= ( 1 << plane );
+    mProjection[plane] = x;
+    mProjectionSigmaXY[plane] = sigmaXY;
+}
+
+void StFwdTrack::print(int opt) {
+    LOG_INFO << "StFwdTrack: q = " << (int)mCharge << ", p = " << mMomentum
+             << ", converged = " << fitConverged() << ", chi2/ndf = " << mChi2 << "/" << mNdf
+             << ", nFtt = " << nFttHits() << ", nFst = " << nFstHits()
+             << ", ecal d = " << ecalMatchDistance() << ", hcal d = " << hcalMatchDistance() << endm;
+}
@@ -0,0 +1,133 @@
+/**************************************************************************
+ *
+ * StFwdTrack.h
+ *
+ **************************************************************************
+ *
+ * Description: Declaration of StFwdTrack, the StEvent forward (FST + FTT)
+ * track structure.
+ * Filled by StFwdTrackMaker with the fit summary, the fitted state at the
+ * first measurement, the projections of the track to the FST, FTT, FCS ECal
+ * and HCal planes and the FCS clusters matched to it. StMuDstMaker builds
+ * the compact StMuFwdTrack from it.
+ *
+ **************************************************************************/
+#ifndef StFwdTrack_h
+#define StFwdTrack_h
+
+#include "StThreeVectorF.hh"
+#include "StObject.h"
+#include "StEnumerations.h"
+#include "StContainers.h"
+
+class StFcsCluster;
+
+class StFwdTrack : public StObject {
+public:
+    /// planes the track is projected to
+    enum ProjectionPlane { kFst0=0, kFst1, kFst2, kFtt0, kFtt1, kFtt2, kFtt3, kEcal, kHcal, kNProjections };
+    enum StatusBit { kFitConverged=1, kFstRefit=2 };
+
+    StFwdTrack();
+    ~StFwdTrack();
+
+    bool  fitConverged() const;
+    bool  fstRefit()     const; // refit with the FST hits
+    short charge()       const;
+    float chi2()         const;
+    int   ndf()          const;
+    int   nFttHits()     const;
+    int   nFstHits()     const;
+    int   idTruth()      const; // dominant MC track of the seed
+    int   qaTruth()      const; // % of the seed hits from idTruth
+
+    const StThreeVectorF& momentum() const; // at the first point of the fit
+    const StThreeVectorF& origin()   const; // first point of the fit
+
+    bool  hasProjection(int plane) const;
+    const StThreeVectorF& projection(int plane) const; // position on the plane (cm)
+    float projectionSigmaXY(int plane) const; // sqrt(sx^2 + sy^2) of the projected position (cm)
+
+    // matched FCS clusters (owned by StFcsCollection), 0 if none
+    StFcsCluster* ecalCluster() const;
+    StFcsCluster* hcalCluster() const;
+    // x-y distance (cm) between the track and the matched cluster, at the z of the cluster
+    float ecalMatchDistance() const;
+    float hcalMatchDistance() const;
+    // energy of the matched cluster over the track momentum
+    float ecalEoverP() const;
+    float hcalEoverP() const;
+
+    void setStatus(unsigned short status);
+    void setCharge(short q);
+    void setChi2(float chi2);
+    void setNdf(int ndf);
+    void setNHits(int nFtt, int nFst);
+    void setIdTruth(int idTruth, int qaTruth);
+    void setMomentum(const StThreeVectorF& p);
+    void setOrigin(const StThreeVectorF& x);
+    void setProjection(int plane, const StThreeVectorF& x, float sigmaXY);
+    void setEcalMatch(StFcsCluster* cluster, float distance, float eOverP);
+    void setHcalMatch(StFcsCluster* cluster, float distance, float eOverP);
+
+    void print(int option=0);
+
+private:
+    UShort_t       mStatus;
+    Char_t         mCharge;
+    Float_t        mChi2;
+    Int_t          mNdf;
+    UChar_t        mNFttHits;
+    UChar_t        mNFstHits;
+    Int_t          mIdTruth;
+    UShort_t       mQaTruth;
+    StThreeVectorF mMomentum;
+    StThreeVectorF mOrigin;
+
+    UShort_t       mProjected;                     // bit i set if the projection to plane i exists
+    StThreeVectorF mProjection[kNProjections];
+    Float_t        mProjectionSigmaXY[kNProjections];
+
+    StFcsCluster*  mEcalCluster;
+    StFcsCluster*  mHcalCluster;
+    Float_t        mEcalMatchDist;
+    Float_t        mHcalMatchDist;
+    Float_t        mEcalEoverP;
+    Float_t        mHcalEoverP;
+
+    ClassDef(StFwdTrack, 1)
+};
+
+inline bool  StFwdTrack::fitConverged() const { return mStatus & kFitConverged; }
+inline bool  StFwdTrack::fstRefit() const { return mStatus & kFstRefit; }
+inline short StFwdTrack::charge() const { return mCharge; }
+inline float StFwdTrack::chi2() const { return mChi2; }
+inline int   StFwdTrack::ndf() const { return mNdf; }
+inline int   StFwdTrack::nFttHits() const { return mNFttHits; }
+inline int   StFwdTrack::nFstHits() const { return mNFstHits; }
+inline int   StFwdTrack::idTruth() const { return mIdTruth; }
+inline int   StFwdTrack::qaTruth() const { return mQaTruth; }
+inline const StThreeVectorF& StFwdTrack::momentum() const { return mMomentum; }
+inline const StThreeVectorF& StFwdTrack::origin() const { return mOrigin; }
+inline bool  StFwdTrack::hasProjection(int plane) const { return plane >= 0 && plane < kNProjections && ( mProjected >> plane & 1 ); }
+inline const StThreeVectorF& StFwdTrack::projection(int plane) const { return mProjection[ hasProjection(plane) ? plane : 0 ]; }
+inline float StFwdTrack::projectionSigmaXY(int plane) const { return hasProjection(plane) ? mProjectionSigmaXY[plane] : -1; }
+inline StFcsCluster* StFwdTrack::ecalCluster() const { return mEcalCluster; }
+inline StFcsCluster* StFwdTrack::hcalCluster() const { return mHcalCluster; }
+inline float StFwdTrack::ecalMatchDistance() const { return mEcalCluster ? mEcalMatchDist : -1; }
+inline float StFwdTrack::hcalMatchDistance() const { return mHcalCluster ? mHcalMatchDist : -1; }
+inline float StFwdTrack::ecalEoverP() const { return mEcalEoverP; }
+inline float StFwdTrack::hcalEoverP() const { return mHcalEoverP; }
+
+inline void StFwdTrack::setStatus(unsigned short status) { mStatus = status; }
+inline void StFwdTrack::setCharge(short q) { mCharge = q; }
+inline void StFwdTrack::setChi2(float chi2) { mChi2 = chi2; }
+inline void StFwdTrack::setNdf(int ndf) { mNdf = ndf; }
+inline void StFwdTrack::setNHits(int nFtt, int nFst) { mNFttHits = nFtt; mNFstHits = nFst; }
+inline void StFwdTrack::setIdTruth(int idTruth, int qaTruth) { mIdTruth = idTruth; mQaTruth = qaTruth; }
+inline void StFwdTrack::setMomentum(const StThreeVectorF& p) { mMomentum = p; }
+inline void StFwdTrack::setOrigin(const StThreeVectorF& x) { mOrigin = x; }
+inline void StFwdTrack::setEcalMatch(StFcsCluster* cluster, float distance, float eOverP) { mEcalCluster = cluster; mEcalMatchDist = distance; mEcalEoverP = eOverP; }
+inline void StFwdTrack::setHcalMatch(StFcsCluster* cluster, float distance, float eOverP) { mHcalCluster = cluster; mHcalMatchDist = distance; mHcalEoverP = eOverP; }
+
+#endif  // StFwdTrack_h
@@ -0,0 +1,29 @@
+/***************************************************************************
+ *
+ * StFwdTrackCollection.cxx
+ *
+ ***************************************************************************
+ *
+ * Description: Collection of the forward tracks of the event
+ *
+ ***************************************************************************/
+#include "StEvent/StFwdTrackCollection.h"
+
+#include "StEvent/StFwdTrack.h"
+
+ClassImp(StFwdTrackCollection)
+
+StFwdTrackCollection::StFwdTrackCollection() {/* no operation*/}
+
+StFwdTrackCollection::~StFwdTrackCollection() {/* no operation */}
+
+void StFwdTrackCollection::addTrack(StFwdTrack* track){mTracks.push_back(track);}
+StSPtrVecFwdTrack& StFwdTrackCollection::tracks() {return mTracks;}
+const StSPtrVecFwdTrack& StFwdTrackCollection::tracks() const {return mTracks;}
+unsigned int StFwdTrackCollection::numberOfTracks() const { return mTracks.size(); }
+
+void StFwdTrackCollection::print(int option) {
+    cout << "  *** Print Fwd track collection *** " << endl;
+    for ( unsigned int i = 0; i < mTracks.size(); i++ )
+        mTracks[i]->print(option);
+}
@@ -0,0 +1,41 @@
+/***************************************************************************
+ *
+ * StFwdTrackCollection.h
+ *
+ ***************************************************************************
+ *
+ * Description:
+ * Collection of the forward (FST + FTT) tracks of the event.
+ * This collection owns the tracks, and is itself owned by StEvent.
+ * Any track added with addTrack() must be allocated with new, and not be
+ * owned anywhere else.
+ *
+ ***************************************************************************/
+#ifndef StFwdTrackCollection_hh
+#define StFwdTrackCollection_hh
+
+#include "Stiostream.h"
+#include "StObject.h"
+#include "StContainers.h"
+
+class StFwdTrack;
+
+class StFwdTrackCollection : public StObject {
+public:
+    StFwdTrackCollection();
+    ~StFwdTrackCollection();
+
+    void addTrack(StFwdTrack*);                // Add a track
+    StSPtrVecFwdTrack& tracks();               // Return the track list
+    const StSPtrVecFwdTrack& tracks() const;   // Return the track list
+    unsigned int numberOfTracks() const;       // Return the number of tracks
+
+    void print(int option=1);
+
+private:
+    StSPtrVecFwdTrack mTracks;
+
+    ClassDef(StFwdTrackCollection,1)
+};
+
+#endif
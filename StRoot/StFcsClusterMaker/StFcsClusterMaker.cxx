@@ -75,8 +75,8 @@
 #include "StMuDSTMaker/COMMON/StMuEvent.h"
 
 #include <cmath>
+#include <algorithm>
 #include "TMath.h"
-#include "TVector2.h"
 
 ClassImp(StFcsClusterMaker)
 
@@ -151,23 +151,50 @@ int StFcsClusterMaker::makeCluster(int det) {
       });
   }    
 
+  //dense (column,row) grid of the clustered hits, so neighbors are found by looking at the cells around a hit
+  mNColumn = mDb->nColumn(det);
+  mNRow    = mDb->nRow(det);
+  if(mNColumn<0) mNColumn=0;
+  if(mNRow<0)    mNRow=0;
+  mGrid.assign(mNColumn*mNRow,-1);
+  mOffGrid.clear();
+  mHitX.resize(nhit);
+  mHitY.resize(nhit);
+  mHitE.resize(nhit);
+  if(nhit>0) mDb->getLocalXYinCell(nhit,&hits[0],&mHitX[0],&mHitY[0]);
+  mHitCluster.assign(nhit,-1);
+  mSums.clear();
+  mNeighborMark.clear();
+  mNeighborHit.clear();
+  int ehp = mDb->ecalHcalPres(det);
+  float thr=1.01;
+  if(ehp==0) thr=mNeighborDistance_Ecal;
+  if(ehp==1) thr=mNeighborDistance_Hcal;
+  int range = int(thr) + 1; //edge columns of leaky Hcal are up to 0.6 cell closer than their column number
+
   for(int i=0; i<nhit; i++){ //loop over all hits 
     StFcsHit* hit=hits[i];
     float e=hit->energy();
     if(e < mTowerEThreshold && mSortById==0) break;
-    float neighborClusterId=-1;
+    int col=mDb->getColumnNumber(det,hit->id());
+    int row=mDb->getRowNumber(det,hit->id());
+    mHitE[i]=e;
+    int neighborClusterId=-1;
     float minDistance=999.0;
     int ncluster = clusters.size();
     int nNeighbor= 0;
     StPtrVecFcsCluster neighbor;
-    for(int j=0; j<ncluster; j++){ //check all existing cluster
+    int nfound = findNeighbors(i,col,row,thr,range);
+    for(int n=0; n<nfound; n++){ //check clusters touching the hit, in cluster order
+      int j=mNeighborIds[n];
       StFcsCluster* clu=clusters[j];
-      float neighborTowerE = isNeighbor(hit,clu);
+      //energy of the last added tower in cluster which is neighbor to the hit
+      float neighborTowerE = hits[mNeighborHit[j]]->energy();
       if(neighborTowerE>0.0) { //found neighbor cluster
 	neighbor.push_back(clu);
 	nNeighbor++;	      
 	if(neighborTowerE * mTowerERatio2Split > e){ //merge to existing cluster
-	  float d = distance(hit,clu);
+	  float d = distance(i,clu);
 	  if(d * mDistanceAdvantage < minDistance){
 	    neighborClusterId=j;
 	    minDistance=d;
@@ -182,9 +209,10 @@ int StFcsClusterMaker::makeCluster(int det) {
 	cluster = new StFcsCluster();
 	cluster->setId(ncluster);
 	cluster->setDetectorId(det);
-	cluster->hits().push_back(hit);
-	hit->setCluster(cluster);
-	updateCluster(cluster);
+	mSums.push_back(ClusterSum());
+	mNeighborMark.push_back(-1);
+	mNeighborHit.push_back(-1);
+	addHit(cluster,ncluster,hit,i,col,row);
 	mFcsCollection->addCluster(det,cluster); 
 	neighbor.push_back(cluster);
 	nNeighbor++;
@@ -196,9 +224,7 @@ int StFcsClusterMaker::makeCluster(int det) {
       //found neighbor tower which has higher energy
       //add to the cluster with closest cluster
       cluster = clusters[neighborClusterId];
-      cluster->hits().push_back(hit);	   
-      hit->setCluster(cluster);
-      updateCluster(cluster);
+      addHit(cluster,neighborClusterId,hit,i,col,row);
     }
     if(nNeighbor>1) { //more than 1 neighbors found
       for(int k=0; k<nNeighbor-1; k++){
@@ -212,16 +238,15 @@ int StFcsClusterMaker::makeCluster(int det) {
     }
   }
   
-  //loop over all found cluster and fill fourMomentum and do moment analysis
+  //moment analysis for all found clusters, then fill fourMomentum and categorize
+  clusterMomentAnalysis(det,nhit);
   int nc = clusters.size();
   for(int j=0; j<nc; j++){
     StFcsCluster* clu=clusters[j];
     StThreeVectorD xyz = mDb->getStarXYZfromColumnRow(det,clu->x(),clu->y());
     clu->setFourMomentum(mDb->getLorentzVector(xyz,clu->energy(),0.0));
-    const StLorentzVectorD& p = clu->fourMomentum();
+    //const StLorentzVectorD& p = clu->fourMomentum();
     //LOG_DEBUG << Form("momentum= %lf %lf %lf %lf", p.px(), p.py(), p.pz(), p.e()) << endm;
-    int ret=clusterMomentAnalysis(clu,mTowerEThreMoment); //moment analysis with default threshold
-    if(ret==kStErr) ret=clusterMomentAnalysis(clu,0.0);   //Redo with 0 threshold
     categorization(clu);
   }
 
@@ -272,111 +297,132 @@ int StFcsClusterMaker::makeCluster(int det) {
   return kStOk;
 }
 
-//check if the hit is next to hits in the cluster
-//returning energy of highest tower in cluster which is neighbor to the hit
-float StFcsClusterMaker::isNeighbor(StFcsHit* hit, StFcsCluster* clu){ 
-    int nhit = clu->hits().size();
-    float ne=0.0;
-    for(int i=0; i<nhit; i++){
-	StFcsHit* h=clu->hits()[i];
-	int ehp = mDb->ecalHcalPres(h->detectorId());
-	float thr=1.01;
-	if(ehp==0) thr=mNeighborDistance_Ecal;
-	if(ehp==1) thr=mNeighborDistance_Hcal;
-	float d = distance(hit,h);
-	float e = h->energy();
-	if(d < thr) ne=e;
+//find clusters with a tower next to (sorted) hit i, looking at the grid cells around it
+//mNeighborIds is filled in cluster order, and mNeighborHit[cluster] is the last added tower of the cluster
+//which is neighbor to the hit
+int StFcsClusterMaker::findNeighbors(int i, int col, int row, float thr, int range){
+    mNeighborIds.clear();
+    const float x=mHitX[i];
+    const float y=mHitY[i];
+    auto check = [&](int k){
+	float dx=x-mHitX[k];
+	float dy=y-mHitY[k];
+	float d=sqrt(dx*dx + dy*dy);
+	if(d >= thr) return;
+	int j=mHitCluster[k];
+	if(mNeighborMark[j]!=i){
+	    mNeighborMark[j]=i;
+	    mNeighborHit[j]=k;
+	    mNeighborIds.push_back(j);
+	}else if(k>mNeighborHit[j]){
+	    mNeighborHit[j]=k;
+	}
+    };
+    int c1=std::max(col-range,1), c2=std::min(col+range,mNColumn);
+    int r1=std::max(row-range,1), r2=std::min(row+range,mNRow);
+    for(int r=r1; r<=r2; r++){
+	const int* cell = &mGrid[(r-1)*mNColumn];
+	for(int c=c1; c<=c2; c++){
+	    if(cell[c-1]>=0) check(cell[c-1]);
+	}
     }
-    return ne;
-}
-
-// distance between 2 hits in cell unit
-float StFcsClusterMaker::distance(StFcsHit* hit1, StFcsHit* hit2){
-    int   det1=hit1->detectorId();
-    int   det2=hit2->detectorId();
-    if(det1 != det2) return 999.0;
-    float x1,x2,y1,y2;
-    mDb->getLocalXYinCell(hit1,x1,y1);
-    mDb->getLocalXYinCell(hit2,x2,y2);
-    float dx=x1-x2;
-    float dy=y1-y2;
-    return sqrt(dx*dx + dy*dy);
+    int noff=mOffGrid.size();
+    for(int n=0; n<noff; n++) check(mOffGrid[n]);
+    std::sort(mNeighborIds.begin(),mNeighborIds.end());
+    return mNeighborIds.size();
 }
 
-// distance between a hit and cluster center
-float StFcsClusterMaker::distance(StFcsHit* hit, StFcsCluster* clu){
-    int   det1=hit->detectorId();
-    int   det2=clu->detectorId();
-    if(det1 != det2) return 999.0;
-    float x,y;
-    mDb->getLocalXYinCell(hit,x,y);
-    float dx = x - clu->x();
-    float dy = y - clu->y();
+// distance between (sorted) hit i and cluster center
+float StFcsClusterMaker::distance(int i, StFcsCluster* clu){
+    float dx = mHitX[i] - clu->x();
+    float dy = mHitY[i] - clu->y();
     return sqrt(dx*dx + dy*dy);
 }
 
-//Fill in number of towers, cluster energy and weighted mean x/y [local grid] based on hits collection
-void StFcsClusterMaker::updateCluster(StFcsCluster* clu){
-    int nhit=clu->hits().size();
-    double etot=0.0, xe=0.0, ye=0.0;
-    double wtot=0.0, xw=0.0, yw=0.0;
-    for(int i=0; i<nhit; i++){
-	StFcsHit* hit=clu->hits()[i];	
-	float x,y;
-	mDb->getLocalXYinCell(hit,x,y);
-	double e= hit->energy();	
-	double w=log(e + 1.0 - mTowerEThreMoment);
-	if(w<0.0) w=0.0;
-	etot+= e; xe += x*e; ye += y*e;
-	wtot+= w; xw += x*w; yw += y*w;
+//Add (sorted) hit i to cluster j, and update number of towers, cluster energy and weighted mean x/y [local grid]
+//from the running sums
+void StFcsClusterMaker::addHit(StFcsCluster* clu, int j, StFcsHit* hit, int i, int col, int row){
+    clu->hits().push_back(hit);
+    hit->setCluster(clu);
+    mHitCluster[i]=j;
+    if(col>=1 && col<=mNColumn && row>=1 && row<=mNRow){
+	int& cell = mGrid[(row-1)*mNColumn + col-1];
+	if(cell>=0) mOffGrid.push_back(cell); //same cell twice, keep both visible
+	cell=i;
+    }else{
+	mOffGrid.push_back(i);
     }
-    clu->setNTowers(nhit);
-    clu->setEnergy(etot);
-    if(wtot>0.0){
-	clu->setX(xw/wtot);
-	clu->setY(yw/wtot);
-    }else if(etot>0.0) {
-	clu->setX(xe/etot);
-	clu->setY(ye/etot);
+    ClusterSum& s = mSums[j];
+    float x=mHitX[i];
+    float y=mHitY[i];
+    double e= mHitE[i];	
+    double w=log(e + 1.0 - mTowerEThreMoment);
+    if(w<0.0) w=0.0;
+    s.etot+= e; s.xe += x*e; s.ye += y*e;
+    s.wtot+= w; s.xw += x*w; s.yw += y*w;
+    clu->setNTowers(clu->hits().size());
+    clu->setEnergy(s.etot);
+    if(s.wtot>0.0){
+	clu->setX(s.xw/s.wtot);
+	clu->setY(s.yw/s.wtot);
+    }else if(s.etot>0.0) {
+	clu->setX(s.xe/s.etot);
+	clu->setY(s.ye/s.etot);
     }else{
 	clu->setX(0.0);
         clu->setY(0.0);
     }
 }
 
-// perform cluster moment analysis, return kStErr if no tower found above ecut
-int StFcsClusterMaker::clusterMomentAnalysis(StFcsCluster* clu, float ecut){
-    int nhit=clu->hits().size();
-    double wtot=0.0, xx=0.0, yy=0.0, sx=0.0, sy=0.0, sxy=0.0;
+//sum moments of the clusters over the clustered hits, only for clusters to be redone if retryOnly
+void StFcsClusterMaker::accumulateMoments(int nhit, bool retryOnly){
     for(int i=0; i<nhit; i++){
-	StFcsHit* hit=clu->hits()[i];	
-	float xh,yh;
-	mDb->getLocalXYinCell(hit,xh,yh);
-	double e= hit->energy();	
-	double w=log(e + 1.0 - ecut);
+	int j=mHitCluster[i];
+	if(j<0) continue;
+	ClusterMoment& m = mMoments[j];
+	if(retryOnly && !m.retry) continue;
+	float xh=mHitX[i];
+	float yh=mHitY[i];
+	double w=log(mHitE[i] + 1.0 - m.ecut);
 	if(w>0.0){
-	    wtot+= w; 
-	    xx += xh*w; 
-	    yy += yh*w;
-	    sx += xh*xh*w; 
-	    sy += yh*yh*w; 
-	    sxy+= xh*yh*w; 
+	    m.wtot+= w; 
+	    m.xx += xh*w; 
+	    m.yy += yh*w;
+	    m.sx += xh*xh*w; 
+	    m.sy += yh*yh*w; 
+	    m.sxy+= xh*yh*w; 
 	}
     }
-    if(wtot<=0.0){ //cluster has no tower above ecoff
-      if(ecut>0.0){
-	return kStErr; // return error so one can re-try with lower threshold
-      }else{ //even with ecut=0.0, no energy!?
-	clu->setSigmaMin(0.0);
-	clu->setSigmaMax(0.0);
-	return kStOK;
-      }
-    }else{
-        double x = xx/wtot;
-	double y = yy/wtot;
-	double sigx  = sqrt(fabs(sx / wtot - std::pow(x, 2.0)));
-	double sigy  = sqrt(fabs(sy / wtot - std::pow(y, 2.0)));
-	double sigxy = sxy/wtot - x*y;
+}
+
+// perform cluster moment analysis for all clusters, with mTowerEThreMoment and redone with 0 threshold
+// for clusters with no tower above it. Sums are made in a few passes over all clustered hits.
+void StFcsClusterMaker::clusterMomentAnalysis(int det, int nhit){
+    StSPtrVecFcsCluster& clusters = mFcsCollection->clusters(det);
+    int nc=clusters.size();
+    mMoments.assign(nc,ClusterMoment());
+    for(int j=0; j<nc; j++) mMoments[j].ecut=mTowerEThreMoment;
+    accumulateMoments(nhit,false);
+    bool retry=false;
+    for(int j=0; j<nc; j++){
+	ClusterMoment& m = mMoments[j];
+	if(m.wtot<=0.0 && m.ecut>0.0){ //cluster has no tower above ecut, redo with 0 threshold
+	    m = ClusterMoment();
+	    m.retry=true;
+	    retry=true;
+	}
+    }
+    if(retry) accumulateMoments(nhit,true);
+
+    //direction of major axis
+    for(int j=0; j<nc; j++){
+	ClusterMoment& m = mMoments[j];
+	if(m.wtot<=0.0) continue;
+        double x = m.xx/m.wtot;
+	double y = m.yy/m.wtot;
+	double sigx  = sqrt(fabs(m.sx / m.wtot - std::pow(x, 2.0)));
+	double sigy  = sqrt(fabs(m.sy / m.wtot - std::pow(y, 2.0)));
+	double sigxy = m.sxy/m.wtot - x*y;
 	double dsig2 = sigx*sigx - sigy*sigy;
 	double aA = sqrt(dsig2 * dsig2 + 4.0 * sigxy * sigxy) + dsig2;
 	double bB = 2.0 * sigxy;
@@ -391,37 +437,38 @@ int StFcsClusterMaker::clusterMomentAnalysis(StFcsCluster* clu, float ecut){
 	while (theta < -M_PI / 2.0) {
 	    theta += M_PI;
 	} 
-	clu->setTheta(theta);
-	clu->setSigmaMin(getSigma(clu, theta, ecut));
-	clu->setSigmaMax(getSigma(clu, theta - M_PI/2.0, ecut));	
+	clusters[j]->setTheta(theta);
+	m.cost=cos(theta);
+	m.sint=sin(theta);
     }
-    return kStOK;
-}
 
-float StFcsClusterMaker::getSigma(StFcsCluster* clu, double theta, float ecut){
-    double sigma = 0;
-    // 2-d vector vaxis define the axis
-    TVector2 vaxis(cos(theta), sin(theta));
-    double wtot =0.0;
-    int nhit=clu->hits().size();
-    for (int i=0; i<nhit; i++){ // loop over all hits in cluster
-	StFcsHit* hit = clu->hits()[i];
-        int det=hit->detectorId();
-	float x,y;
-	mDb->getLocalXYinCell(hit,x,y);
-	// the 2-d vector from the "center" of cluster to tower
-	TVector2 v1(x - clu->x(), y - clu->y());
-	// perpendicular distance to the axis = length of the component of vector                                             
-	// "v1" that is norm to "vaxis"                                                                                       
-	double dis = (v1.Norm(vaxis)).Mod();
-	// contribution to sigma                                                                                              
-	double w = log(hit->energy() + 1.0 - ecut);
+    //sigma along minor (distance to major axis) and major axis, with cluster center from addHit()
+    for(int i=0; i<nhit; i++){
+	int j=mHitCluster[i];
+	if(j<0) continue;
+	ClusterMoment& m = mMoments[j];
+	if(m.wtot<=0.0) continue;
+	double w = log(mHitE[i] + 1.0 - m.ecut);
 	if(w>=0.0){
-	    wtot  += w;
-	    sigma += w * dis * dis;
+	    float dx = mHitX[i] - clusters[j]->x();
+	    float dy = mHitY[i] - clusters[j]->y();
+	    double dmin = dy*m.cost - dx*m.sint;
+	    double dmax = dx*m.cost + dy*m.sint;
+	    m.wsig += w;
+	    m.smin += w * dmin * dmin;
+	    m.smax += w * dmax * dmax;
+	}
+    }
+    for(int j=0; j<nc; j++){
+	const ClusterMoment& m = mMoments[j];
+	if(m.wtot<=0.0 || m.wsig<=0.0){
+	    clusters[j]->setSigmaMin(0.0);
+	    clusters[j]->setSigmaMax(0.0);
+	}else{
+	    clusters[j]->setSigmaMin((float)sqrt(m.smin / m.wsig));
+	    clusters[j]->setSigmaMax((float)sqrt(m.smax / m.wsig));
 	}
     }
-    return wtot > 0.0 ? (float)sqrt(sigma / wtot) : 0.0;
 }
 
 void StFcsClusterMaker::categorization(StFcsCluster* cluster){
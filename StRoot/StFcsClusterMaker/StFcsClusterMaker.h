@@ -78,15 +78,28 @@ public:
     void sortById(int v=1){mSortById=v;}
 
  private:
+    //running sums of a cluster for its energy and log weighted center, updated as hits are added
+    struct ClusterSum {
+	double etot=0.0, xe=0.0, ye=0.0;
+	double wtot=0.0, xw=0.0, yw=0.0;
+    };
+    //moment analysis of a cluster
+    struct ClusterMoment {
+	float  ecut=0.0;
+	bool   retry=false;                      //redone with ecut=0
+	double wtot=0.0, xx=0.0, yy=0.0, sx=0.0, sy=0.0, sxy=0.0;
+	double cost=1.0, sint=0.0;               //direction of the major axis
+	double wsig=0.0, smin=0.0, smax=0.0;     //sums for sigma min/max
+    };
+
     int makeCluster(int det);
 
-    float isNeighbor(StFcsHit* hit,  StFcsCluster* clu);   //! checks if a hit is touching a cluster
-    float distance(StFcsHit* hit1, StFcsHit* hit2);        //! distance between 2 hits [cell unit]
-    float distance(StFcsHit* hit, StFcsCluster* clu);      //! distance between a hit to cluster center [cell unit]
-    void  updateCluster(StFcsCluster* clu);                //! update cluster infos after hits added 
-    int   clusterMomentAnalysis(StFcsCluster* clu, float ecut);      //! cluster moment analysis with a threshold
-    float getSigma(StFcsCluster* clu, double thetam, float ecut);    //! calculate sigma 
-    void  categorization(StFcsCluster* clu);                         //! categorize cluster based on moment analysis
+    int   findNeighbors(int i, int col, int row, float thr, int range); //! finds clusters touching hit i, into mNeighborIds
+    float distance(int i, StFcsCluster* clu);                          //! distance between hit i to cluster center [cell unit]
+    void  addHit(StFcsCluster* clu, int j, StFcsHit* hit, int i, int col, int row); //! add hit i to cluster j and update cluster infos
+    void  clusterMomentAnalysis(int det, int nhit);                    //! cluster moment analysis for all clusters
+    void  accumulateMoments(int nhit, bool retryOnly);                 //! sum moments over clustered hits
+    void  categorization(StFcsCluster* clu);                           //! categorize cluster based on moment analysis
 	
     StFcsDb* mDb=0;                       //! pointer to StFcsDb
     StFcsCollection* mFcsCollection=0;    //! pointer to StFcsCollection in StEvent
@@ -117,6 +130,21 @@ public:
 
     int mSortById=0;  //! set this for cosmic tracking (default is sort by energy)
 
+    //per event work space, kept to reuse the storage. Hits are referred to by their index in the sorted hits.
+    int mNColumn=0;                       //! grid size of the current detector
+    int mNRow=0;                          //!
+    std::vector<int>   mGrid;             //! [(row-1)*mNColumn+col-1] clustered hit in the cell, -1 if none
+    std::vector<int>   mOffGrid;          //! clustered hits not in mGrid (no valid column/row or cell already taken)
+    std::vector<float> mHitX;             //! local x in cell
+    std::vector<float> mHitY;             //! local y in cell
+    std::vector<float> mHitE;             //! energy
+    std::vector<int>   mHitCluster;       //! cluster index, -1 if not clustered
+    std::vector<ClusterSum>    mSums;     //! per cluster
+    std::vector<ClusterMoment> mMoments;  //! per cluster
+    std::vector<int>   mNeighborMark;     //! per cluster, last hit for which the cluster was found as neighbor
+    std::vector<int>   mNeighborHit;      //! per cluster, last added hit of the cluster touching that hit
+    std::vector<int>   mNeighborIds;      //! neighbor clusters of the current hit
+
     virtual const Char_t *GetCVS() const {static const Char_t cvs[]="Tag " __DATE__ " " __TIME__ ; return cvs;}
     ClassDef(StFcsClusterMaker, 1)
 };
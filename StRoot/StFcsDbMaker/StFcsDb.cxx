@@ -256,44 +256,51 @@ int StFcsDb::Init(){
   return kStOK;
 }
 
-void StFcsDb::setDbAccess(int v) {mDbAccess =  v;}
-void StFcsDb::setRun(int run) {mRun = run;}
-void StFcsDb::setRun19(int v) {mRun19=v;}
-void StFcsDb::setLeakyHcal(int v) {mLeakyHcal=v;}
+void StFcsDb::setDbAccess(int v) {mDbAccess =  v; mChannelTables=0;}
+void StFcsDb::setRun(int run) {mRun = run; mChannelTables=0;}
+void StFcsDb::setRun19(int v) {mRun19=v; mChannelTables=0;}
+void StFcsDb::setLeakyHcal(int v) {mLeakyHcal=v; mChannelTables=0;}
 
 void StFcsDb::setFcsDetectorPosition(fcsDetectorPosition_st* t){
   if(!t) { memset(&mFcsDetectorPosition,0,sizeof(fcsDetectorPosition_st)); }
   else   { memcpy(&mFcsDetectorPosition,t,sizeof(fcsDetectorPosition_st)); }
+  mChannelTables=0;
 }
 
 void StFcsDb::setFcsEcalGain(fcsEcalGain_st* t){
   if(!t) { memset(&mFcsEcalGain,0,sizeof(fcsEcalGain_st)); }
   else   { memcpy(&mFcsEcalGain,t,sizeof(fcsEcalGain_st)); }
+  mChannelTables=0;
 }
 
 void StFcsDb::setFcsHcalGain(fcsHcalGain_st* t){
   if(!t) { memset(&mFcsHcalGain,0,sizeof(fcsHcalGain_st)); }
   else   { memcpy(&mFcsHcalGain,t,sizeof(fcsHcalGain_st)); }
+  mChannelTables=0;
 }
 
 void StFcsDb::setFcsPresGain(fcsPresGain_st* t){
   if(!t) { memset(&mFcsPresGain,0,sizeof(fcsPresGain_st)); }
   else   { memcpy(&mFcsPresGain,t,sizeof(fcsPresGain_st)); }
+  mChannelTables=0;
 }
 
 void StFcsDb::setFcsEcalGainCorr(fcsEcalGainCorr_st* t){
   if(!t) { memset(&mFcsEcalGainCorr,0,sizeof(fcsEcalGainCorr_st)); }
   else   { memcpy(&mFcsEcalGainCorr,t,sizeof(fcsEcalGainCorr_st)); }
+  mChannelTables=0;
 }
 
 void StFcsDb::setFcsHcalGainCorr(fcsHcalGainCorr_st* t){
   if(!t) { memset(&mFcsHcalGainCorr,0,sizeof(fcsHcalGainCorr_st)); }
   else   { memcpy(&mFcsHcalGainCorr,t,sizeof(fcsHcalGainCorr_st)); }
+  mChannelTables=0;
 }
 
 void StFcsDb::setFcsPresValley(fcsPresValley_st* t){
   if(!t) { memset(&mFcsPresValley,0,sizeof(fcsPresValley_st)); }
   else   { memcpy(&mFcsPresValley,t,sizeof(fcsPresValley_st)); }
+  mChannelTables=0;
 }
 
 int StFcsDb::InitRun(int runNumber) {
@@ -366,10 +373,38 @@ int StFcsDb::InitRun(int runNumber) {
 	mThetaY = TMath::ATan( mVdydz );
       }
     }
+    mCosThetaX = cos(-mThetaX);
+    mSinThetaX = sin(-mThetaX);
+    mCosThetaY = cos(mThetaY);
+    mSinThetaY = sin(mThetaY);
 
+    makeChannelTables();
     return kStOK;
 }
 
+//! Fill per detector and per channel tables from the same functions used without them
+void StFcsDb::makeChannelTables(){
+    mChannelTables=0;
+    for(int det=0; det<kFcsNDet; det++){
+	StThreeVectorD off = getDetectorOffset(det);
+	double a = getDetectorAngle(det) / 180.0 * M_PI;
+	mDetXOff[det]    = off.x();
+	mDetYCenter[det] = off.y() + (double(nRow(det)) / 2.0 * getYWidth(det));
+	mDetZOff[det]    = off.z();
+	mDetCos[det]     = cos(a);
+	mDetSin[det]     = sin(a);
+	int max = maxId(det);
+	if(max>kFcsMaxId) max=kFcsMaxId;
+	for(int id=0; id<max; id++){
+	    getLocalXYinCell(det,id,mCellX[det][id],mCellY[det][id]);
+	    mCellXYZ[det][id] = getStarXYZ(det,id);
+	    mChGain[det][id]     = getGain(det,id);
+	    mChGainCorr[det][id] = getGainCorrection(det,id);
+	}
+    }
+    mChannelTables=1;
+}
+
 int StFcsDb::maxDetectorId() const {return kFcsNDet;}
 
 int StFcsDb::detectorId(int eh, int ns) const { 
@@ -603,9 +638,18 @@ void StFcsDb::getLocalXYinCell(StFcsHit* hit, float &x, float &y) const{
 }
 
 void StFcsDb::getLocalXYinCell(int det, int id, float &x, float &y) const{
+    if(mChannelTables && det>=0 && det<kFcsNDet && id>=0 && id<maxId(det)){
+	x=mCellX[det][id];
+	y=mCellY[det][id];
+	return;
+    }
     getLocalXYinCell(det,getColumnNumber(det,id),getRowNumber(det,id),x,y);
 }
 
+void StFcsDb::getLocalXYinCell(int n, StFcsHit* const* hits, float* x, float* y) const{
+    for(int i=0; i<n; i++) getLocalXYinCell(hits[i]->detectorId(),hits[i]->id(),x[i],y[i]);
+}
+
 void StFcsDb::getLocalXYinCell(int det, int col, int row, float &x, float &y) const{    
     if(mLeakyHcal==1 && (det==kFcsHcalNorthDetId || det==kFcsHcalSouthDetId)){
 	if(col==1){
@@ -710,9 +754,15 @@ StThreeVectorD StFcsDb::getStarXYZ(const StFcsCluster* clu, float FcsZ) const{
 
 //! get coordinates of center of the cell in STAR frame from det/id
 StThreeVectorD StFcsDb::getStarXYZ(int det, int id, float FcsZ) const{ 
+    if(FcsZ<0.0 && mChannelTables && mDebug<=1 && det>=0 && det<kFcsNDet && id>=0 && id<maxId(det)) return mCellXYZ[det][id];
     return getStarXYZ(det,getColumnNumber(det,id),getRowNumber(det,id),FcsZ);   
 }
 
+//! get coordinates of center of the cells at shower max in STAR frame for n hits
+void StFcsDb::getStarXYZ(int n, StFcsHit* const* hits, StThreeVectorD* xyz) const{ 
+    for(int i=0; i<n; i++) xyz[i]=getStarXYZ(hits[i]->detectorId(),hits[i]->id());
+}
+
 //! get coordinates of center of the cell STAR frame from det/row/column
 StThreeVectorD StFcsDb::getStarXYZ(int det, int col, int row, float FcsZ) const{ 
     float x,y;
@@ -729,6 +779,20 @@ StThreeVectorD StFcsDb::getStarXYZfromColumnRow(int det, float col, float row, f
 StThreeVectorD StFcsDb::getStarXYZ(int det, float FcsX, float FcsY, float FcsZ, float zVertex) const{ 
     if(FcsZ<0.0) FcsZ = getShowerMaxZ(det);
     double x = 0.0, y=0.0, z=0.0;
+    if(mChannelTables && det>=0 && det<kFcsNDet && mDebug<=1){
+	const double c = mDetCos[det];
+	const double s = mDetSin[det];
+	y = mDetYCenter[det] - FcsY;
+	if(northSouth(det) == 0) {//! north side
+	    x = mDetXOff[det] - FcsX * c - FcsZ * s;
+	    z = mDetZOff[det] + FcsZ * c - FcsX * s;
+	}else{ // south side
+	    x = mDetXOff[det] + FcsX * c + FcsZ * s;
+	    z = mDetZOff[det] + FcsZ * c - FcsX * s;
+	}
+	z -= zVertex;
+	return StThreeVectorD(x,y,z);
+    }
     StThreeVectorD off = getDetectorOffset(det);
     double a = getDetectorAngle(det) / 180.0 * M_PI;
     y = off.y() + (double(nRow(det)) / 2.0 * getYWidth(det)) - FcsY;
@@ -756,9 +820,15 @@ float StFcsDb::getEta(int det,float FcsX, float FcsY, float FcsZ, float zVertex)
 StLorentzVectorD StFcsDb::getLorentzVector(const StThreeVectorD& xyz, float energy, float zVertex){
     // Calculate a 4 momentum from a direction/momentum vector and energy assuming zero mass i.e. E=p
     // Taking into account beamline offsets and angles from DB
-    StThreeVectorD xyznew(xyz.x()-mVx,xyz.y()-mVy,xyz.z()-zVertex);
-    xyznew.rotateX(+mThetaY);
-    xyznew.rotateY(-mThetaX);
+    //rotateX(+mThetaY) then rotateY(-mThetaX), with cos/sin from InitRun
+    double x0 = xyz.x()-mVx;
+    double y0 = xyz.y()-mVy;
+    double z0 = xyz.z()-zVertex;
+    double y1 = mCosThetaY*y0 - mSinThetaY*z0;
+    double z1 = mSinThetaY*y0 + mCosThetaY*z0;
+    double z2 = mCosThetaX*z1 - mSinThetaX*x0;
+    double x2 = mSinThetaX*z1 + mCosThetaX*x0;
+    StThreeVectorD xyznew(x2,y1,z2);
     double e=energy;
     StThreeVectorD mom3 = xyznew.unit() * e;
     if(mDebug>1){
@@ -788,6 +858,7 @@ float StFcsDb::getGain(StFcsHit* hit) const  {
 
 float StFcsDb::getGain(int det, int id) const  {
   if(det>=0 && det<kFcsNDet && id>=0 && id<maxId(det)) {
+    if(mChannelTables) return mChGain[det][id];
     switch(mGainMode){
     case GAINMODE::FIXED :
       if(det<=kFcsHcalSouthDetId) return 0.0053; //default 5.3MeV/ch
@@ -812,6 +883,7 @@ float StFcsDb::getGainCorrection(StFcsHit* hit) const  {
 
 float StFcsDb::getGainCorrection(int det, int id) const  {
   if(det>=0 && det<kFcsNDet && id>=0 && id<maxId(det)) {
+    if(mChannelTables) return mChGainCorr[det][id];
     switch(mGainCorrMode){
     case GAINMODE::FIXED :
       if(det<=kFcsHcalSouthDetId) return 1.0;   // default 1.0
@@ -830,6 +902,13 @@ float StFcsDb::getGainCorrection(int det, int id) const  {
   return 1.0;
 }
 
+void StFcsDb::getGain(int n, StFcsHit* const* hits, float* gain, float* gaincorr) const  {
+  for(int i=0; i<n; i++){
+    gain[i]     = getGain(hits[i]->detectorId(), hits[i]->id());
+    gaincorr[i] = getGainCorrection(hits[i]->detectorId(), hits[i]->id());
+  }
+}
+
 float StFcsDb::getPresValley(StFcsHit* hit) const  {
     return getGainCorrection(hit->detectorId(), hit->id());
 }
@@ -169,6 +169,7 @@ public:
   void getLocalXYinCell(StFcsHit* hit, float &x, float &y) const; 
   void getLocalXYinCell(int det, int id, float &x, float &y) const;
   void getLocalXYinCell(int det, int col, int row, float &x, float &y) const;
+  void getLocalXYinCell(int n, StFcsHit* const* hits, float* x, float* y) const; //! for n hits, x/y[i] for hits[i]
 
   //! get the STAR frame cooridnates from local XYZ [cm]
   StThreeVectorD getStarXYZ(int det,float FcsX, float FcsY, float FcsZ=-1.0, float zVertex=0.0) const;
@@ -183,6 +184,7 @@ public:
   StThreeVectorD getStarXYZ(const StFcsHit* hit, float FcsZ=-1.0) const;         //from StFcsHit
   StThreeVectorD getStarXYZ(const StFcsCluster* clu, float FcsZ=-1.0) const;     //from StFcsCluster
   StThreeVectorD getStarXYZ(int det, int id, float FcsZ=-1.0) const;             //center of the cell
+  void getStarXYZ(int n, StFcsHit* const* hits, StThreeVectorD* xyz) const;      //center of the cells at shower max for n hits
   
   //! Get the STAR frame cooridnates for 4x4 sum
   StThreeVectorD getStarXYZ_4x4(int det,int col, int row) const; 
@@ -206,28 +208,31 @@ public:
   float getGain8(StFcsHit* hit) const;                 //! get the gain for the channel for 8 timebin sum
   float getGainCorrection(int det, int id) const;  //! get the gain correction for the channel    
   float getGainCorrection(StFcsHit* hit) const;        //! get the gain correction for the channel    
+  void  getGain(int n, StFcsHit* const* hits, float* gain, float* gaincorr) const; //! gain and gain correction for n hits
   float getPresValley(int det, int id) const;      //! get the pres valley position for cut
   float getPresValley(StFcsHit* hit) const;            //! get the pres valley position for cut
 
   enum GAINMODE { FIXED, DB, FORCED, TXT }; //! Gain mode switch
-  void forceFixGain()                      {mGainMode=GAINMODE::FIXED;}       //! fixed default gain
-  void forceFixGainCorrection()            {mGainCorrMode=GAINMODE::FIXED;}   //! fixed default gaincorr
+  void forceFixGain()                      {mGainMode=GAINMODE::FIXED;     mChannelTables=0;} //! fixed default gain
+  void forceFixGainCorrection()            {mGainCorrMode=GAINMODE::FIXED; mChannelTables=0;} //! fixed default gaincorr
   void forceUniformGain(float ecal, float hcal=0.0053, float pres=0.01){
     mGainMode=GAINMODE::FORCED;   //! force a specified value               
+    mChannelTables=0;
     mForceUniformGainEcal=ecal; 
     mForceUniformGainHcal=hcal; 
     mForceUniformGainPres=pres; 
   }  
   void forceUniformGainCorrection(float ecal, float hcal=1.0, float pres=0.5){
     mGainCorrMode=GAINMODE::FORCED; //! force a specified value
+    mChannelTables=0;
     mForceUniformGainCorrectionEcal=ecal;
     mForceUniformGainCorrectionHcal=hcal;
     mForceUniformGainCorrectionPres=pres;
   } 
 
   //! reading gain from text files
-  void setReadGainFromText(const char* file="fcsgain.txt")         {strcpy(mGainFilename,file);     mGainMode=GAINMODE::TXT;}
-  void setReadGainCorrFromText(const char* file="fcsgaincorr.txt") {strcpy(mGainCorrFilename,file); mGainCorrMode=GAINMODE::TXT;}
+  void setReadGainFromText(const char* file="fcsgain.txt")         {strcpy(mGainFilename,file);     mGainMode=GAINMODE::TXT;     mChannelTables=0;}
+  void setReadGainCorrFromText(const char* file="fcsgaincorr.txt") {strcpy(mGainCorrFilename,file); mGainCorrMode=GAINMODE::TXT; mChannelTables=0;}
 
   //ETGain factor= 1(ET Match), 0(E Match), 0.5(halfway)
   float getEtGain(int det, int id, float factor=1.0) const;  //! ET gain
@@ -308,6 +313,26 @@ public:
   double mVdydz=0.0;   //! beamline y slope
   double mThetaX=0.0;  //! beamline x theta
   double mThetaY=0.0;  //! beamline y theta
+  double mCosThetaX=1.0;  //! cos(-mThetaX)
+  double mSinThetaX=0.0;  //! sin(-mThetaX)
+  double mCosThetaY=1.0;  //! cos(mThetaY)
+  double mSinThetaY=0.0;  //! sin(mThetaY)
+
+  //Per detector and per channel tables made at InitRun, so that the accessors do not redo the DEP map lookup,
+  //detector offset/angle and rotation for every hit/cluster/point. Accessors fall back to the full
+  //calculation when mChannelTables=0 (before InitRun, or a setting changed after it).
+  int    mChannelTables=0;                       //! tables below are up to date
+  double mDetXOff[kFcsNDet];                     //! getDetectorOffset().x()
+  double mDetYCenter[kFcsNDet];                  //! getDetectorOffset().y() + nRow/2 * getYWidth()
+  double mDetZOff[kFcsNDet];                     //! getDetectorOffset().z()
+  double mDetCos[kFcsNDet];                      //! cos of getDetectorAngle()
+  double mDetSin[kFcsNDet];                      //! sin of getDetectorAngle()
+  float  mCellX[kFcsNDet][kFcsMaxId];            //! getLocalXYinCell()
+  float  mCellY[kFcsNDet][kFcsMaxId];            //! getLocalXYinCell()
+  StThreeVectorD mCellXYZ[kFcsNDet][kFcsMaxId];  //! getStarXYZ() of the cell center at shower max
+  float  mChGain[kFcsNDet][kFcsMaxId];           //! getGain()
+  float  mChGainCorr[kFcsNDet][kFcsMaxId];       //! getGainCorrection()
+  void makeChannelTables();
 
   //copy of tables from DB
   fcsDetectorPosition_st  mFcsDetectorPosition; 
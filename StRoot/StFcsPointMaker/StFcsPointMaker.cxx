@@ -9,6 +9,7 @@
 #include "StEvent/StFcsCluster.h"
 #include "StEvent/StFcsPoint.h"
 #include "StFcsDbMaker/StFcsDb.h"
+#include "StarClassLibrary/StParallelFor.hh"
 
 #include "StMuDSTMaker/COMMON/StMuTypes.hh"
 #include "StMuDSTMaker/COMMON/StMuDst.h"
@@ -17,6 +18,7 @@
 
 #include <cmath>
 #include <limits>
+#include <algorithm>
 #include "TMath.h"
 #include "TVector2.h"
 
@@ -39,7 +41,9 @@ StFcsPointMaker::StFcsPointMaker(const char* name) : StMaker(name) , mMinuit(7)
     mMinuit.SetPrintLevel(-1);
 }
 
-StFcsPointMaker::~StFcsPointMaker() { }
+StFcsPointMaker::~StFcsPointMaker() {
+    for(int det=0; det<=kFcsEcalSouthDetId; det++) delete mShowerShapeFit[det];
+}
 
 void StFcsPointMaker::Clear(Option_t* option) {
     StMaker::Clear(option);
@@ -122,6 +126,12 @@ void StFcsPointMaker::setShowerShapeParameters(int det){
 	    mShowerShapeParameters[i*10+7]=(z0 + z)/(z0+smax);
 	}
     }
+    //tabulate for the Levenberg-Marquardt fits, only when changed
+    if(!mUseMinuit){
+	if(mShowerShapeFit[det]==0) mShowerShapeFit[det]=new StFcsShowerShapeFit();
+	if(mShowerShapeFit[det]->setParameters(mShowerShapeParameters.data()) && GetDebug()>0)
+	    LOG_INFO << Form("Tabulated shower shape for det=%1d",det) << endm;
+    }
     if(GetDebug()>0) {
 	for(int i=0; i<6; i++){
 	    LOG_INFO << Form("Shower Shape Parameters det=%1d slice=%1d : ",det,i);
@@ -142,8 +152,12 @@ int StFcsPointMaker::Make() {
 	return kStWarn;	
     }
     
-    for(int det=0; det<=kFcsEcalSouthDetId; det++) {
-      fitClusters(det);	
+    if(mUseMinuit){
+      for(int det=0; det<=kFcsEcalSouthDetId; det++) {
+        fitClusters(det);	
+      }
+    }else{
+      fitClustersLM();
     }
     if(GetDebug()>0) mFcsCollection->print(3);
     return kStOk;
@@ -167,17 +181,11 @@ void StFcsPointMaker::fitClusters(int det) {
     //mX=new float[mNHit];
     //mY=new float[mNHit];
     //mE=new float[mNHit];
-    mE.clear(); mX.clear(); mY.clear();
+    mE.resize(mNHit); mX.resize(mNHit); mY.resize(mNHit);
+    if(mNHit>0) mDb->getLocalXYinCell(mNHit, &c->hits()[0], &mX[0], &mY[0]);
     for(int j=0; j<mNHit; j++){
         StFcsHit* h=c->hits()[j];	
-        float x,y;
-        mDb->getLocalXYinCell(h, x, y);
-        mE.push_back(h->energy());
-        mX.push_back(x);
-        mY.push_back(y);
-        //mE[j]=h->energy();
-        //mX[j]=x;
-        //mY[j]=y;
+        mE[j]=h->energy();
     }
     double chi1=std::numeric_limits<double>::max();
     double chi2=std::numeric_limits<double>::max();
@@ -196,6 +204,12 @@ void StFcsPointMaker::fitClusters(int det) {
       chi1 = chi2 = 0;
       LOG_WARN << "Unknown cluster category=" << c->category() << endm;
     }	
+    addPoints(det,c,chi1,chi2,point0,point1,point2);
+  }
+  fillFourMomentum(det);
+}
+
+void StFcsPointMaker::addPoints(int det, StFcsCluster* c, double chi1, double chi2, StFcsPoint& point0, StFcsPoint& point1, StFcsPoint& point2){
     // sotre chi2 for both
     c->setChi2Ndf1Photon(chi1);
     c->setChi2Ndf2Photon(chi2);
@@ -231,8 +245,10 @@ void StFcsPointMaker::fitClusters(int det) {
 
 	c->addPoint(p1,p2);
     }
-  }
-  
+}
+
+void StFcsPointMaker::fillFourMomentum(int det){
+  StSPtrVecFcsPoint& points = mFcsCollection->points(det);
   //loop over all found points and fill fourMomentum
   int np = points.size();
   for(int i=0; i<np; i++){
@@ -343,6 +359,118 @@ double StFcsPointMaker::fit2PhotonCluster(StFcsCluster* c, StFcsPoint* p1, StFcs
     return chi2;
 }
 
+void StFcsPointMaker::fitClustersLM() {
+  //collect towers of all Ecal clusters on this thread
+  mNClusterFits=0;
+  for(int det=0; det<=kFcsEcalSouthDetId; det++) {
+    StSPtrVecFcsCluster&  clusters = mFcsCollection->clusters(det);
+    mFcsCollection->points(det).clear(); //clear all points
+    int nclu=clusters.size();
+    for(int i=0; i<nclu; i++) clusters[i]->points().clear(); //reset point pointer from cluster
+
+    setShowerShapeParameters(det);
+
+    for(int i=0; i<nclu; i++){
+      if((int)mClusterFits.size()<=mNClusterFits) mClusterFits.resize(mNClusterFits+1);
+      ClusterFit& f=mClusterFits[mNClusterFits++];
+      StFcsCluster* c=clusters[i];
+      f.cluster=c;
+      f.det=det;
+      int nhit=c->nTowers();
+      f.towers.resize(nhit);
+      mX.resize(nhit); mY.resize(nhit);
+      if(nhit>0) mDb->getLocalXYinCell(nhit, &c->hits()[0], &mX[0], &mY[0]);
+      for(int j=0; j<nhit; j++){
+	f.towers[j].x=mX[j];
+	f.towers[j].y=mY[j];
+	f.towers[j].e=c->hits()[j]->energy();
+      }
+      StFcsShowerShapeFit::setWeights(f.towers, c->energy());
+    }
+  }
+
+  //fit clusters, each fit only writes its own ClusterFit
+  StParallelFor(mNClusterFits, mNThreads>1 ? mNThreads : 1, [&](size_t i, size_t){ fitCluster(mClusterFits[i]); });
+
+  //make points on this thread in cluster order
+  StFcsPoint point0,point1,point2;
+  for(int i=0; i<mNClusterFits; i++){
+    ClusterFit& f=mClusterFits[i];
+    if(f.cluster->category()<0 || f.cluster->category()>2)
+      LOG_WARN << "Unknown cluster category=" << f.cluster->category() << endm;
+    StFcsPoint* p[3]={&point0,&point1,&point2};
+    for(int j=0; j<3; j++){
+      p[j]->setX(f.photon[j].x);
+      p[j]->setY(f.photon[j].y);
+      p[j]->setEnergy(f.photon[j].e);
+    }
+    addPoints(f.det,f.cluster,f.chi1,f.chi2,point0,point1,point2);
+  }
+  for(int det=0; det<=kFcsEcalSouthDetId; det++) fillFourMomentum(det);
+}
+
+void StFcsPointMaker::fitCluster(ClusterFit& f) const {
+  for(int j=0; j<3; j++) f.photon[j].x = f.photon[j].y = f.photon[j].e = 0;
+  f.chi1=std::numeric_limits<double>::max();
+  f.chi2=std::numeric_limits<double>::max();
+  switch(f.cluster->category()){
+  case 0:
+    f.chi1 = fit1PhotonClusterLM(f);
+    f.chi2 = fit2PhotonClusterLM(f);
+    break;
+  case 1:
+    f.chi1 = fit1PhotonClusterLM(f);
+    break;
+  case 2:
+    f.chi2 = fit2PhotonClusterLM(f);
+    break;
+  default:
+    f.chi1 = f.chi2 = 0;
+  }
+}
+
+// same start values and limits as fit1PhotonCluster()
+double StFcsPointMaker::fit1PhotonClusterLM(ClusterFit& f) const {
+    StFcsCluster* c=f.cluster;
+    double x=c->x();
+    double y=c->y();
+    double e=c->energy();
+    double dx=m_PH1_Delta_X;  //0.5
+    double de=m_PH1_Delta_E;  //1.15
+    double par[3] ={x,    y,    e   };
+    double low[3] ={x-dx, y-dx, e/de};
+    double high[3]={x+dx, y+dx, e*de};
+    int fixed[3]  ={0,    0,    m_PH1_FixEnergy==1};
+    double chi2 = mShowerShapeFit[f.det]->fit(f.towers, 1, par, low, high, fixed);
+    StFcsShowerShapeFit::photons(1, par, &f.photon[0]);
+    return chi2;
+}
+
+// same start values and limits as fit2PhotonCluster()
+double StFcsPointMaker::fit2PhotonClusterLM(ClusterFit& f) const {
+    StFcsCluster* c=f.cluster;
+    double x=c->x();
+    double y=c->y();
+    double smax= c->sigmaMax();
+    double d=std::max(m_PH2_StartDggFactor*smax,0.5); //1.1 = 2.2/2.0
+    double t=c->theta();
+    double z=0.0;
+    double e=c->energy();
+    double dx=m_PH2_Delta_X;     //0.2
+    double ddl=d*m_PH2_Low_Dgg;  //0.8
+    double ddh=d*m_PH2_High_Dgg; //3.0
+    double dt=m_PH2_MaxTheta_F;  //TMath::PiOver2()
+    double de=m_PH2_Delta_E;     //1.05
+    //                 x     y     dgg  theta                 zgg    etot
+    double par[6] ={x,    y,    d,   t,                    z,     e   };
+    double low[6] ={x-dx, y-dx, ddl, t-dt,                 -0.99, e/de};
+    double high[6]={x+dx, y+dx, ddh, t+dt,                 0.99,  e*de};
+    int fixed[6]  ={0,    0,    0,   m_PH2_FixTheta==1,    0,     m_PH2_FixEnergy==1};
+    double chi2 = mShowerShapeFit[f.det]->fit(f.towers, 2, par, low, high, fixed);
+    StFcsShowerShapeFit::photons(2, par, &f.photon[1]);
+    return chi2;
+}
+
 // Minimization function to be called from TMinuit
 void StFcsPointMaker::minimizationFunctionNPhoton(int& npara, double* grad, double& fval, double* para, int){
     fval = 0.0;
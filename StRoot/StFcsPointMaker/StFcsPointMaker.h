@@ -5,6 +5,7 @@
 
 #include "TMinuit.h"
 #include "StMaker.h"
+#include "StFcsShowerShapeFit.h"
 
 class StFcsCollection;
 class StFcsHit;
@@ -28,6 +29,8 @@ public:
     
     void setDebug(int v) {SetDebug(v);}
     void setMinuitPrintLevel(int v) {mMinuit.SetPrintLevel(v);}
+    void setUseMinuit(int v=1) {mUseMinuit=v;}  //1 (default) for TMinuit fits, 0 for the Levenberg-Marquardt fits on the shower shape table
+    void setNThreads(int v) {mNThreads=v;}      //threads for the Levenberg-Marquardt fits of all clusters
 
     void setShowerShape(int v) {mShowerShape=v;}
     void setShowerShapeScale(float v) {mShowerShapeScale=v;}
@@ -49,9 +52,24 @@ public:
 
  private:
     void setShowerShapeParameters(int det);
-    void fitClusters(int det);  // fitting for a detector
+    void fitClusters(int det);  // fitting for a detector with TMinuit
     double fit1PhotonCluster(StFcsCluster* c, StFcsPoint* p);  //fit with 1 photon
     double fit2PhotonCluster(StFcsCluster* c, StFcsPoint* p1, StFcsPoint* p2); //fit with 2 photon
+    void addPoints(int det, StFcsCluster* c, double chi1, double chi2, StFcsPoint& point0, StFcsPoint& point1, StFcsPoint& point2); //store better of 1 and 2 photon fits
+    void fillFourMomentum(int det);
+
+    //Levenberg-Marquardt fits of a cluster, only reading the cluster and the shower shape table
+    struct ClusterFit {
+	StFcsCluster* cluster;
+	int det;
+	std::vector<StFcsShowerShapeFit::Tower> towers;
+	double chi1, chi2;
+	StFcsShowerShapeFit::Photon photon[3]; //1 photon fit, then 2 photon fit
+    };
+    void fitClustersLM();  // fitting for all Ecal clusters, on mNThreads threads
+    void fitCluster(ClusterFit& f) const;
+    double fit1PhotonClusterLM(ClusterFit& f) const;
+    double fit2PhotonClusterLM(ClusterFit& f) const;
 
     //TMinuit minimization function. This has to be void(*)(int &, double *, double &f, double *, int) 	 
     static void minimizationFunctionNPhoton(int& npar, double* grad, double& fval, double* par, int flag); 
@@ -65,6 +83,12 @@ public:
     float mShowerShapeScale=1.0;     //! shower shape trasnverset scale
 
     TMinuit mMinuit;                   //! Minuit interface
+    int mUseMinuit=1;                  //! 1 for TMinuit fits, 0 for Levenberg-Marquardt fits
+
+    StFcsShowerShapeFit* mShowerShapeFit[2]={0,0}; //! tabulated shower shape for Ecal north/south
+    std::vector<ClusterFit> mClusterFits;          //! all Ecal clusters of the event, kept to reuse storage
+    int mNClusterFits=0;                           //! clusters in mClusterFits for this event
+    int mNThreads=1;                               //!
 
     //1 photon fit switch and parameters
     int    m_PH1_FixEnergy=1;
@@ -0,0 +1,285 @@
+// $Id$
+
+#include "StFcsShowerShapeFit.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+StFcsShowerShapeFit::StFcsShowerShapeFit(double range, double step) : mRange(range), mStep(step) {
+    mN = int(mRange/mStep+0.5)+1;
+    memset(mParameters,0,sizeof(mParameters));
+}
+
+bool StFcsShowerShapeFit::setParameters(const double* parameters){
+    if(mNSlice>0 && memcmp(mParameters,parameters,sizeof(mParameters))==0) return false;
+    memcpy(mParameters,parameters,sizeof(mParameters));
+    mNSlice=0;
+    for(int i=0; i<kNSlice; i++){
+	if(mParameters[i*kNSlicePar]>0.0) mSlice[mNSlice++]=i;
+    }
+    //components narrower than a few table steps are not smooth on the table grid,
+    //they are left out of the table and always integrated analytically
+    for(int s=0; s<mNSlice; s++){
+	mNarrow[s]=0;
+	for(int k=1; k<=3; k++){
+	    const double* p=&mParameters[mSlice[s]*kNSlicePar];
+	    if(p[k]!=0.0 && fabs(p[k+3])<4.0*mStep) mNarrow[s] |= 1<<k;
+	}
+    }
+    const int nnode=mN*mN*4;
+    mTable.assign(mNSlice*nnode,0.0);
+    for(int s=0; s<mNSlice; s++){
+	for(int ix=0; ix<mN; ix++){
+	    for(int iy=0; iy<mN; iy++){
+		double* t=&mTable[s*nnode + (ix*mN+iy)*4];
+		t[0]=cellIntegral(s, ix*mStep, iy*mStep, t[1], t[2], &t[3], ~mNarrow[s]);
+	    }
+	}
+    }
+    return true;
+}
+
+// shower shape integral over the cell at dx,dy from the photon and its derivatives
+//   F(x,y)    = sum a/2pi * atan(x*y/(b*r)),  r=sqrt(b^2+x^2+y^2)
+//   dF/dx     = sum a/2pi * b*y/((b^2+x^2)*r)
+//   dF/dy     = sum a/2pi * b*x/((b^2+y^2)*r)
+//   d2F/dxdy  = sum a/2pi * b/r^3
+// and the cell integral is F at the 4 corners. Only the components with bit k of mask set are included
+double StFcsShowerShapeFit::cellIntegral(int s, double dx, double dy, double& tx, double& ty, double* txy, int mask) const {
+    constexpr double ootwopi = 1.0/2.0/3.14159265358979323846;
+    const double* p=&mParameters[mSlice[s]*kNSlicePar];
+    double t=0;
+    tx=0; ty=0;
+    if(txy) *txy=0;
+    for(int cx=-1; cx<=1; cx+=2){
+	for(int cy=-1; cy<=1; cy+=2){
+	    const double sign = cx*cy;
+	    const double x = dx + 0.5*cx;
+	    const double y = dy + 0.5*cy;
+	    for(int k=1; k<=3; k++){
+		const double a=p[k];
+		if(a==0.0 || !(mask>>k & 1)) continue;
+		const double b=p[k+3];
+		const double r2=b*b+x*x+y*y;
+		const double r=sqrt(r2);
+		t  += sign * a * atan(x*y/(b*r));
+		tx += sign * a * b*y/((b*b+x*x)*r);
+		ty += sign * a * b*x/((b*b+y*y)*r);
+		if(txy) *txy += sign * a * b/(r2*r);
+	    }
+	}
+    }
+    tx*=ootwopi;
+    ty*=ootwopi;
+    if(txy) *txy*=ootwopi;
+    return t*ootwopi;
+}
+
+double StFcsShowerShapeFit::interpolate(int s, double ax, double ay, double& tx, double& ty) const {
+    const double fu=ax/mStep;
+    const double fv=ay/mStep;
+    const int i=int(fu);
+    const int j=int(fv);
+    const double u=fu-i, u2=u*u, u3=u2*u;
+    const double v=fv-j, v2=v*v, v3=v2*v;
+    //cubic Hermite basis for f(0), f(1), h*f'(0), h*f'(1) and their derivatives in x
+    const double hu[4]={2*u3-3*u2+1, -2*u3+3*u2, (u3-2*u2+u)*mStep, (u3-u2)*mStep};
+    const double du[4]={(6*u2-6*u)/mStep, (-6*u2+6*u)/mStep, 3*u2-4*u+1, 3*u2-2*u};
+    const double hv[4]={2*v3-3*v2+1, -2*v3+3*v2, (v3-2*v2+v)*mStep, (v3-v2)*mStep};
+    const double dv[4]={(6*v2-6*v)/mStep, (-6*v2+6*v)/mStep, 3*v2-4*v+1, 3*v2-2*v};
+    const double* table=&mTable[s*mN*mN*4];
+    double t=0;
+    tx=0; ty=0;
+    for(int a=0; a<2; a++){
+	for(int b=0; b<2; b++){
+	    const double* n=&table[((i+a)*mN+j+b)*4];
+	    t  += n[0]*hu[a]*hv[b] + n[1]*hu[2+a]*hv[b] + n[2]*hu[a]*hv[2+b] + n[3]*hu[2+a]*hv[2+b];
+	    tx += n[0]*du[a]*hv[b] + n[1]*du[2+a]*hv[b] + n[2]*du[a]*hv[2+b] + n[3]*du[2+a]*hv[2+b];
+	    ty += n[0]*hu[a]*dv[b] + n[1]*hu[2+a]*dv[b] + n[2]*hu[a]*dv[2+b] + n[3]*hu[2+a]*dv[2+b];
+	}
+    }
+    return t;
+}
+
+// same as StFcsPointMaker::energyDepositionInTower()
+double StFcsShowerShapeFit::energyDeposition(double x, double y, double xun, double yun, double* dxun, double* dyun) const {
+    double sum=0, sumx=0, sumy=0;
+    const double edge=(mN-1)*mStep; //last table node
+    for(int s=0; s<mNSlice; s++){
+	const double scale=mParameters[mSlice[s]*kNSlicePar+7];
+	const double dx=x-xun*scale;
+	const double dy=y-yun*scale;
+	const double ax=fabs(dx);
+	const double ay=fabs(dy);
+	double t, tx, ty;
+	if(ax<edge && ay<edge){
+	    t=interpolate(s, ax, ay, tx, ty);
+	    if(dx<0) tx=-tx;  //integral is even in dx and dy
+	    if(dy<0) ty=-ty;
+	    if(mNarrow[s]){
+		double nx, ny;
+		t  += cellIntegral(s, dx, dy, nx, ny, 0, mNarrow[s]);
+		tx += nx;
+		ty += ny;
+	    }
+	}else{
+	    t=cellIntegral(s, dx, dy, tx, ty);
+	}
+	sum  += t;
+	sumx -= tx*scale;
+	sumy -= ty*scale;
+    }
+    if(dxun) *dxun=sumx;
+    if(dyun) *dyun=sumy;
+    return sum;
+}
+
+void StFcsShowerShapeFit::setWeights(std::vector<Tower>& towers, double etot){
+    for(auto& t : towers){
+	const double ratio = t.e / etot;
+	const double err = 0.01 + 0.03 * pow(ratio, 1.0-0.001*etot) * pow(1.0-ratio, 1.0-0.007*etot)*etot;
+	t.w = 1.0/err;
+    }
+}
+
+void StFcsShowerShapeFit::photons(int nphoton, const double* par, Photon* ph){
+    double d[6][6];
+    photonDerivatives(nphoton, par, ph, d);
+}
+
+// photon x,y,e (rows) and their derivatives with respect to the fit parameters (columns)
+void StFcsShowerShapeFit::photonDerivatives(int nphoton, const double* par, Photon* ph, double d[6][6]){
+    memset(d,0,sizeof(double)*36);
+    if(nphoton==1){
+	ph[0].x=par[0];
+	ph[0].y=par[1];
+	ph[0].e=par[2];
+	d[0][0]=d[1][1]=d[2][2]=1.0;
+	return;
+    }
+    //same as StFcsPointMaker::minimizationFunction2Photon()
+    const double x=par[0], y=par[1], dgg=par[2], t=par[3], z=par[4], e=par[5];
+    const double c=cos(t), s=sin(t);
+    const double f1=(1.0-z)/2.0, f2=(1.0+z)/2.0;
+    ph[0].x = x + c*dgg*f1;   ph[0].y = y + s*dgg*f1;   ph[0].e = e*f2;
+    ph[1].x = x - c*dgg*f2;   ph[1].y = y - s*dgg*f2;   ph[1].e = e*f1;
+    // d/dx                  d/dy           d/ddgg         d/dtheta          d/dzgg          d/detot
+    d[0][0]=1;                             d[0][2]= c*f1; d[0][3]=-s*dgg*f1; d[0][4]=-c*dgg/2;
+    d[1][1]=1;                             d[1][2]= s*f1; d[1][3]= c*dgg*f1; d[1][4]=-s*dgg/2;
+                                                                             d[2][4]= e/2;    d[2][5]=f2;
+    d[3][0]=1;                             d[3][2]=-c*f2; d[3][3]= s*dgg*f2; d[3][4]=-c*dgg/2;
+    d[4][1]=1;                             d[4][2]=-s*f2; d[4][3]=-c*dgg*f2; d[4][4]=-s*dgg/2;
+                                                                             d[5][4]=-e/2;    d[5][5]=f1;
+}
+
+// minimized function and, if grad is given, the normal equations:
+// grad[0..npar*npar-1] = sum w*g*g^T, grad[npar*npar..] = sum w*(E-expected)*g with g=d(expected)/d(par)
+double StFcsShowerShapeFit::model(const std::vector<Tower>& towers, int nphoton, const double* par, std::vector<double>* grad) const {
+    const int npar = nphoton==1 ? 3 : 6;
+    Photon ph[2];
+    double d[6][6];
+    photonDerivatives(nphoton, par, ph, d);
+    if(grad) grad->assign(npar*npar+npar,0.0);
+    double fval=0;
+    for(const auto& tower : towers){
+	double expected=0;
+	double g[6]={0,0,0,0,0,0};
+	for(int j=0; j<nphoton; j++){
+	    double kx, ky;
+	    const double k = energyDeposition(tower.x, tower.y, ph[j].x, ph[j].y, &kx, &ky);
+	    expected += ph[j].e * k;
+	    if(grad){
+		const double dmx=ph[j].e*kx, dmy=ph[j].e*ky, dme=k;
+		for(int p=0; p<npar; p++) g[p] += dmx*d[3*j][p] + dmy*d[3*j+1][p] + dme*d[3*j+2][p];
+	    }
+	}
+	const double deviation = tower.e - expected;
+	fval += deviation * deviation * tower.w;
+	if(grad){
+	    double* a=&(*grad)[0];
+	    double* b=&(*grad)[npar*npar];
+	    for(int p=0; p<npar; p++){
+		b[p] += tower.w * deviation * g[p];
+		for(int q=0; q<=p; q++) a[p*npar+q] += tower.w * g[p] * g[q];
+	    }
+	}
+    }
+    return std::max(fval,0.0);
+}
+
+double StFcsShowerShapeFit::fit(const std::vector<Tower>& towers, int nphoton, double* par,
+				const double* low, const double* high, const int* fixed) const {
+    const int npar = nphoton==1 ? 3 : 6;
+    int free[6];
+    int nfree=0;
+    for(int p=0; p<npar; p++){
+	par[p]=std::min(std::max(par[p],low[p]),high[p]);
+	if(!fixed[p]) free[nfree++]=p;
+    }
+    std::vector<double> grad;
+    double fval=model(towers, nphoton, par, 0);
+    if(nfree==0 || mNSlice==0) return fval;
+
+    double lambda=1.0e-3;
+    double a[36], b[6], trial[6];
+    for(int iter=0; iter<mMaxIteration; iter++){
+	model(towers, nphoton, par, &grad);
+	//damped normal equations for the free parameters
+	for(int p=0; p<nfree; p++){
+	    for(int q=0; q<=p; q++){
+		const int pp=free[p], qq=free[q];
+		a[p*nfree+q] = a[q*nfree+p] = grad[pp*npar+qq];
+	    }
+	    a[p*nfree+p] = a[p*nfree+p]*(1.0+lambda) + 1.0e-12;
+	    b[p] = grad[npar*npar+free[p]];
+	}
+	//Cholesky
+	bool ok=true;
+	for(int j=0; j<nfree && ok; j++){
+	    double s=a[j*nfree+j];
+	    for(int k=0; k<j; k++) s -= a[j*nfree+k]*a[j*nfree+k];
+	    if(s<=0){ ok=false; break; }
+	    s=sqrt(s);
+	    a[j*nfree+j]=s;
+	    for(int i=j+1; i<nfree; i++){
+		double t=a[i*nfree+j];
+		for(int k=0; k<j; k++) t -= a[i*nfree+k]*a[j*nfree+k];
+		a[i*nfree+j]=t/s;
+	    }
+	}
+	if(!ok){
+	    lambda*=10;
+	    if(lambda>1.0e8) break;
+	    continue;
+	}
+	for(int i=0; i<nfree; i++){
+	    double t=b[i];
+	    for(int k=0; k<i; k++) t -= a[i*nfree+k]*b[k];
+	    b[i]=t/a[i*nfree+i];
+	}
+	for(int i=nfree-1; i>=0; i--){
+	    double t=b[i];
+	    for(int k=i+1; k<nfree; k++) t -= a[k*nfree+i]*b[k];
+	    b[i]=t/a[i*nfree+i];
+	}
+	//step within the limits
+	for(int p=0; p<npar; p++) trial[p]=par[p];
+	for(int p=0; p<nfree; p++){
+	    const int pp=free[p];
+	    trial[pp]=std::min(std::max(par[pp]+b[p],low[pp]),high[pp]);
+	}
+	const double ftrial=model(towers, nphoton, trial, 0);
+	if(ftrial<=fval){
+	    const bool converged = fval-ftrial < 1.0e-6*fval + 1.0e-9;
+	    for(int p=0; p<npar; p++) par[p]=trial[p];
+	    fval=ftrial;
+	    lambda=std::max(lambda/10,1.0e-7);
+	    if(converged) break;
+	}else{
+	    lambda*=10;
+	    if(lambda>1.0e8) break;
+	}
+    }
+    return fval;
+}
@@ -0,0 +1,77 @@
+// $Id$
+//
+// Tabulated FCS shower shape and Levenberg-Marquardt photon fit used by StFcsPointMaker
+//
+// The energy deposited in a cell by a photon is the sum over up to 6 z slices of the
+// shower shape integral over the cell (energyDepositionInTowerSingleLayer() in
+// StFcsPointMaker.h), evaluated at the photon position scaled to the slice z. The
+// integral of each slice only depends on (dx, dy) = cell center - photon position, is
+// even in dx and dy, and its derivatives d/dx, d/dy and d2/dxdy are analytic. It is
+// tabulated with all of them on a quarter grid and interpolated with bicubic Hermite
+// polynomials, which also gives the gradient with respect to the photon position.
+// Beyond the table range the analytic integral is used.
+//
+// fit() minimizes the same function as StFcsPointMaker::minimizationFunctionNPhoton()
+// with the same parameters and limits as the TMinuit fits, so it is const and can be
+// called for several clusters at the same time.
+
+#ifndef STROOT_STFCSPOINTMAKER_STFCSSHOWERSHAPEFIT_H_
+#define STROOT_STFCSPOINTMAKER_STFCSSHOWERSHAPEFIT_H_
+
+#include <vector>
+
+class StFcsShowerShapeFit {
+public:
+    static const int kNSlice=6;        // z slices
+    static const int kNSlicePar=10;    // parameters per slice, see StFcsPointMaker::setShowerShapeParameters()
+
+    struct Tower {
+	double x, y;  // cell center in cell coordinate
+	double e;     // measured energy
+	double w;     // 1/error, error as in StFcsPointMaker::minimizationFunctionNPhoton()
+    };
+    struct Photon {
+	double x, y, e;
+    };
+
+    StFcsShowerShapeFit(double range=6.0, double step=0.05);
+
+    // Sets shower shape parameters (kNSlice*kNSlicePar) and tabulates them, returns false if unchanged
+    bool setParameters(const double* parameters);
+
+    // Energy deposition in the cell at x,y from a photon of unit energy at xun,yun (at shower max)
+    // and, if given, its derivatives with respect to xun and yun
+    double energyDeposition(double x, double y, double xun, double yun, double* dxun=0, double* dyun=0) const;
+
+    // 1/error of the tower energies for a cluster of energy etot
+    static void setWeights(std::vector<Tower>& towers, double etot);
+
+    // Fit nphoton=1 (par = x, y, e) or nphoton=2 (par = x, y, dgg, theta, zgg, etot)
+    // par is the starting point on input and the result on output, within [low,high],
+    // parameters with fixed[i]!=0 are not fitted. Returns the minimized function.
+    double fit(const std::vector<Tower>& towers, int nphoton, double* par,
+	       const double* low, const double* high, const int* fixed) const;
+
+    // Photons from the fit parameters
+    static void photons(int nphoton, const double* par, Photon* ph);
+
+    void setMaxIteration(int v) {mMaxIteration=v;}
+
+private:
+    double cellIntegral(int s, double dx, double dy, double& tx, double& ty, double* txy=0, int mask=~0) const; // analytic
+    double interpolate(int slice, double ax, double ay, double& tx, double& ty) const;                 // table, ax,ay>=0
+    double model(const std::vector<Tower>& towers, int nphoton, const double* par, std::vector<double>* grad) const;
+    static void photonDerivatives(int nphoton, const double* par, Photon* ph, double d[6][6]);
+
+    double mParameters[kNSlice*kNSlicePar];
+    int mNSlice=0;             // active slices
+    int mSlice[kNSlice];       // index of the active slices
+    int mNarrow[kNSlice];      // bit k set if shower shape component k of the active slice is not tabulated
+    double mRange;             // table covers 0<=|dx|,|dy|<mRange [cell]
+    double mStep;              // table step [cell]
+    int mN;                    // nodes per axis
+    std::vector<double> mTable; // [slice][ix][iy][f, df/dx, df/dy, d2f/dxdy]
+    int mMaxIteration=50;
+};
+
+#endif  // STROOT_STFCSPOINTMAKER_STFCSSHOWERSHAPEFIT_H_
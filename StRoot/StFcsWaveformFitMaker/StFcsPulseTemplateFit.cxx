@@ -0,0 +1,267 @@
+#include "StFcsPulseTemplateFit.h"
+
+#include <cmath>
+
+#include "StFcsDbMaker/StFcsDbPulse.h"
+
+StFcsPulseTemplateFit::StFcsPulseTemplateFit(){}
+
+StFcsPulseTemplateFit::~StFcsPulseTemplateFit(){}
+
+void StFcsPulseTemplateFit::setPulse(StFcsDbPulse* pulse, double step)
+{
+  mShape.clear();
+  mSlope.clear();
+  if( pulse==0 || step<=0 ){ return; }
+  mSigma = pulse->GSigma();
+  mStep = step;
+  mLow = -8.0*mSigma;
+  double p[3] = {1.0, 0.0, mSigma};
+  //Table ends once the tail has died out (or at 300 timebins for a very long tail)
+  double high = 8.0*mSigma;
+  while( high<300.0 ){
+    double x[1] = {high};
+    if( fabs(pulse->pulseShape(x,p))<1.0e-6 ){ break; }
+    high += 1.0;
+  }
+  int n = int((high-mLow)/mStep)+2;
+  mShape.resize(n);
+  mSlope.resize(n);
+  const double h = 1.0e-3;
+  for( int i=0; i<n; ++i ){
+    double x0[1] = {mLow+i*mStep};
+    double xl[1] = {x0[0]-h};
+    double xh[1] = {x0[0]+h};
+    mShape[i] = pulse->pulseShape(x0,p);
+    mSlope[i] = (pulse->pulseShape(xh,p)-pulse->pulseShape(xl,p))/(2.0*h);
+  }
+}
+
+double StFcsPulseTemplateFit::shape(double dt) const
+{
+  double u = (dt-mLow)/mStep;
+  if( u<0 ){ return 0; }
+  int i = int(u);
+  if( i+1>=int(mShape.size()) ){ return 0; }
+  double f = u-i;
+  return mShape[i]+f*(mShape[i+1]-mShape[i]);
+}
+
+void StFcsPulseTemplateFit::shapeAndSlope(double dt, double& s, double& ds) const
+{
+  s = 0; ds = 0;
+  double u = (dt-mLow)/mStep;
+  if( u<0 ){ return; }
+  int i = int(u);
+  if( i+1>=int(mShape.size()) ){ return; }
+  double f = u-i;
+  s  = mShape[i]+f*(mShape[i+1]-mShape[i]);
+  ds = mSlope[i]+f*(mSlope[i+1]-mSlope[i]);
+}
+
+double StFcsPulseTemplateFit::chi2(int n, const double* tb, const double* adc, double ped, int npeak, const double* height, const double* mean) const
+{
+  double c2 = 0;
+  for( int i=0; i<n; ++i ){
+    if( tb[i]<mMinTB || tb[i]>mMaxTB ){ continue; }
+    double model = ped;
+    for( int k=0; k<npeak; ++k ){ model += height[k]*shape(tb[i]-mean[k]); }
+    double err = (adc[i]>=mAdcSaturation && model>adc[i]) ? mErrorSaturated : mError;
+    double r = (adc[i]-model)/err;
+    c2 += r*r;
+  }
+  return c2;
+}
+
+int StFcsPulseTemplateFit::solve(int m, double* a, double* b) const
+{
+  //a = L*L^T, L stored in the lower triangle of a
+  for( int j=0; j<m; ++j ){
+    double d = a[j*m+j];
+    for( int k=0; k<j; ++k ){ d -= a[j*m+k]*a[j*m+k]; }
+    if( d<=0 ){ return 0; }
+    d = sqrt(d);
+    a[j*m+j] = d;
+    for( int i=j+1; i<m; ++i ){
+      double s = a[i*m+j];
+      for( int k=0; k<j; ++k ){ s -= a[i*m+k]*a[j*m+k]; }
+      a[i*m+j] = s/d;
+    }
+  }
+  for( int i=0; i<m; ++i ){
+    double s = b[i];
+    for( int k=0; k<i; ++k ){ s -= a[i*m+k]*b[k]; }
+    b[i] = s/a[i*m+i];
+  }
+  for( int i=m-1; i>=0; --i ){
+    double s = b[i];
+    for( int k=i+1; k<m; ++k ){ s -= a[k*m+i]*b[k]; }
+    b[i] = s/a[i*m+i];
+  }
+  return 1;
+}
+
+float StFcsPulseTemplateFit::sum8(int n, const double* tb, const double* adc, float* res) const
+{
+  int min = mCenterTB-3;
+  int max = mCenterTB+4;
+  float sum=0;
+  float tsum=0;
+  for( int i=0; i<n; ++i ){
+    if( tb[i]>=min && tb[i]<=max ){
+      sum  += adc[i];
+      tsum += adc[i]*tb[i];
+    }
+  }
+  res[0]=sum;
+  if(sum>0) res[2]=tsum/sum;
+  return sum;
+}
+
+float StFcsPulseTemplateFit::fit(int n, const double* tb, const double* adc, double ped, float* res, double* para) const
+{
+  if( para!=0 ){ para[0]=0; para[1]=ped; }
+  if( !ready() ){ return res[0]; }
+
+  //find peaks, same as StFcsWaveformFitMaker::gausFit()
+  int trgmin = mCenterTB-4.5;
+  int trgmax = mCenterTB+5.5;
+  double height[kMaxPeak];
+  double mean[kMaxPeak];
+  double mean0[kMaxPeak];
+  int npeak=0;
+  int trgx=-1;
+  double mindt=1000;
+  for( int i=1; i<n-1; ++i ){
+    double tb1=tb[i];
+    if( tb1<mMinTB || tb1>mMaxTB ){ continue; }
+    double adc1=adc[i];
+    if( adc1-ped<mMinAdc ){ continue; }
+    double adc0 = (tb1-tb[i-1]>1.1) ? 0 : adc[i-1];
+    double adc2 = (tb[i+1]-tb1>1.1) ? 0 : adc[i+1];
+    if( (adc1>adc0 || tb1==mMinTB) && adc1>=adc2 ){
+      if( npeak<kMaxPeak ){
+	//start a saturated peak from the middle of its flat top, the +-2TB limit is around this
+	double tbEnd = tb1;
+	for( int j=i+1; adc1>=mAdcSaturation && j<n && adc[j]>=mAdcSaturation && tb[j]-tb[j-1]<1.1; ++j ){ tbEnd = tb[j]; }
+	mean[npeak]=mean0[npeak]=0.5*(tb1+tbEnd);
+      }
+      double dt = fabs(tb1-mCenterTB);
+      if( trgmin<tb1 && tb1<trgmax && dt<mindt ){ mindt=dt; trgx=npeak; }
+      npeak++;
+    }
+  }
+  if( npeak==0 ){ return res[0]; }
+  if( npeak>=mMaxPeak || npeak>kMaxPeak ){
+    res[5] = npeak;
+    sum8(n,tb,adc,res); //too many peak, taking sum8
+    res[0]/=1.21;       //normalized by 1/1.21
+    return res[0];
+  }
+
+  //heights for the found peak times: linear least squares, weights from the peak adc as a first guess
+  const int m = 2*npeak;
+  double a[4*kMaxPeak*kMaxPeak];
+  double b[2*kMaxPeak];
+  double s[kMaxPeak];
+  double ds[kMaxPeak];
+  int nsample=0;
+  for( int k=0; k<npeak; ++k ){ height[k]=0; }
+  for( int k=0; k<npeak*npeak; ++k ){ a[k]=0; }
+  for( int k=0; k<npeak; ++k ){ b[k]=0; }
+  for( int i=0; i<n; ++i ){
+    if( tb[i]<mMinTB || tb[i]>mMaxTB ){ continue; }
+    nsample++;
+    if( adc[i]>=mAdcSaturation ){ continue; } //only a lower bound, refit below with the asymmetric error
+    for( int k=0; k<npeak; ++k ){ s[k]=shape(tb[i]-mean[k]); }
+    for( int k=0; k<npeak; ++k ){
+      if( s[k]==0 ){ continue; }
+      b[k] += s[k]*(adc[i]-ped);
+      for( int l=0; l<=k; ++l ){ a[k*npeak+l] += s[k]*s[l]; }
+    }
+  }
+  for( int k=0; k<npeak; ++k ){
+    for( int l=0; l<k; ++l ){ a[l*npeak+k] = a[k*npeak+l]; }
+    a[k*npeak+k] += 1.0e-9;
+  }
+  if( solve(npeak,a,b) ){
+    for( int k=0; k<npeak; ++k ){ height[k] = b[k]<0 ? 0 : (b[k]>40000.0 ? 40000.0 : b[k]); }
+  }
+
+  //heights and times by Levenberg-Marquardt, parameters are height[0..npeak-1] then mean[0..npeak-1]
+  double c2 = chi2(n,tb,adc,ped,npeak,height,mean);
+  double lambda = 1.0e-3;
+  double jtj[4*kMaxPeak*kMaxPeak];
+  double jtr[2*kMaxPeak];
+  double h1[kMaxPeak];
+  double m1[kMaxPeak];
+  for( int iter=0; iter<mMaxIteration; ++iter ){
+    for( int k=0; k<m*m; ++k ){ jtj[k]=0; }
+    for( int k=0; k<m; ++k ){ jtr[k]=0; }
+    for( int i=0; i<n; ++i ){
+      if( tb[i]<mMinTB || tb[i]>mMaxTB ){ continue; }
+      double model = ped;
+      for( int k=0; k<npeak; ++k ){
+	shapeAndSlope(tb[i]-mean[k],s[k],ds[k]);
+	model += height[k]*s[k];
+      }
+      double err = (adc[i]>=mAdcSaturation && model>adc[i]) ? mErrorSaturated : mError;
+      double w = 1.0/(err*err);
+      double r = adc[i]-model;
+      double j[2*kMaxPeak];
+      for( int k=0; k<npeak; ++k ){
+	j[k] = s[k];
+	j[npeak+k] = -height[k]*ds[k];
+      }
+      for( int k=0; k<m; ++k ){
+	if( j[k]==0 ){ continue; }
+	jtr[k] += w*j[k]*r;
+	for( int l=0; l<=k; ++l ){ jtj[k*m+l] += w*j[k]*j[l]; }
+      }
+    }
+    for( int k=0; k<m; ++k ){
+      for( int l=0; l<k; ++l ){ a[k*m+l] = a[l*m+k] = jtj[k*m+l]; }
+      a[k*m+k] = jtj[k*m+k]*(1.0+lambda)+1.0e-9;
+      b[k] = jtr[k];
+    }
+    if( !solve(m,a,b) ){ lambda*=10; continue; }
+    for( int k=0; k<npeak; ++k ){
+      h1[k] = height[k]+b[k];
+      if( h1[k]<0 ) h1[k]=0;          //limit peak not to go negative
+      if( h1[k]>40000.0 ) h1[k]=40000.0;
+      m1[k] = mean[k]+b[npeak+k];
+      if( m1[k]<mean0[k]-2.0 ) m1[k]=mean0[k]-2.0; //limit peak position to +- 2TB
+      if( m1[k]>mean0[k]+2.0 ) m1[k]=mean0[k]+2.0;
+    }
+    double c2new = chi2(n,tb,adc,ped,npeak,h1,m1);
+    if( c2new<=c2 ){
+      bool converged = (c2-c2new) < 1.0e-4*c2+1.0e-6;
+      for( int k=0; k<npeak; ++k ){ height[k]=h1[k]; mean[k]=m1[k]; }
+      c2 = c2new;
+      lambda /= 10;
+      if( converged ){ break; }
+    }else{
+      lambda *= 10;
+      if( lambda>1.0e6 ){ break; }
+    }
+  }
+
+  int ndf = nsample-m;
+  res[4] = ndf>0 ? c2/ndf : 0;
+  res[5] = npeak;
+  if( trgx>=0 ){ //return pulse closest to center of triggered xing
+    res[1] = height[trgx];
+    res[2] = mean[trgx];
+    res[3] = mSigma;
+    res[0] = res[1]*res[3]*StFcsDbPulse::sqrt2pi();
+  }
+  if( para!=0 ){
+    para[0] = npeak;
+    for( int k=0; k<npeak; ++k ){
+      para[2+k*3] = height[k];
+      para[3+k*3] = mean[k];
+      para[4+k*3] = mSigma;
+    }
+  }
+  return res[0];
+}
@@ -0,0 +1,84 @@
+/*
+  Fast pulse fitter for FCS waveforms (mEnergySelect=14 of #StFcsWaveformFitMaker)
+
+  Fits the same model as #StFcsDbPulse::multiPulseShape() with the sigma of every pulse
+  fixed to #StFcsDbPulse::GSigma(): the pulse shape (Gaussian + tail) is then the same for
+  all pulses and is tabulated once per run together with its derivative. Pulses are found
+  like in #StFcsWaveformFitMaker::gausFit(), their heights are solved linearly for the found
+  peak times, and heights and times are then refit with a few Levenberg-Marquardt steps using
+  the analytic gradients from the table. It works on plain tb/adc arrays with no TGraph or TF1
+  and fit() is const, so one fitter can be used from several threads.
+
+  Errors follow #StFcsDbPulse::setTGraphAsymmErrors(): mError for all timebins except for the
+  upper error of saturated timebins, which is mErrorSaturated.
+*/
+
+#ifndef STFCSPULSETEMPLATEFIT_H
+#define STFCSPULSETEMPLATEFIT_H
+
+#include <vector>
+
+class StFcsDbPulse;
+
+class StFcsPulseTemplateFit
+{
+ public:
+  StFcsPulseTemplateFit();
+  ~StFcsPulseTemplateFit();
+
+  static const int kMaxPeak = 16;   //!< largest number of pulses fitted together
+
+  /**@brief Tabulate the pulse shape of pulse (tail as set in pulse) with a step of step [timebin]*/
+  void setPulse(StFcsDbPulse* pulse, double step=0.02);
+  void setCenterTimeBins(int center, int min, int max){ mCenterTB=center; mMinTB=min; mMaxTB=max; }
+  void setError(double err, double errSaturated, double adcSaturation){ mError=err; mErrorSaturated=errSaturated; mAdcSaturation=adcSaturation; }
+  void setMinAdc(int v){ mMinAdc=v; }
+  void setMaxPeak(int v){ mMaxPeak=v; }
+  void setMaxIteration(int v){ mMaxIteration=v; }
+
+  bool ready() const { return !mShape.empty(); }
+  double sigma() const { return mSigma; }
+
+  /**@brief Pulse shape of height 1 at dt [timebin] from its peak, 0 outside of the table*/
+  double shape(double dt) const;
+
+  /**@brief Fit the waveform
+
+     @param n number of timebins
+     @param tb timebins, in increasing order
+     @param adc adc of each timebin
+     @param ped pedestal, fixed in the fit
+     @param res filled like in #StFcsWaveformFitMaker::analyzeWaveform()\n
+       res[0] integral, res[1] height, res[2] peak position, res[3] sigma of the pulse closest to the center of the triggered crossing\n
+       res[4] chi2/ndf, res[5] number of peaks
+     @param para if not 0, filled with the parameters of all fitted pulses in the layout of #StFcsDbPulse::multiPulseShape() (at least 2+3*kMaxPeak)
+     @return res[0]
+  */
+  float fit(int n, const double* tb, const double* adc, double ped, float* res, double* para=0) const;
+
+  /**@brief Sum of the 8 timebins of the triggered crossing, like #StFcsWaveformFitMaker::sum8()*/
+  float sum8(int n, const double* tb, const double* adc, float* res) const;
+
+ protected:
+  void shapeAndSlope(double dt, double& s, double& ds) const;
+  double chi2(int n, const double* tb, const double* adc, double ped, int npeak, const double* height, const double* mean) const;
+  int solve(int m, double* a, double* b) const;   //!< Cholesky solve of a*x=b (a is m*m, symmetric), x is returned in b, 0 if a is not positive definite
+
+  double mSigma = 0;                 //!< sigma of the tabulated pulse
+  double mStep = 0.02;               //!< table step [timebin]
+  double mLow = 0;                   //!< first table entry [timebin from peak]
+  std::vector<double> mShape;        //!< pulse shape of height 1
+  std::vector<double> mSlope;        //!< derivative of mShape
+
+  int mCenterTB = 50;
+  int mMinTB = 0;
+  int mMaxTB = 512;
+  double mError = 1.0;
+  double mErrorSaturated = 1000.0;
+  double mAdcSaturation = 4000.0;
+  int mMinAdc = 5;
+  int mMaxPeak = 5;
+  int mMaxIteration = 10;
+};
+
+#endif
@@ -64,6 +64,7 @@
 //
 
 #include "StFcsWaveformFitMaker.h"
+#include "StFcsPulseTemplateFit.h"
 
 ClassImp(StFcsWaveformFitMaker)
 
@@ -75,6 +76,7 @@ ClassImp(StFcsWaveformFitMaker)
 
 #include <cmath>
 #include <chrono>
+#include "StarClassLibrary/StParallelFor.hh"
 #include "TMath.h"
 #include "TF1.h"
 #include "TH1F.h"
@@ -129,6 +131,7 @@ StFcsWaveformFitMaker::StFcsWaveformFitMaker(const char* name) : StMaker(name) {
 StFcsWaveformFitMaker::~StFcsWaveformFitMaker() {
   mChWaveData.Delete();
   delete mPulseFit;
+  delete mTemplateFit;
   for( UShort_t i=0; i<7; ++i ){
     if( i<3 ){
       delete mH2_Dep0DepMod[i];
@@ -349,6 +352,12 @@ int StFcsWaveformFitMaker::InitRun(int runNumber) {
     mDbPulse->setTail(mTail);
     if( mPulseFit==0 ){ mPulseFit = new StFcsPulseAna(); SetupDavidFitterMay2022(); mPulseFit->setDbPulse(mDbPulse); }
     mPulseFit->setDbPulse(mDbPulse);
+    if( mTemplateFit==0 ){ mTemplateFit = new StFcsPulseTemplateFit(); }
+    mTemplateFit->setPulse(mDbPulse);
+    mTemplateFit->setCenterTimeBins(mCenterTB,mMinTB,mMaxTB);
+    mTemplateFit->setError(mError,mErrorSaturated,mAdcSaturation);
+    mTemplateFit->setMinAdc(mMinAdc);
+    mTemplateFit->setMaxPeak(mMaxPeak);
     
     return StMaker::InitRun(runNumber);
 }
@@ -459,12 +468,20 @@ int StFcsWaveformFitMaker::Make() {
     if(mEnergySelect[0]==0) return kStOK;  // don't touch energy, directly from MC
 
     //Loop over all hits and run waveform analysis of the choice
+    //Hits with PulseFitFast (14) are only collected here and fitted together after the loop,
+    //unless the fits are drawn, timed or tested which needs the graph of each hit
     float res[8];
     TF1* func=0;
+    bool batch = !mFitDrawOn && !mFilter && !mMeasureTime && mTest==0;
+    mTemplateHits.clear();
+    mTemplatePed.clear();
     for(int det=0; det<kFcsNDet; det++) {      
 	StSPtrVecFcsHit& hits = mFcsCollection->hits(det);
 	int ehp = det/2;
 	int nhit=hits.size();
+	mGain.resize(nhit);
+	mGainCorr.resize(nhit);
+	if(nhit>0) mDb->getGain(nhit,&hits[0],&mGain[0],&mGainCorr[0]);
 	for(int i=0; i<nhit; i++){ //loop over all hits  	    
 	  
 	  auto start=std::chrono::high_resolution_clock::now();
@@ -489,20 +506,16 @@ int StFcsWaveformFitMaker::Make() {
 	    }
 	  }
 	  
+	  if(batch && mEnergySelect[ehp]==14){
+	    mTemplateHits.push_back(hits[i]);
+	    mTemplatePed.push_back(ped);
+	    continue;
+	  }
+
 	  //run waveform analysis of the choice and store as AdcSum	  
 	  memset(res,0,sizeof(res));
 	  float integral = analyzeWaveform(mEnergySelect[ehp],hits[i],res,func,ped);
-	  hits[i]->setAdcSum(integral);	    
-	  hits[i]->setFitPeak(res[2]);	    
-	  hits[i]->setFitSigma(res[3]);	    
-	  hits[i]->setFitChi2(res[4]);	    
-	  hits[i]->setNPeak(res[5]);	    
-	  //apply gain and update energy
-	  float gain = mDb->getGain(hits[i]);
-	  float gaincorr = mDb->getGainCorrection(hits[i]);
-	  hits[i]->setEnergy(integral*gain*gaincorr);
-	  if(GetDebug()>0) printf("det=%1d id=%3d integ=%10.2f peak=%8.2f, sig=%8.4f chi2=%8.2f npeak=%2d\n",
-				  det,hits[i]->id(),integral,res[2],res[3],res[4],int(res[5]));
+	  setHitResult(hits[i],integral,res,mGain[i],mGainCorr[i]);
 	  if(mMeasureTime){
 	    auto stop=std::chrono::high_resolution_clock::now();
 	    long long usec = chrono::duration_cast<chrono::microseconds>(stop-start).count();
@@ -525,9 +538,51 @@ int StFcsWaveformFitMaker::Make() {
 	  }
 	}
     }
+    if(!mTemplateHits.empty()) fitTemplateHits();
     return kStOk;
 }
 
+void StFcsWaveformFitMaker::setHitResult(StFcsHit* hit, float integral, const float* res, float gain, float gaincorr){
+    hit->setAdcSum(integral);
+    hit->setFitPeak(res[2]);
+    hit->setFitSigma(res[3]);
+    hit->setFitChi2(res[4]);
+    hit->setNPeak(res[5]);
+    //apply gain and update energy
+    hit->setEnergy(integral*gain*gaincorr);
+    if(GetDebug()>0) printf("det=%1d id=%3d integ=%10.2f peak=%8.2f, sig=%8.4f chi2=%8.2f npeak=%2d\n",
+			    hit->detectorId(),hit->id(),integral,res[2],res[3],res[4],int(res[5]));
+}
+
+void StFcsWaveformFitMaker::fitTemplateHits(){
+    //The fits only read the hits and the (const) template fitter and write to their own
+    //slot of mTemplateRes, the hits are updated afterwards on this thread in hit order
+    int nhit = mTemplateHits.size();
+    mTemplateRes.assign(nhit*8,0.0);
+    int nworker = mNThreads>1 ? mNThreads : 1;
+    std::vector<std::vector<double>> tb(nworker), adc(nworker); //timebins and adc, per worker
+    StParallelFor(nhit, nworker, [&](size_t i, size_t w){
+	StFcsHit* hit = mTemplateHits[i];
+	int n = hit->nTimeBin();
+	tb[w].clear();
+	adc[w].clear();
+	for(int j=0; j<n; j++){  //same timebins as makeTGraphAsymmErrors(StFcsHit*)
+	  int t=hit->timebin(j);
+	  if(t>=mMinTB){
+	    tb[w].push_back(t);
+	    adc[w].push_back(hit->adc(j));
+	  }
+	  if(t>=mMaxTB) break;
+	}
+	mTemplateFit->fit((int)tb[w].size(),tb[w].data(),adc[w].data(),mTemplatePed[i],&mTemplateRes[i*8]);
+    });
+
+    mGain.resize(nhit);
+    mGainCorr.resize(nhit);
+    mDb->getGain(nhit,&mTemplateHits[0],&mGain[0],&mGainCorr[0]);
+    for(int i=0; i<nhit; i++) setHitResult(mTemplateHits[i],mTemplateRes[i*8],&mTemplateRes[i*8],mGain[i],mGainCorr[i]);
+}
+
 TGraphAsymmErrors* StFcsWaveformFitMaker::resetGraph(){
   TGraphAsymmErrorsWithReset* gae = (TGraphAsymmErrorsWithReset*)mChWaveData.ConstructedAt(mHitIdx);
   gae->Reset();
@@ -633,6 +688,7 @@ float StFcsWaveformFitMaker::analyzeWaveform(int select, TGraphAsymmErrors* g, f
     case 11: integral = gausFitWithPed(g, res, func); break;
     case 12: integral = PulseFit1(g,res,func); break;
     case 13: integral = PulseFit2(g,res,func); break;
+    case 14: integral = PulseFitFast(g,res,func,ped); break;
     case 21: integral = PedFit(g, res, func); break;
     case 31: integral = LedFit(g, res, func); break;
     default: 
@@ -1467,6 +1523,17 @@ float StFcsWaveformFitMaker::PulseFit2(TGraphAsymmErrors* gae, float* res, TF1*&
   return res[0];
 }
 
+float StFcsWaveformFitMaker::PulseFitFast(TGraphAsymmErrors* g, float* res, TF1*& func, float ped){
+  double para[2+3*StFcsPulseTemplateFit::kMaxPeak];
+  float integral = mTemplateFit->fit(g->GetN(),g->GetX(),g->GetY(),ped,res,para);
+  if( para[0]>0 && mFitDrawOn && mFilename ){ //TF1 only to draw the fit
+    func = mDbPulse->createPulse(mMinTB,mMaxTB,2+int(para[0])*3);
+    func->SetLineColor(6);
+    func->SetParameters(para);
+  }
+  return integral;
+}
+
 float StFcsWaveformFitMaker::PedFit(TGraphAsymmErrors* gae, float* res, TF1*& func){
   if( mPulseFit==0 ){mPulseFit = new StFcsPulseAna(gae);}
   else{mPulseFit->SetData(gae);}//Resets finder
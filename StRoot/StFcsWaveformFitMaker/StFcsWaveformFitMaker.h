@@ -55,6 +55,7 @@
 #include "StFcsPulseAna.h"
 
 #include "TH2.h"
+#include <vector>
 
 class StFcsCollection;
 class StFcsHit;
@@ -63,6 +64,7 @@ class StFcsDbPulse;
 class TGraphAsymmErrors;
 class TGraph;
 class TCanvas;
+class StFcsPulseTemplateFit;
 
 class StFcsWaveformFitMaker : public StMaker {
 public:
@@ -86,6 +88,7 @@ public:
     void setTail(int v);
     void setMaxPeak(int v)        {mMaxPeak=v;}
     void setPedTimeBins(int min, int max) {mPedMin=min; mPedMax=max;}
+    void setNThreads(int v)       {mNThreads=v;} //!< threads for the hits with mEnergySelect=14
 
     TGraphAsymmErrors* resetGraph();    //! Create or Reset TGraphAsymmErrors (at mHitIdx)
   
@@ -133,6 +136,7 @@ public:
     float gausFitWithPed (TGraphAsymmErrors* g, float *res, TF1*& f);         //! mEnergySelect=11
     float PulseFit1(TGraphAsymmErrors* g, float* res, TF1*& f);                //! mEnergySelect=12
     float PulseFit2(TGraphAsymmErrors* g, float* res, TF1*& f);                //! mEnergySelect=13
+    float PulseFitFast(TGraphAsymmErrors* g, float* res, TF1*& f, float ped=0.0); //! mEnergySelect=14
 
     //Pedestal Analysis methods
     //res[0] pedestal Value
@@ -240,6 +244,8 @@ public:
     void SetupDavidFitterMay2022(Double_t ped=0);    //! This special function is used to set all the parameters for #StFcsPulseAna based on cosmic and Run 22 data. It is intended to be used only for Run 22 data
     int PeakCompare(const PeakWindow& pwin1, const PeakWindow& pwin2 ); //Compare if two peaks overlap and return a bit vector of tests passed/failed for comparing pwin1 to pwin2. 0 means all tests passed and pwin1 does not overlap with pwin2
     int NPeaksPre2Post1(int& trigidx, Double_t& xmin, Double_t& xmax) const;//xmin and xmax will be the range of the pre-crossing -2 and post-crossing +1 peaks. trigidx is needed to pick up the triggered crossing in the new number of peaks
+    void setHitResult(StFcsHit* hit, float integral, const float* res, float gain, float gaincorr); //Stores res in the hit and updates its energy
+    void fitTemplateHits();  //Fits mTemplateHits with #StFcsPulseTemplateFit on mNThreads threads
 
  private:
     StFcsDb* mDb=0;                    //! pointer to fcsDb
@@ -269,6 +275,15 @@ public:
     int mTail=2;                         //! pulse tail shape (0=none, 1=summer2020) 
     int mMaxPeak=5;                      //! max # of peak for trying to fit
 
+    //PulseFitFast
+    StFcsPulseTemplateFit* mTemplateFit=0;  //! tabulated pulse shape fitter
+    int mNThreads=1;                        //! threads used to fit the hits with mEnergySelect=14
+    std::vector<StFcsHit*> mTemplateHits;   //! hits of the event with mEnergySelect=14
+    std::vector<float> mTemplatePed;        //! pedestal of mTemplateHits
+    std::vector<float> mTemplateRes;        //! 8 results per hit of mTemplateHits
+    std::vector<float> mGain;               //! gain of the hits being stored, from StFcsDb::getGain(n,hits,...)
+    std::vector<float> mGainCorr;           //! gain correction of the hits being stored
+
     //Drawing fits
     TCanvas* mCanvas=0; 
     int mPage=0;
@@ -11,7 +11,7 @@
 #include "StEvent/StFstConsts.h"
 #include "StFstClusterMaker/StFstIClusterAlgo.h"
 #include "StFstClusterMaker/StFstScanRadiusClusterAlgo.h"
-StFstClusterMaker::StFstClusterMaker( const char *name ) : StMaker(name), mFstCollectionPtr(0), mClusterAlgoPtr(0), mTimeBin(UCHAR_MAX), mSplitCluster(true)
+StFstClusterMaker::StFstClusterMaker( const char *name ) : StMaker(name), mFstCollectionPtr(0), mClusterAlgoPtr(0), mTimeBin(UCHAR_MAX), mSplitCluster(true), mNThreads(1)
 {};
 
 StFstClusterMaker::~StFstClusterMaker()
@@ -56,6 +56,7 @@ Int_t StFstClusterMaker::Make()
 
    mClusterAlgoPtr->setUsedTimeBin(mTimeBin);
    mClusterAlgoPtr->setSplitFlag(mSplitCluster);
+   mClusterAlgoPtr->setNThreads(mNThreads);
    mClusterAlgoPtr->doClustering(*mFstCollectionPtr);
 
 
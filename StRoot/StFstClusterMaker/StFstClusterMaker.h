@@ -29,6 +29,7 @@ public:
    void setClusterAlgo(StFstIClusterAlgo *);
    void setUsedTimeBin(unsigned char tb=UCHAR_MAX) { mTimeBin = tb; }
    void setClusterSplitFlag(bool splitFlag=true) { mSplitCluster = splitFlag; }
+   void setNThreads(int nThreads=1) { mNThreads = nThreads; }
 
 protected:
    StFstCollection *mFstCollectionPtr;
@@ -36,6 +37,7 @@ protected:
 
    UChar_t mTimeBin;     ///< Time bin to be used
    Bool_t mSplitCluster; ///< Flag to split clusters
+   Int_t mNThreads;      ///< Threads to cluster the wedges in parallel
 
    ClassDef(StFstClusterMaker, 0);
 };
@@ -2,15 +2,20 @@
 #include "StEvent/StEnumerations.h"
 #include "St_base/StMessMgr.h"
 #include "StEvent/StFstConsts.h"
+#include "StarClassLibrary/StParallelFor.hh"
 
 /**
  * Calls the actual clustering method that creates a cluster collection from
- * a raw hit collection for each FST wedge.
+ * a raw hit collection for each FST wedge. The wedges are shared among
+ * mNThreads threads, each wedge only writes its own collections.
  *
  * \author Shenghui Zhang
  */
 void StFstIClusterAlgo::doClustering(StFstCollection &stFstCollection)
 {
+   int wedges[kFstNumWedges];
+   int nWedges = 0;
+
    for ( unsigned char wedgeIdx = 0; wedgeIdx < kFstNumWedges; ++wedgeIdx ) {
       StFstRawHitCollection  *stFstRawHitCollection  = stFstCollection.getRawHitCollection( wedgeIdx );
       StFstClusterCollection *stFstClusterCollection = stFstCollection.getClusterCollection( wedgeIdx );
@@ -21,7 +26,11 @@ void StFstIClusterAlgo::doClustering(StFstCollection &stFstCollection)
          continue;
       }
 
-      // clustering and splitting
-      doClustering(stFstCollection, *stFstRawHitCollection, *stFstClusterCollection);
+      wedges[nWedges++] = wedgeIdx;
    }
+
+   // clustering and splitting
+   StParallelFor(nWedges, mNThreads > 1 ? mNThreads : 1, [&](size_t i, size_t) {
+      doClustering(stFstCollection, *stFstCollection.getRawHitCollection(wedges[i]), *stFstCollection.getClusterCollection(wedges[i]));
+   });
 }
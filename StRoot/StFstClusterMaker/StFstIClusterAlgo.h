@@ -12,18 +12,22 @@ class StFstClusterCollection;
 
 /**
  * Abstract interface for concrete implementations of clustering algorithms.
+ * With setNThreads() > 1 the wedges are clustered in parallel, the protected
+ * doClustering() is then called for different wedges at the same time.
  *
  * \author Shenghui Zhang \date Sep 2021
  */
 class StFstIClusterAlgo
 {
 public:
+   StFstIClusterAlgo() : mSplitCluster(true), mTimeBin(UCHAR_MAX), mNThreads(1) {}
    void doClustering(StFstCollection &stFstCollection);
 
    virtual ~StFstIClusterAlgo() = 0;
 
    void setUsedTimeBin(unsigned char tb = UCHAR_MAX) { mTimeBin = tb; }
    void setSplitFlag( bool splitFlag = true)  { mSplitCluster = splitFlag; }
+   void setNThreads(int nThreads = 1) { mNThreads = nThreads; }
 
 protected:
 
@@ -31,6 +35,7 @@ protected:
 
    Bool_t mSplitCluster;
    UChar_t mTimeBin;
+   Int_t mNThreads;   ///< Threads for the wedges
 };
 
 #endif
\ No newline at end of file
@@ -10,21 +10,17 @@
 #include "StEvent/StFstConsts.h"
 
 #include <math.h>
-#include <iostream>
-#include <iterator>
 #include <vector>
-#include <algorithm>
 
 
 Int_t StFstScanRadiusClusterAlgo::doClustering(const StFstCollection &fstCollection, StFstRawHitCollection &rawHitsOriginal, StFstClusterCollection &clusters )
 {
   StFstCluster *newCluster = 0;
-  StFstRawHit *rawHitTemp = 0;
-  StFstRawHit *rawHitMaxAdcTemp = 0;
+  const StFstRawHit *rawHitMaxAdcTemp = 0;
   Int_t clusterType = kFstScanRadiusClusterAlgo;
-  Int_t maxTb = -1, usedTb = -1;
+  Int_t maxTb = -1;
   Int_t disk = 0, wedge = 0, sensor = -1, apv = -1;
-  Float_t meanRStrip = -1., maxRStrip = -1, meanPhiStrip = -1;
+  Float_t meanRStrip = -1., meanPhiStrip = -1;
   Float_t totCharge = 0., totChargeErr = 0.;
   Int_t clusterSize = 0, clusterSizeR = 0, clusterSizePhi = 0;
   unsigned short idTruth = 0;
@@ -34,198 +30,166 @@ Int_t StFstScanRadiusClusterAlgo::doClustering(const StFstCollection &fstCollect
 
   //sort raw hits in increasing order by geometry ID
   rawHitsOriginal.sortByGeoId();
+  const std::vector<StFstRawHit *> &rawHitVec = rawHitsOriginal.getRawHitVec();
+  int nRawHits = rawHitVec.size();
 
-  //copy raw hit collection to temporary vectors
-  std::vector<StFstRawHit *>  rawHitsVec[kFstNumSensorsPerWedge][kFstNumPhiSegPerSensor];
-  std::vector<StFstCluster *> clustersVec[kFstNumSensorsPerWedge][kFstNumPhiSegPerSensor];
-  std::vector<StFstRawHit *>  rawHitsToMerge;
+  //all raw hits in one phistrip make one cluster, the hits of a phistrip are summed
+  //in decreasing geometry ID order
+  StripSum stripSum[kFstNumSensorsPerWedge][kFstNumPhiSegPerSensor];
+  StFstCluster *clustersVec[kFstNumSensorsPerWedge][kFstNumPhiSegPerSensor];
 
   for (int sensorIdx = 0; sensorIdx < kFstNumSensorsPerWedge; sensorIdx++) {
     for (int phiIdx = 0; phiIdx < kFstNumPhiSegPerSensor; phiIdx++) {
-      rawHitsVec[sensorIdx][phiIdx].reserve(kFstNumRStripsPerSensor);
-      clustersVec[sensorIdx][phiIdx].reserve(kFstNumRStripsPerSensor);
+      stripSum[sensorIdx][phiIdx].nHits = 0;
+      clustersVec[sensorIdx][phiIdx] = 0;
     }
   }
 
-  rawHitsToMerge.reserve(kFstNumRStripsPerSensor);
+  //sweep 1: find the raw hit with maximum ADC, a hit takes it over if its ADC
+  //is larger than the one of the previous hit of the phistrip
+  for (int i = nRawHits - 1; i >= 0; i--) {
+    const StFstRawHit *rawHit = rawHitVec[i];
+    StripSum &sum = stripSum[(int)rawHit->getSensor()][(int)rawHit->getPhiStrip()];
+    float charge = rawHit->getCharge(rawHit->getMaxTimeBin());
 
-  for (std::vector< StFstRawHit * >::iterator rawHitPtr = rawHitsOriginal.getRawHitVec().begin(); rawHitPtr != rawHitsOriginal.getRawHitVec().end(); ++rawHitPtr) {
-    int sensorIndex = (int)(*rawHitPtr)->getSensor();
-    int phiIndex = (int)(*rawHitPtr)->getPhiStrip();
-    rawHitsVec[sensorIndex][phiIndex].push_back( new StFstRawHit( *(*rawHitPtr)) );
-  }
+    if (sum.nHits == 0 || charge > sum.lastCharge)
+      sum.maxAdcHit = i;
 
-  //do clustering
-  int clusterLabel = 0;
-
-  for (int sensorIdx = 0; sensorIdx < kFstNumSensorsPerWedge; sensorIdx++)
-  {
-    //step 1: do clustering for each phi
-    for (int phiIdx = 0; phiIdx < kFstNumPhiSegPerSensor; phiIdx++)
-    {
-      while ( !rawHitsVec[sensorIdx][phiIdx].empty() )
-      {
-	rawHitTemp = rawHitsVec[sensorIdx][phiIdx].back();
-	rawHitsVec[sensorIdx][phiIdx].pop_back();
-	rawHitsToMerge.push_back(rawHitTemp);
-	//count number to merge
-	int nToMerge = 1;
-	//find all raw hits that are neighboring
-	std::vector<StFstRawHit *>::iterator rawHitsToMergePtr = rawHitsToMerge.begin();
-	rawHitMaxAdcTemp = *rawHitsToMergePtr;
-
-	// put all raw hits in one phi strip to rawHitsToMerge
-	while (rawHitsToMergePtr != rawHitsToMerge.end() && !rawHitsVec[sensorIdx][phiIdx].empty()) {
-	  rawHitTemp = rawHitsVec[sensorIdx][phiIdx].back();
-	  rawHitsVec[sensorIdx][phiIdx].pop_back();
-
-	  ++nToMerge;
-	  rawHitsToMerge.push_back(rawHitTemp);
-
-	  if ( rawHitTemp->getCharge(rawHitTemp->getMaxTimeBin()) > (*rawHitsToMergePtr)->getCharge((*rawHitsToMergePtr)->getMaxTimeBin()) )
-	    rawHitMaxAdcTemp = rawHitTemp;
-
-	  ++rawHitsToMergePtr;
-	}
+    sum.lastCharge = charge;
+    sum.nHits++;
+  }
 
-	//used time bin index (raw hits with maximum ADC holds the time-bin priority)
-	maxTb   = rawHitMaxAdcTemp->getMaxTimeBin();
-	idTruth = rawHitMaxAdcTemp->getIdTruth();
+  //used time bin index (raw hits with maximum ADC holds the time-bin priority)
+  for (int sensorIdx = 0; sensorIdx < kFstNumSensorsPerWedge; sensorIdx++) {
+    for (int phiIdx = 0; phiIdx < kFstNumPhiSegPerSensor; phiIdx++) {
+      StripSum &sum = stripSum[sensorIdx][phiIdx];
 
-	if (maxTb < 0 || maxTb >= nTimeBins)         maxTb  = rawHitMaxAdcTemp->getDefaultTimeBin();
+      if (sum.nHits == 0) continue;
 
-	if (mTimeBin < nTimeBins)                    usedTb = mTimeBin;
-	else                                         usedTb = maxTb;
+      sum.maxTb = rawHitVec[sum.maxAdcHit]->getMaxTimeBin();
 
-	disk            = rawHitMaxAdcTemp->getDisk();
-	wedge      	= rawHitMaxAdcTemp->getWedge();
-	sensor      	= rawHitMaxAdcTemp->getSensor(); // = sensorIdx
-	apv      	= rawHitMaxAdcTemp->getApv();
-	meanPhiStrip    = (float)rawHitMaxAdcTemp->getPhiStrip(); // = phiIdx
-	clusterSize 	= nToMerge;
-	clusterSizeR 	= nToMerge;
-	clusterSizePhi 	= 1;
+      if (sum.maxTb < 0 || sum.maxTb >= nTimeBins) sum.maxTb = rawHitVec[sum.maxAdcHit]->getDefaultTimeBin();
 
-	float tempCharge[nToMerge], tempChargeErr[nToMerge], tempRStrip[nToMerge];
+      if (mTimeBin < nTimeBins)                    sum.usedTb = mTimeBin;
+      else                                         sum.usedTb = sum.maxTb;
 
-	for (int i = 0; i < nToMerge; i++) {
-	  tempCharge[i] = 0.; tempChargeErr[i] = 0.; tempRStrip[i] = 0.;
-	}
+      sum.nSeedHits = 0;
+      sum.charge = 0;
+      sum.chargeErrSquare = 0;
+      sum.maxRStrip = 0;
+    }
+  }
 
-	float tempSumCharge = 0, tempSumChargeErrSquare = 0.;
-	int mergeIdx = 0;
-	//count number to seed hit
-	int nToSeedhit = 0;
-
-	for (rawHitsToMergePtr = rawHitsToMerge.begin(); rawHitsToMergePtr != rawHitsToMerge.end() && mergeIdx < nToMerge; ++rawHitsToMergePtr, ++mergeIdx) {
-	  tempCharge[mergeIdx]    = (*rawHitsToMergePtr)->getCharge(usedTb);
-	  tempChargeErr[mergeIdx] = (*rawHitsToMergePtr)->getChargeErr(usedTb);
-	  tempRStrip[mergeIdx]    = (float)(*rawHitsToMergePtr)->getRStrip();
-	  tempSumCharge += (*rawHitsToMergePtr)->getCharge(usedTb);
-	  if ( (*rawHitsToMergePtr)->getSeedhitflag() == 1 ) ++nToSeedhit;
-	}
+  //sweep 2: sum charge, charge error and rstrip at the used time bin
+  for (int i = nRawHits - 1; i >= 0; i--) {
+    const StFstRawHit *rawHit = rawHitVec[i];
+    StripSum &sum = stripSum[(int)rawHit->getSensor()][(int)rawHit->getPhiStrip()];
+    float chargeErr = rawHit->getChargeErr(sum.usedTb);
+    float rStrip = (float)rawHit->getRStrip();
 
-	meanRStrip = 0;
-	maxRStrip = 0;
+    sum.charge += rawHit->getCharge(sum.usedTb);
+    sum.chargeErrSquare += chargeErr * chargeErr;
 
-	for (int iRawHit = 0; iRawHit < nToMerge; iRawHit++)  {
-	  if(tempRStrip[iRawHit]>maxRStrip)
-	    maxRStrip = tempRStrip[iRawHit];
-	  meanRStrip = maxRStrip;
-	  tempSumChargeErrSquare += tempChargeErr[iRawHit] * tempChargeErr[iRawHit];
-	}
+    if (rStrip > sum.maxRStrip)
+      sum.maxRStrip = rStrip;
 
-	totCharge    = tempSumCharge;
-	totChargeErr = sqrt(tempSumChargeErrSquare / nToMerge);
-
-	newCluster = new StFstCluster((int)wedge * 10000 + clusterLabel, disk, wedge, sensor, apv, meanRStrip, meanPhiStrip, totCharge, totChargeErr, clusterType);
-	newCluster->setNRawHits(clusterSize);
-	newCluster->setNRawHitsR(clusterSizeR);
-	newCluster->setNRawHitsPhi(clusterSizePhi);
-	newCluster->setMaxTimeBin(maxTb);
-	newCluster->setIdTruth(idTruth);
+    if (rawHit->getSeedhitflag() == 1) ++sum.nSeedHits;
+  }
 
-	if(nToSeedhit>0) {
-	  clustersVec[sensorIdx][phiIdx].push_back(newCluster);
-	  clusterLabel++;
-	}
+  //do clustering
+  int clusterLabel = 0;
 
-	rawHitsToMerge.clear();
-      }//end current phi raw hits loop
+  for (int sensorIdx = 0; sensorIdx < kFstNumSensorsPerWedge; sensorIdx++)
+  {
+    //step 1: do clustering for each phi
+    for (int phiIdx = 0; phiIdx < kFstNumPhiSegPerSensor; phiIdx++)
+    {
+      const StripSum &sum = stripSum[sensorIdx][phiIdx];
+
+      if (sum.nHits == 0 || sum.nSeedHits == 0) continue;
+
+      rawHitMaxAdcTemp = rawHitVec[sum.maxAdcHit];
+      maxTb   = sum.maxTb;
+      idTruth = rawHitMaxAdcTemp->getIdTruth();
+      disk            = rawHitMaxAdcTemp->getDisk();
+      wedge           = rawHitMaxAdcTemp->getWedge();
+      sensor          = rawHitMaxAdcTemp->getSensor(); // = sensorIdx
+      apv             = rawHitMaxAdcTemp->getApv();
+      meanPhiStrip    = (float)rawHitMaxAdcTemp->getPhiStrip(); // = phiIdx
+      meanRStrip      = sum.maxRStrip;
+      clusterSize     = sum.nHits;
+      clusterSizeR    = sum.nHits;
+      clusterSizePhi  = 1;
+      totCharge       = sum.charge;
+      totChargeErr    = sqrt(sum.chargeErrSquare / sum.nHits);
+
+      newCluster = new StFstCluster((int)wedge * 10000 + clusterLabel, disk, wedge, sensor, apv, meanRStrip, meanPhiStrip, totCharge, totChargeErr, clusterType);
+      newCluster->setNRawHits(clusterSize);
+      newCluster->setNRawHitsR(clusterSizeR);
+      newCluster->setNRawHitsPhi(clusterSizePhi);
+      newCluster->setMaxTimeBin(maxTb);
+      newCluster->setIdTruth(idTruth);
+
+      clustersVec[sensorIdx][phiIdx] = newCluster;
+      clusterLabel++;
     }//end current sensor raw hits loop
 
-    //step 2: do clustering for neighboring phistrips
-    std::vector<StFstCluster *>::iterator clusterIt1, clusterIt2;
+    //step 2: do clustering for neighboring phistrips, a cluster is merged into the one of
+    //the next phistrip, which can then be merged into the one of the phistrip after
     for (int phiIdx1 = 0; phiIdx1 < kFstNumPhiSegPerSensor - 1; phiIdx1++) {
       int phiIdx2 = phiIdx1 + 1;
+      StFstCluster *cluster1 = clustersVec[sensorIdx][phiIdx1];
+      StFstCluster *cluster2 = clustersVec[sensorIdx][phiIdx2];
+
+      if (!cluster1 || !cluster2) continue;
+
+      float rstripDfstance = cluster1->getMeanRStrip() - cluster2->getMeanRStrip();
+
+      if (TMath::Abs(rstripDfstance) < 3.5) { //here 3.5 means the dfstance between two clusters' weighted centers in r direction smaller than 3.5 rStrip
+	idTruth = cluster1->getIdTruth();
+	apv     = cluster1->getApv();
+	if(cluster1->getTotCharge() < cluster2->getTotCharge()) {
+	  idTruth = cluster2->getIdTruth();
+	  apv     = cluster2->getApv();
+	}
 
-      if (clustersVec[sensorIdx][phiIdx1].size() > 0 && clustersVec[sensorIdx][phiIdx2].size() > 0) {
-	for (clusterIt1 = clustersVec[sensorIdx][phiIdx1].begin(); clusterIt1 != clustersVec[sensorIdx][phiIdx1].end() && !clustersVec[sensorIdx][phiIdx1].empty(); clusterIt1++) {
-	  for (clusterIt2 = clustersVec[sensorIdx][phiIdx2].begin(); clusterIt2 != clustersVec[sensorIdx][phiIdx2].end() && !clustersVec[sensorIdx][phiIdx1].empty(); clusterIt2++) {
-	    float rstripDfstance = (*clusterIt1)->getMeanRStrip() - (*clusterIt2)->getMeanRStrip();
-
-	    if (TMath::Abs(rstripDfstance) < 3.5) { //here 3.5 means the dfstance between two clusters' weighted centers in r direction smaller than 3.5 rStrip
-	      maxTb   = (*clusterIt1)->getMaxTimeBin();
-	      idTruth = (*clusterIt1)->getIdTruth();
-	      apv     = (*clusterIt1)->getApv();
-	      if((*clusterIt1)->getTotCharge() < (*clusterIt2)->getTotCharge()) {
-		maxTb   = (*clusterIt2)->getMaxTimeBin();
-		idTruth = (*clusterIt2)->getIdTruth();
-		apv     = (*clusterIt2)->getApv();
-	      }
-
-	      totCharge      = (*clusterIt1)->getTotCharge() + (*clusterIt2)->getTotCharge();
-	      totChargeErr   = sqrt(((*clusterIt1)->getTotChargeErr() * (*clusterIt1)->getTotChargeErr() * (*clusterIt1)->getNRawHits() + (*clusterIt2)->getTotChargeErr() * (*clusterIt2)->getTotChargeErr() * (*clusterIt2)->getNRawHits()) / ((*clusterIt1)->getNRawHits() + (*clusterIt2)->getNRawHits()));
-	      clusterSize    = (*clusterIt1)->getNRawHits() + (*clusterIt2)->getNRawHits();
-	      int maxClusterR1 = (*clusterIt1)->getMeanRStrip(); 
-	      int minClusterR1 = (*clusterIt1)->getMeanRStrip() - (*clusterIt1)->getNRawHitsR() + 1; 
-	      int maxClusterR2 = (*clusterIt2)->getMeanRStrip(); 
-	      int minClusterR2 = (*clusterIt2)->getMeanRStrip() - (*clusterIt2)->getNRawHitsR() + 1; 
-	      int maxClusterR = maxClusterR1 > maxClusterR2 ? maxClusterR1 : maxClusterR2;
-	      int minClusterR = minClusterR1 < minClusterR2 ? minClusterR1 : minClusterR2;
-	      clusterSizeR   = maxClusterR - minClusterR + 1; // max at 4
-	      clusterSizePhi = (*clusterIt1)->getNRawHitsPhi() + (*clusterIt2)->getNRawHitsPhi();
-	      meanRStrip     = (*clusterIt1)->getMeanRStrip();
-	      if ((*clusterIt2)->getMeanRStrip() > (*clusterIt1)->getMeanRStrip()) 
-		meanRStrip  = (*clusterIt2)->getMeanRStrip();
-	      meanPhiStrip = (*clusterIt1)->getMeanPhiStrip() * (*clusterIt1)->getTotCharge() / totCharge + (*clusterIt2)->getMeanPhiStrip() * (*clusterIt2)->getTotCharge() / totCharge;
-
-	      (*clusterIt2)->setMeanRStrip(meanRStrip);
-	      (*clusterIt2)->setMeanPhiStrip(meanPhiStrip);
-	      (*clusterIt2)->setTotCharge(totCharge);
-	      (*clusterIt2)->setTotChargeErr(totChargeErr);
-	      (*clusterIt2)->setNRawHits(clusterSize);
-	      (*clusterIt2)->setNRawHitsR(clusterSizeR);
-	      (*clusterIt2)->setNRawHitsPhi(clusterSizePhi);
-	      (*clusterIt2)->setIdTruth(idTruth);
-	      (*clusterIt2)->setApv(apv);
-
-	      int distance1 = std::distance(clustersVec[sensorIdx][phiIdx1].begin(), clusterIt1);
-	      clustersVec[sensorIdx][phiIdx1].erase(clusterIt1);
-
-	      if (distance1 == 0)
-		clusterIt1 = clustersVec[sensorIdx][phiIdx1].begin();
-	      else
-		--clusterIt1;
-	    }//end merge
-	  }//end clusters vector 2 loop
-	}//end clusters vector 1 loop
-      }//end phi cluster number cut
+	totCharge      = cluster1->getTotCharge() + cluster2->getTotCharge();
+	totChargeErr   = sqrt((cluster1->getTotChargeErr() * cluster1->getTotChargeErr() * cluster1->getNRawHits() + cluster2->getTotChargeErr() * cluster2->getTotChargeErr() * cluster2->getNRawHits()) / (cluster1->getNRawHits() + cluster2->getNRawHits()));
+	clusterSize    = cluster1->getNRawHits() + cluster2->getNRawHits();
+	int maxClusterR1 = cluster1->getMeanRStrip();
+	int minClusterR1 = cluster1->getMeanRStrip() - cluster1->getNRawHitsR() + 1;
+	int maxClusterR2 = cluster2->getMeanRStrip();
+	int minClusterR2 = cluster2->getMeanRStrip() - cluster2->getNRawHitsR() + 1;
+	int maxClusterR = maxClusterR1 > maxClusterR2 ? maxClusterR1 : maxClusterR2;
+	int minClusterR = minClusterR1 < minClusterR2 ? minClusterR1 : minClusterR2;
+	clusterSizeR   = maxClusterR - minClusterR + 1; // max at 4
+	clusterSizePhi = cluster1->getNRawHitsPhi() + cluster2->getNRawHitsPhi();
+	meanRStrip     = cluster1->getMeanRStrip();
+	if (cluster2->getMeanRStrip() > cluster1->getMeanRStrip())
+	  meanRStrip  = cluster2->getMeanRStrip();
+	meanPhiStrip = cluster1->getMeanPhiStrip() * cluster1->getTotCharge() / totCharge + cluster2->getMeanPhiStrip() * cluster2->getTotCharge() / totCharge;
+
+	cluster2->setMeanRStrip(meanRStrip);
+	cluster2->setMeanPhiStrip(meanPhiStrip);
+	cluster2->setTotCharge(totCharge);
+	cluster2->setTotChargeErr(totChargeErr);
+	cluster2->setNRawHits(clusterSize);
+	cluster2->setNRawHitsR(clusterSizeR);
+	cluster2->setNRawHitsPhi(clusterSizePhi);
+	cluster2->setIdTruth(idTruth);
+	cluster2->setApv(apv);
+
+	delete cluster1;
+	clustersVec[sensorIdx][phiIdx1] = 0;
+      }//end merge
     }//end current sensor cluster loop
   }//end all sensor clustering loop
 
   //fill output container
-  std::vector<StFstCluster *>::iterator clusterIt;
-
   for (int sensorIdx = 0; sensorIdx < kFstNumSensorsPerWedge; sensorIdx++) {
     for (int phiIdx = 0; phiIdx < kFstNumPhiSegPerSensor; phiIdx++) {
-      if (clustersVec[sensorIdx][phiIdx].size() <= 0) continue;
-
-      for (clusterIt = clustersVec[sensorIdx][phiIdx].begin(); clusterIt != clustersVec[sensorIdx][phiIdx].end(); ++clusterIt)
-	clusters.getClusterVec().push_back(*clusterIt);
-
-      rawHitsVec[sensorIdx][phiIdx].clear();
-      clustersVec[sensorIdx][phiIdx].clear();
+      if (clustersVec[sensorIdx][phiIdx])
+	clusters.getClusterVec().push_back(clustersVec[sensorIdx][phiIdx]);
     }
   }
 
@@ -14,12 +14,16 @@ class StFstClusterCollection;
  * in phistrips and then the phistrip-wise proto-clusters are grouped in neighboring
  * phistrips.
  *
- * 1) Reads all raw hits per wedge (three sensors) and groups into vectors
- * (each vector corresponds to a sensor phistrip).
- * 2) Does clustering in individual phistrip.
- * 3) Does clustering in neighboring phistrips.
+ * 1) Sorts the raw hits of a wedge (three sensors) by geometry ID and sums
+ * them per sensor phistrip, in two sweeps over the sorted hits (the first finds
+ * the hit with maximum ADC, which sets the time bin summed in the second).
+ * 2) Makes one cluster per phistrip with a seed hit.
+ * 3) Merges clusters of neighboring phistrips.
  * 4) Fill hit collections.
  *
+ * The raw hits are not copied and the work space is on the stack, so wedges
+ * can be clustered in parallel.
+ *
  * \author Shenghui Zhang \date Sep 2021
  */
 class StFstScanRadiusClusterAlgo : public StFstIClusterAlgo
@@ -28,6 +32,19 @@ class StFstScanRadiusClusterAlgo : public StFstIClusterAlgo
 protected:
    enum {kFstScanRadiusClusterAlgo = 2};
 
+   /// Raw hits of one sensor phistrip, summed in decreasing geometry ID order
+   struct StripSum {
+      int nHits;            ///< number of raw hits
+      int maxAdcHit;        ///< index of the hit with maximum ADC in the raw hit vector
+      float lastCharge;     ///< charge at its max time bin of the last summed hit
+      int maxTb;            ///< max time bin of the hit with maximum ADC
+      int usedTb;           ///< time bin summed
+      int nSeedHits;        ///< number of seed hits
+      float charge;         ///< sum of charge
+      float chargeErrSquare;///< sum of squared charge error
+      float maxRStrip;      ///< largest rstrip
+   };
+
    virtual Int_t doClustering(const StFstCollection &fstCollection, StFstRawHitCollection &rawHits, StFstClusterCollection &clusters );
 };
 
@@ -25,11 +25,12 @@ StFstRawHitMaker::StFstRawHitMaker( const char *name ): StRTSBaseMaker( "fst", n
     mMinHitCut(2.5), mMedHitCut(3.5), mMaxHitCut(4.0),mCmnCut(3.),
     mFstCollectionPtr(new StFstCollection()), mFstCollectionSimuPtr(nullptr),
     mCmnVec(kFstNumApvs, std::vector<std::vector<float>>(kFstNumRStripsPerSensor, std::vector<float>(kFstNumTimeBins, 0))),
-    mPedVec(kFstNumElecIds, std::vector<float>(kFstNumTimeBins, 0)),
-    mTotRmsVec(kFstNumElecIds, std::vector<float>(kFstNumTimeBins, 0)),
-    mRanRmsVec(kFstNumElecIds, std::vector<float>(kFstNumTimeBins, 0)),
+    mPedVec(kFstNumElecIds * kFstNumTimeBins, 0),
+    mTotRmsVec(kFstNumElecIds * kFstNumTimeBins, 0),
+    mRanRmsVec(kFstNumElecIds * kFstNumTimeBins, 0),
     mGainVec(kFstNumElecIds, 0),
     mMappingVec(kFstNumElecIds, 0),
+    mRStripVec(kFstNumElecIds, 0),
     mConfigVec(kFstNumApvs, 1),
     mDataType(0)
 {
@@ -117,19 +118,19 @@ Int_t StFstRawHitMaker::InitRun(Int_t runnumber)
         for (int i = 0; i < kFstNumElecIds; i++) {
             for ( int j = 0; j < kFstNumTimeBins; j++) {
                 LOG_DEBUG << Form(" Print entry %d-%d : pedestal=%f ", i, j, (float)gPN[0].pedestal[i*kFstNumTimeBins+j]) << endm;
-                mPedVec[i][j] = (float)gPN[0].pedestal[i*kFstNumTimeBins+j];
+                mPedVec[i*kFstNumTimeBins+j] = (float)gPN[0].pedestal[i*kFstNumTimeBins+j];
             }
         }
         for (int i = 0; i < kFstNumElecIds; i++) {
             for ( int j = 0; j < kFstNumTimeBins; j++) {
                 LOG_DEBUG << Form(" Print entry %d-%d : RMS noise=%f ", i, j, (float)gPN[0].totNoise[i*kFstNumTimeBins+j] / 100.) << endm;
-                mTotRmsVec[i][j] = (float)gPN[0].totNoise[i*kFstNumTimeBins+j] / 100.;
+                mTotRmsVec[i*kFstNumTimeBins+j] = (float)gPN[0].totNoise[i*kFstNumTimeBins+j] / 100.;
             }
         }
         for (int i = 0; i < kFstNumElecIds; i++) {
              for ( int j = 0; j < kFstNumTimeBins; j++) {
                 LOG_DEBUG << Form(" Print entry %d-%d : RMS noise=%f ", i, j, (float)gPN[0].ranNoise[i*kFstNumTimeBins+j] / 100.) << endm;
-                mRanRmsVec[i][j] = (float)gPN[0].ranNoise[i*kFstNumTimeBins+j] / 100.;
+                mRanRmsVec[i*kFstNumTimeBins+j] = (float)gPN[0].ranNoise[i*kFstNumTimeBins+j] / 100.;
              }
         }
     }
@@ -159,6 +160,7 @@ Int_t StFstRawHitMaker::InitRun(Int_t runnumber)
         for (int i = 0; i < kFstNumElecIds; i++) {
             LOG_DEBUG << Form(" Print entry %d : geoId=%d ", i, gM[0].mapping[i]) << endm;
             mMappingVec[i] = gM[0].mapping[i];
+            mRStripVec[i]  = (mMappingVec[i] % (kFstNumInnerSensorsPerWedge * kFstNumStripsPerInnerSensor + kFstNumOuterSensorsPerWedge * kFstNumStripsPerOuterSensor))/kFstNumPhiSegPerWedge;
         }
     }
 
@@ -275,6 +277,8 @@ Int_t StFstRawHitMaker::Make()
         std::array< std::array<double, kFstNumTimeBins>, kFstNumApvChannels > signalCorrected{};
 	// seed hit flag: non-zs: 0 | zs: >0 & 7 for seed hit
 	std::array< std::array<int, kFstNumTimeBins>, kFstNumApvChannels > seedFlag{};
+        // time bins found in data
+        std::array< std::array<unsigned char, kFstNumTimeBins>, kFstNumApvChannels > isPresent{};
         // id of mc track
         std::array<int, kFstNumApvChannels> idTruth{};
 
@@ -329,6 +333,7 @@ Int_t StFstRawHitMaker::Make()
 
             signalUnCorrected[channel][timebin] = adc;
 	    seedFlag[channel][timebin] = sFlag;
+            isPresent[channel][timebin] = 1;
             if(adc>0) nRawAdcFromData++;
 
             if ( !mIsCaliMode )        {
@@ -357,28 +362,13 @@ Int_t StFstRawHitMaker::Make()
                         }
                     }
                 }
-
-                if ( dataFlag == mADCdata ) { // non-ZS data
-                    signalCorrected[channel][timebin] = signalUnCorrected[channel][timebin] - mPedVec[elecId][timebin];
-
-                    // exclude signal-related channels for common mode noise calculation
-                    if ( (signalCorrected[channel][timebin] > (-mCmnCut)*mTotRmsVec[elecId][timebin]) &&
-                            (signalCorrected[channel][timebin] <   mCmnCut *mTotRmsVec[elecId][timebin]) )
-                    {
-                        Int_t geoId = mMappingVec[elecId];
-                        int rstrip = (geoId % (kFstNumInnerSensorsPerWedge * kFstNumStripsPerInnerSensor + kFstNumOuterSensorsPerWedge * kFstNumStripsPerOuterSensor))/kFstNumPhiSegPerWedge;
-                        sumAdcPerRgroupPerEvent[rstrip][timebin] += signalCorrected[channel][timebin];
-                        counterAdcPerRgroupPerEvent[rstrip][timebin]++;
-                    }
-
-                    LOG_DEBUG << " Corrected = " << signalCorrected[channel][timebin] << endm;
-                }
-                else {      // ZS data
-                    signalCorrected[channel][timebin] = signalUnCorrected[channel][timebin];
-                }
             }
         } // end current APV loops
 
+        // pedestal subtraction and common mode sums over the whole APV block
+        if ( !mIsCaliMode )
+            SubtractPedestalFromAPVData(dataFlag, apvElecId, isPresent, signalUnCorrected, signalCorrected, counterAdcPerRgroupPerEvent, sumAdcPerRgroupPerEvent);
+
 	nIdTruth_Fst += FillRawHitCollectionFromAPVData(dataFlag, ntimebin, counterAdcPerRgroupPerEvent, sumAdcPerRgroupPerEvent, apvElecId, signalUnCorrected, signalCorrected, seedFlag, idTruth);
 
     }//end while
@@ -437,6 +427,50 @@ Int_t StFstRawHitMaker::Make()
 }
 
 
+/**
+ * Pedestal subtraction for the non-ZS data of one APV chip and sums for the
+ * dynamical common mode noise. The 128 channels x time bins block of the chip
+ * is contiguous in the signal arrays and in the calibration tables, so the
+ * subtraction is a single loop over it with no branch; only time bins found in
+ * data are subtracted and used. ZS data are copied as they are.
+ */
+void StFstRawHitMaker::SubtractPedestalFromAPVData(unsigned char dataFlag, int apvElecId,
+        const std::array< std::array<unsigned char, kFstNumTimeBins>, kFstNumApvChannels > &isPresent,
+        const std::array< std::array<double, kFstNumTimeBins>, kFstNumApvChannels > &signalUnCorrected,
+        std::array< std::array<double, kFstNumTimeBins>, kFstNumApvChannels > &signalCorrected,
+        int counterAdcPerRgroupPerEvent[][kFstNumTimeBins], double sumAdcPerRgroupPerEvent[][kFstNumTimeBins])
+{
+    static_assert(sizeof(signalCorrected) == sizeof(double) * kFstNumApvChannels * kFstNumTimeBins, "APV block is not contiguous");
+    const int nBlock = kFstNumApvChannels * kFstNumTimeBins;
+    const unsigned char *present = isPresent[0].data();
+    const double *raw = signalUnCorrected[0].data();
+    double *corrected = signalCorrected[0].data();
+
+    if ( dataFlag != mADCdata ) { // ZS data
+        for (int k = 0; k < nBlock; k++) corrected[k] = raw[k];
+        return;
+    }
+
+    const float *ped = &mPedVec[apvElecId * kFstNumTimeBins];
+    const float *totRms = &mTotRmsVec[apvElecId * kFstNumTimeBins];
+
+    for (int k = 0; k < nBlock; k++)
+        corrected[k] = present[k] ? raw[k] - ped[k] : 0.0;
+
+    // exclude signal-related channels for common mode noise calculation
+    for (int iChan = 0; iChan < kFstNumApvChannels; iChan++) {
+        const int rstrip = mRStripVec[apvElecId + iChan];
+        for (int iTb = 0; iTb < kFstNumTimeBins; iTb++) {
+            const int k = iChan * kFstNumTimeBins + iTb;
+            if ( present[k] && (corrected[k] > (-mCmnCut)*totRms[k]) && (corrected[k] < mCmnCut*totRms[k]) ) {
+                sumAdcPerRgroupPerEvent[rstrip][iTb] += corrected[k];
+                counterAdcPerRgroupPerEvent[rstrip][iTb]++;
+            }
+        }
+    }
+}
+
+
 /**
  * A private helper function to actually insert StFstRawHits unpacked from DAQ
  * records into the final output container mFstCollectionPtr.
@@ -467,20 +501,18 @@ int StFstRawHitMaker::FillRawHitCollectionFromAPVData(unsigned char dataFlag, in
     }
 
     // CMN correction, raw hit decision and channel counter passed the hit decision
-    std::vector<bool> isPassRawHitCut(kFstNumApvChannels, false);
+    bool isPassRawHitCut[kFstNumApvChannels] = {};
     Int_t nChanPassedCut = 0;
 
     for (int iChan = 0; iChan < kFstNumApvChannels; iChan++)
     {
         Int_t elecId = apvElecId + iChan;
-        Int_t geoId  = mMappingVec[elecId];
+        const float *ranRms = &mRanRmsVec[elecId * kFstNumTimeBins];
         // Modify signalCorrected values in some ways
-        for (int iTBin = 0; iTBin < ntimebin; iTBin++)
-        {
-            if (!mIsCaliMode && mDoCmnCorrection && dataFlag == mADCdata ){
-                int rstrip = (geoId % (kFstNumInnerSensorsPerWedge * kFstNumStripsPerInnerSensor + kFstNumOuterSensorsPerWedge * kFstNumStripsPerOuterSensor))/kFstNumPhiSegPerWedge;
-                signalCorrected[iChan][iTBin] -= commonModeNoise[rstrip][iTBin];
-            }
+        if (!mIsCaliMode && mDoCmnCorrection && dataFlag == mADCdata ){
+            const double *cmn = commonModeNoise[mRStripVec[elecId]];
+            for (int iTBin = 0; iTBin < ntimebin; iTBin++)
+                signalCorrected[iChan][iTBin] -= cmn[iTBin];
         }
 
 	for (int iTB = 0; iTB < ntimebin; iTB++)
@@ -488,9 +520,9 @@ int StFstRawHitMaker::FillRawHitCollectionFromAPVData(unsigned char dataFlag, in
 	    // raw hit decision for non-zs
 	    if ( (dataFlag == mADCdata) && (signalUnCorrected[iChan][iTB] > 0) &&
 		    (signalUnCorrected[iChan][iTB] < kFstMaxAdc) &&
-		    ((signalCorrected[iChan][iTB]     > mMedHitCut * mRanRmsVec[elecId][iTB])||
-		     (iTB >0 && (signalCorrected[iChan][iTB-1]     > mMinHitCut * mRanRmsVec[elecId][iTB]) &&
-		      (signalCorrected[iChan][iTB]     > mMinHitCut * mRanRmsVec[elecId][iTB]))))
+		    ((signalCorrected[iChan][iTB]     > mMedHitCut * ranRms[iTB])||
+		     (iTB >0 && (signalCorrected[iChan][iTB-1]     > mMinHitCut * ranRms[iTB]) &&
+		      (signalCorrected[iChan][iTB]     > mMinHitCut * ranRms[iTB]))))
 	    {
 		isPassRawHitCut[iChan] = kTRUE;
 		nChanPassedCut++;
@@ -548,9 +580,10 @@ int StFstRawHitMaker::FillRawHitCollectionFromAPVData(unsigned char dataFlag, in
             }
 
             //skip current channel marked as suspicious status
-            if (mRanRmsVec[elecId][mDefaultTimeBin] < mChanMinRmsNoiseLevel ||
-                    mRanRmsVec[elecId][mDefaultTimeBin] > mChanMaxRmsNoiseLevel ||
-                    mRanRmsVec[elecId][mDefaultTimeBin] > 99.0)
+            const float *ranRms = &mRanRmsVec[elecId * kFstNumTimeBins];
+            if (ranRms[mDefaultTimeBin] < mChanMinRmsNoiseLevel ||
+                    ranRms[mDefaultTimeBin] > mChanMaxRmsNoiseLevel ||
+                    ranRms[mDefaultTimeBin] > 99.0)
             {
                 LOG_DEBUG << "Skip: Noisy/hot/dead channel electronics index: " << elecId << endm;
                 continue;
@@ -570,7 +603,7 @@ int StFstRawHitMaker::FillRawHitCollectionFromAPVData(unsigned char dataFlag, in
                 if (signalCorrected[iChan][iTBin] < 0)
                     signalCorrected[iChan][iTBin] = 0.1;
 
-                rawHitPtr->setChargeErr(mRanRmsVec[elecId][iTBin] * mGainVec[elecId], (unsigned char)iTBin);
+                rawHitPtr->setChargeErr(ranRms[iTBin] * mGainVec[elecId], (unsigned char)iTBin);
 
                 if (signalCorrected[iChan][iTBin] > tempMaxCharge) {
                     tempMaxCharge = signalCorrected[iChan][iTBin];
@@ -579,8 +612,8 @@ int StFstRawHitMaker::FillRawHitCollectionFromAPVData(unsigned char dataFlag, in
 
                 signalCorrected[iChan][iTBin] *= mGainVec[elecId];
 		if( (dataFlag == mADCdata) && (iTBin >0) && 
-			(signalCorrected[iChan][iTBin-1] > mMaxHitCut * mRanRmsVec[elecId][iTBin-1]) &&
-			(signalCorrected[iChan][iTBin] > mMaxHitCut * mRanRmsVec[elecId][iTBin]))
+			(signalCorrected[iChan][iTBin-1] > mMaxHitCut * ranRms[iTBin-1]) &&
+			(signalCorrected[iChan][iTBin] > mMaxHitCut * ranRms[iTBin]))
 		{
 		    seedhitflag = 1;
 		}
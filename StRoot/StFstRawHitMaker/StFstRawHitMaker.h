@@ -69,15 +69,22 @@ protected:
    StFstCollection *mFstCollectionSimuPtr;
 
    std::vector< std::vector< std::vector< float > > > mCmnVec;   ///< APV chip geom. index, common mode (CM) noise
-   std::vector< std::vector< float > > mPedVec;   ///< Channel elec. index, pedestal
-   std::vector< std::vector< float > > mTotRmsVec;   ///< Channel elec. index, Total RMS noise
-   std::vector< std::vector< float > > mRanRmsVec;   ///< Channel elec. index, Random RMS noise
+   std::vector< float > mPedVec;      ///< Channel elec. index * kFstNumTimeBins + time bin, pedestal
+   std::vector< float > mTotRmsVec;   ///< Channel elec. index * kFstNumTimeBins + time bin, Total RMS noise
+   std::vector< float > mRanRmsVec;   ///< Channel elec. index * kFstNumTimeBins + time bin, Random RMS noise
    std::vector< float > mGainVec;  ///< Channel elec. index, gain
    std::vector< int > mMappingVec; ///< Channel elec. index to geometry ID mapping
+   std::vector< int > mRStripVec;  ///< Channel elec. index to R-strip in the wedge (common mode group)
    std::vector< int > mConfigVec; ///< APV chip configuration status indexed by geom. id
 
 private:
 
+   void SubtractPedestalFromAPVData(unsigned char dataFlag, int apvElecId,
+      const std::array< std::array<unsigned char, kFstNumTimeBins>, kFstNumApvChannels > &isPresent,
+      const std::array< std::array<double, kFstNumTimeBins>, kFstNumApvChannels > &signalUnCorrected,
+      std::array< std::array<double, kFstNumTimeBins>, kFstNumApvChannels > &signalCorrected,
+      int counterAdcPerEvent[][kFstNumTimeBins], double sumAdcPerEvent[][kFstNumTimeBins]);
+
    int FillRawHitCollectionFromAPVData(unsigned char dataFlag, int ntimebin, int counterAdcPerEvent[][kFstNumTimeBins], double sumAdcPerEvent[][kFstNumTimeBins], int apvElecId,
       std::array< std::array<double, kFstNumTimeBins>, kFstNumApvChannels > &signalUnCorrected,
       std::array< std::array<double, kFstNumTimeBins>, kFstNumApvChannels > &signalCorrected,
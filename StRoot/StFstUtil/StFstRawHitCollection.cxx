@@ -14,6 +14,7 @@ StFstRawHitCollection::StFstRawHitCollection( int wedge ) : StObject(), mWedge(w
 StFstRawHitCollection::~StFstRawHitCollection()
 {
    while (!mRawHitVec.empty()) delete mRawHitVec.back(), mRawHitVec.pop_back();
+   while (!mRawHitPool.empty()) delete mRawHitPool.back(), mRawHitPool.pop_back();
 
    mRawHitElecIdVec.clear();
 };
@@ -54,9 +55,11 @@ unsigned char StFstRawHitCollection::getWedge() const
    return mWedge;
 };
 
+/** Raw hits are kept in a pool and reused by getRawHit() in the next event */
 void StFstRawHitCollection::Clear( Option_t *opt )
 {
-   while (!mRawHitVec.empty()) delete mRawHitVec.back(), mRawHitVec.pop_back();
+   mRawHitPool.insert(mRawHitPool.end(), mRawHitVec.begin(), mRawHitVec.end());
+   mRawHitVec.clear();
 
    //clear the vector for alternate lookups
    for (unsigned int i = 0; i < mRawHitElecIdVec.size(); i++)
@@ -117,7 +120,14 @@ StFstRawHit *StFstRawHitCollection::getRawHit( int elecId )
    StFstRawHit *&rawHitPtr = mRawHitElecIdVec[elecId];
 
    if ( !rawHitPtr ) {
-      rawHitPtr = new StFstRawHit();
+      if ( mRawHitPool.empty() ) {
+         rawHitPtr = new StFstRawHit();
+      }
+      else {
+         rawHitPtr = mRawHitPool.back();
+         mRawHitPool.pop_back();
+         *rawHitPtr = StFstRawHit();
+      }
       mRawHitVec.push_back( rawHitPtr );
    }
 
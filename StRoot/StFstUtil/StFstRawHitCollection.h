@@ -57,6 +57,8 @@ protected:
    //temporary copy of the pointers to add raw hit indexed by elec Id.
    std::vector<StFstRawHit *> mRawHitElecIdVec;
 
+   std::vector<StFstRawHit *> mRawHitPool; //! hits kept by Clear() for reuse by getRawHit()
+
 private:
    ClassDef(StFstRawHitCollection, 1);
 };
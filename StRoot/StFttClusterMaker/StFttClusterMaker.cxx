@@ -29,6 +29,13 @@
 
 #include "StFttDbMaker/StFttDb.h"
 
+namespace {
+    // orientations that are clustered (kFttHorizontal, kFttVertical, kFttDiagonalH, kFttDiagonalV)
+    const size_t kNOrientations      = 4;
+    const size_t kSlotsPerRow        = StFttDb::maxStripPerRow;
+    const size_t kSlotsPerProjection = StFttDb::nRowsPerQuad * kSlotsPerRow;
+    const size_t kNSlots             = StFttDb::nRob * kNOrientations * kSlotsPerProjection;
+}
 
 //_____________________________________________________________
 StFttClusterMaker::StFttClusterMaker( const char* name )
@@ -111,70 +118,27 @@ StFttClusterMaker::Make()
     // next we need to sort the hits into 1D projections
     // process 1 quadrant (ROB) at a time,
     // process horizontal, vertical or diagonal strips one at a time
-
-    // key == ROB
-    std::map< UChar_t, std::vector<StFttRawHit *> > hStripsPerRob; // Horizontal
-    std::map< UChar_t, std::vector<StFttRawHit *> > vStripsPerRob; // Vertical
-    std::map< UChar_t, std::vector<StFttRawHit *> > dhStripsPerRob; // Diagonal on Horizontal
-    std::map< UChar_t, std::vector<StFttRawHit *> > dvStripsPerRob; // Diagonal on Vertical
-
-    size_t nStripsHit = 0;
-    for ( StFttRawHit* hit : mFttCollection->rawHits() ) {
-        UChar_t rob = mFttDb->rob( hit );
-        UChar_t so = mFttDb->orientation( hit );
-
-        // Apply the time cut
-        if ( !PassTimeCut( hit ) ) continue;
-
-        if ( kFttHorizontal == so ){
-            hStripsPerRob[ rob ].push_back(hit);
-            nStripsHit++;
-        }
-        if ( kFttVertical   == so ){
-            vStripsPerRob[ rob ].push_back(hit);
-            nStripsHit++;
-        }
-        if ( kFttDiagonalH   == so ){
-            dhStripsPerRob[ rob ].push_back(hit);
-            nStripsHit++;
-        }
-        if ( kFttDiagonalV   == so ){
-            dvStripsPerRob[ rob ].push_back(hit);
-            nStripsHit++;
-        }
-    } // loop on hit
+    FillStripArrays();
 
     size_t nClusters = 0;
-    LOG_DEBUG << "StFttClusterMaker::Make{ nStripsHit = " << nStripsHit << " }" << endm;
-    if ( nStripsHit > 0 ){ // could make more strict?
-        for ( UChar_t iRob = 1; iRob < StFttDb::nRob+1; iRob++ ){
-
-            auto hClusters = FindClusters( hStripsPerRob[iRob] );
-            // Add them to StEvent  
-            for ( StFttCluster * clu : hClusters ){
-                mFttCollection->addCluster( clu );
-                nClusters++;
-            }
-            auto vClusters = FindClusters( vStripsPerRob[iRob] );
-            // Add them to StEvent  
-            for ( StFttCluster * clu : vClusters ){
-                mFttCollection->addCluster( clu );
-                nClusters++;
-            }
-            auto hdClusters = FindClusters( dhStripsPerRob[iRob] );
-            // Add them to StEvent  
-            for ( StFttCluster * clu : hdClusters ){
-                mFttCollection->addCluster( clu );
-                nClusters++;
-            }
-            auto vdClusters = FindClusters( dvStripsPerRob[iRob] );
-            // Add them to StEvent  
-            for ( StFttCluster * clu : vdClusters ){
-                mFttCollection->addCluster( clu );
-                nClusters++;
-            }
-        } // loop on iRob
-    } // nStripsHit
+    LOG_DEBUG << "StFttClusterMaker::Make{ nStripsHit = " << mHits.size() << " }" << endm;
+
+    // the occupied slots of one projection (ROB and orientation) are contiguous in mOccupied
+    size_t first = 0;
+    while ( first < mOccupied.size() ){
+        const size_t projection = mOccupied[first] / kSlotsPerProjection;
+        size_t last = first;
+        while ( last < mOccupied.size() && mOccupied[last] / kSlotsPerProjection == projection )
+            last++;
+
+        auto clusters = FindClusters( first, last );
+        // Add them to StEvent
+        for ( StFttCluster * clu : clusters ){
+            mFttCollection->addCluster( clu );
+            nClusters++;
+        }
+        first = last;
+    } // loop on projections
     LOG_DEBUG << "Found " << nClusters << " clusters this event" << endm;
 
     return kStOk;
@@ -223,92 +187,106 @@ bool StFttClusterMaker::PassTimeCut( StFttRawHit * hit ){
 }
 
 
-StFttRawHit * StFttClusterMaker::FindMaxAdc( std::vector<StFttRawHit *> hits, size_t &pos ){
-    auto itMax = std::max_element(hits.begin(),
-                             hits.end(),
-                             [](const StFttRawHit* a,const StFttRawHit* b) { return a->adc() < b->adc(); });
+void StFttClusterMaker::FillStripArrays(){
+    if ( mStripHit.size() != kNSlots ){
+        mStripHit.assign( kNSlots, -1 );
+        mStripAdc.assign( kNSlots, 0 );
+        mStripUsed.assign( kNSlots, 0 );
+    }
 
-    pos = (itMax - hits.begin());
-    if ( itMax == hits.end() ) return nullptr;
-    return *itMax;
-}
+    // only the slots filled in the last event need to be reset
+    for ( size_t slot : mOccupied ){
+        mStripHit[slot]  = -1;
+        mStripAdc[slot]  = 0;
+        mStripUsed[slot] = 0;
+    }
+    mOccupied.clear();
+    mHits.clear();
+    mNextHit.clear();
+
+    for ( StFttRawHit* hit : mFttCollection->rawHits() ) {
+        UChar_t rob = mFttDb->rob( hit );
+        UChar_t so = mFttDb->orientation( hit );
 
-void StFttClusterMaker::SearchClusterEdges( std::vector< StFttRawHit * > hits, 
-                                            size_t start, // start index at MaxADC
+        // Apply the time cut
+        if ( !PassTimeCut( hit ) ) continue;
+
+        if ( rob < 1 || rob > StFttDb::nRob || so >= kNOrientations ) continue;
+        if ( hit->row() >= StFttDb::nRowsPerQuad || hit->strip() >= StFttDb::maxStripPerRow ){
+            LOG_WARN << "Ftt hit outside of the strip map (row = " << (int)hit->row() << ", strip = " << (int)hit->strip() << ")" << endm;
+            continue;
+        }
+
+        const size_t slot = ( ( (rob - 1) * kNOrientations + so ) * StFttDb::nRowsPerQuad + hit->row() ) * kSlotsPerRow + hit->strip();
+        const int iHit = mHits.size();
+        mHits.push_back( hit );
+        mNextHit.push_back( -1 );
+
+        // the max ADC hit on the strip heads the list of hits on the strip
+        const int head = mStripHit[slot];
+        if ( head < 0 ){
+            mStripHit[slot] = iHit;
+            mOccupied.push_back( slot );
+        } else if ( hit->adc() > mHits[head]->adc() ){
+            mNextHit[iHit] = head;
+            mStripHit[slot] = iHit;
+        } else {
+            mNextHit[iHit] = mNextHit[head];
+            mNextHit[head] = iHit;
+        }
+        mStripAdc[slot] += hit->adc();
+    } // loop on hit
+
+    std::sort( mOccupied.begin(), mOccupied.end() );
+} // FillStripArrays
+
+void StFttClusterMaker::SearchClusterEdges( size_t start, // slot of the max ADC strip
+                                            size_t rowBegin, size_t rowEnd, // slots of the row
                                             size_t &left, size_t &right ){
     // set initial values
     left     = start;
     right    = start;
 
-    auto lastHitLeft  = hits[start];
-    auto lastHitRight = hits[start];
-
-    bool searchRight = true;
-    bool searchLeft = true;
-
-    StFttRawHit *hitLeft = nullptr, *hitRight = nullptr;
-
-    while ( searchRight || searchLeft ){
-            LOG_DEBUG << "LEFT: " << left << ", RIGHT: " << right <<  ", start = " << start << ", size=" << hits.size() << endm;
-        if ( searchRight ){
-            if ( right == hits.size() || right == hits.size() - 1 ){ 
-                searchRight = false;
-            }
-            else {
-                
-                hitRight = hits[right+1];
-                if ( hitRight->adc() > lastHitRight->adc() || hitRight->adc() < GetThresholdFor( hitRight ) ){
-                    searchRight = false;
-                }
-                if ( hitRight->row() != lastHitRight->row() || abs( hitRight->strip() - lastHitRight->strip() ) > 1 ){
-                    searchRight = false;
-                }
-
-                if ( searchRight ){
-                    right ++;
-                    lastHitRight = hitRight;
-                }
-            } // right < size - 1
-        } // searchRight
-
-        if ( searchLeft ){
-            if ( left == 0 ){
-                searchLeft = false;
-            } else {
-                hitLeft = hits[left-1];
-                if ( hitLeft->adc() > lastHitLeft->adc() || hitLeft->adc() < GetThresholdFor( hitLeft ) ){
-                    searchLeft = false;
-                }
-                if ( hitLeft->row() != lastHitLeft->row() || abs( hitLeft->strip() - lastHitLeft->strip() ) > 1 ){
-                    searchLeft = false;
-                }
-
-                if (searchLeft){
-                    left--;
-                    lastHitLeft = hitLeft;
-                }
-            } // left != 0
-        } // searchLeft
-    } // while searching
+    // grow while the neighbouring strip is hit, not yet used and its ADC does not rise
+    while ( right + 1 < rowEnd ){
+        const int h = mStripHit[right + 1];
+        if ( h < 0 || mStripUsed[right + 1] ) break;
+        StFttRawHit *hitRight = mHits[h];
+        if ( hitRight->adc() > mHits[ mStripHit[right] ]->adc() || hitRight->adc() < GetThresholdFor( hitRight ) ) break;
+        right++;
+    }
+
+    while ( left > rowBegin ){
+        const int h = mStripHit[left - 1];
+        if ( h < 0 || mStripUsed[left - 1] ) break;
+        StFttRawHit *hitLeft = mHits[h];
+        if ( hitLeft->adc() > mHits[ mStripHit[left] ]->adc() || hitLeft->adc() < GetThresholdFor( hitLeft ) ) break;
+        left--;
+    }
+    LOG_DEBUG << "LEFT: " << left << ", RIGHT: " << right <<  ", start = " << start << endm;
 } // SearchClusterEdges
 
 
-void StFttClusterMaker::CalculateClusterInfo( StFttCluster * clu ){
+void StFttClusterMaker::CalculateClusterInfo( StFttCluster * clu, size_t left, size_t right ){
 
     clu->setNStrips( clu->rawHits().size() );
 
     // Compute the sumAdc, strip gravity center, and variance
+    // from the summed ADC of the contiguous strips left..right
     float m0Sum = 0;
     float m1Sum = 0;
     float m2Sum = 0;
 
-    std::for_each (clu->rawHits().begin(), clu->rawHits().end(), [&](const StFttRawHit *h) {
-        float x = ( h->strip() * 3.2 - 1.6 ); // replace with CONST
-        
-        m0Sum += h->adc();
-        m1Sum += (h->adc() * x); 
-        m2Sum += ( h->adc() * x * x );
-    });
+    const float *adc = &mStripAdc[left];
+    const size_t n = right - left + 1;
+    const float pitch = StFttDb::stripPitch;
+    const float x0 = ( left % kSlotsPerRow ) * pitch - 0.5 * pitch;
+    for ( size_t i = 0; i < n; i++ ){
+        const float x = x0 + i * pitch;
+        m0Sum += adc[i];
+        m1Sum += adc[i] * x;
+        m2Sum += adc[i] * x * x;
+    }
 
     if ( mDebug ) {
         LOG_INFO << "m0Sum = " << m0Sum << endm; 
@@ -328,62 +306,41 @@ void StFttClusterMaker::CalculateClusterInfo( StFttCluster * clu ){
 
 
 
-std::vector<StFttCluster*> StFttClusterMaker::FindClusters( std::vector< StFttRawHit * > hits ){
+std::vector<StFttCluster*> StFttClusterMaker::FindClusters( size_t first, size_t last ){
     std::vector<StFttCluster*> clusters;
 
-    /* early data (i.e. cosmic data pre dec 10 2021)
-     * had duplicates where the hits are identical except 
-     * a different tb. Tonko fixed at some point
-     * So this could be wrapped in a run range block, but
-     * does no harm.
+    /* Each cluster grows from its max ADC strip, as long as the ADC does
+     * not rise, and the strips are taken in order of decreasing ADC. Only a
+     * strip with no hit neighbour of higher ADC can start a cluster, so
+     * those are collected in one sweep and sorted, instead of searching the
+     * max ADC hit of the remaining hits for every cluster.
+     * Ties go to the lower strip, as in the search over hits sorted by row and strip.
      */
-    const bool dedup = false;
-    if ( dedup ){
-        auto cmp = [](StFttRawHit* a, StFttRawHit* b) { 
-            
-            return  a->plane() < b->plane() ||
-                    a->quadrant() < b->quadrant() ||
-                    a->row() < b->row() ||
-                    a->strip() < b->strip() ||
-                    a->orientation() < b->orientation(); 
-        };
-    
-        // NOTE according to SO this is faster than using ctor
-        set<StFttRawHit*, decltype(cmp)> s(cmp);
-        unsigned size = hits.size();
-        for( auto h : hits ) s.insert( h );
-        hits.assign( s.begin(), s.end() );
+    std::vector<size_t> seeds;
+    for ( size_t k = first; k < last; k++ ){
+        const size_t slot = mOccupied[k];
+        const size_t strip = slot % kSlotsPerRow;
+        const UShort_t adc = mHits[ mStripHit[slot] ]->adc();
+        if ( strip > 0 && mStripHit[slot - 1] >= 0 && mHits[ mStripHit[slot - 1] ]->adc() > adc ) continue;
+        if ( strip + 1 < kSlotsPerRow && mStripHit[slot + 1] >= 0 && mHits[ mStripHit[slot + 1] ]->adc() > adc ) continue;
+        seeds.push_back( slot );
     }
-
-    // Sort the hits by row and strip
-    sort(hits.begin(), hits.end(), [](const StFttRawHit * a, const StFttRawHit * b) -> bool { 
-            size_t indexA = a->orientation() + StFttDb::nStripOrientations * ( a->strip() + a->row() * StFttDb::maxStripPerRow);
-            size_t indexB = b->orientation() + StFttDb::nStripOrientations * ( b->strip() + b->row() * StFttDb::maxStripPerRow);
-            return indexA < indexB; 
-        });
+    std::sort( seeds.begin(), seeds.end(), [&]( size_t a, size_t b ) {
+        const UShort_t adcA = mHits[ mStripHit[a] ]->adc();
+        const UShort_t adcB = mHits[ mStripHit[b] ]->adc();
+        return adcA > adcB || ( adcA == adcB && a < b );
+    });
 
     if ( mDebug ) {
-        LOG_INFO << "We have " << hits.size() << " hits after removing duplicates" << endm;
+        LOG_INFO << "We have " << ( last - first ) << " strips hit and " << seeds.size() << " cluster seeds" << endm;
     }
 
+    for ( size_t anchor : seeds ){
+        if ( mStripUsed[anchor] ) continue;
 
-    // Get the max ADC hit in this projection
-    size_t anchor  = hits.size()+1;
-    auto maxAdcHit = FindMaxAdc( hits, anchor );
-
-    // Loop as long as there is at least 1 hit left
-    while ( maxAdcHit ){
+        StFttRawHit * maxAdcHit = mHits[ mStripHit[anchor] ];
         StFttCluster * clu = new StFttCluster();
 
-        if ( Debug() ){
-            LOG_DEBUG << "CLUSTER FIND START WITH HITS:" << endm;
-            size_t i = 0;
-            for ( auto *h : hits ){
-                LOG_DEBUG << "[" << i << "]" << *h;
-                i++;
-            }
-        }
-
         // Set cluster "location" from max ADC hit
         clu->setPlane       ( maxAdcHit->plane       ( ) );
         clu->setQuadrant    ( maxAdcHit->quadrant    ( ) );
@@ -391,29 +348,27 @@ std::vector<StFttCluster*> StFttClusterMaker::FindClusters( std::vector< StFttRa
         clu->setOrientation ( maxAdcHit->orientation ( ) );
 
         // Now find the cluster edges
+        const size_t rowBegin = anchor - anchor % kSlotsPerRow;
         size_t left = anchor, right = anchor;
-        SearchClusterEdges( hits, anchor, left, right);
-        
+        SearchClusterEdges( anchor, rowBegin, rowBegin + kSlotsPerRow, left, right );
+
         LOG_DEBUG << "Cluster points ( " << left << ", " << anchor << ", " << right << " )" << endm;
-        
-        
-        // OK now add these hits to the cluster
+
+        // OK now add these hits to the cluster and mark the strips as used
         for ( size_t i = left; i < right + 1; i++ ){
-            clu->addRawHit( hits[i] );
+            for ( int h = mStripHit[i]; h >= 0; h = mNextHit[h] )
+                clu->addRawHit( mHits[h] );
+            mStripUsed[i] = 1;
         }
 
         // Compute cluster information from the added hits
-        CalculateClusterInfo( clu );
+        CalculateClusterInfo( clu, left, right );
 
         if (mDebug){
             LOG_INFO << *clu << endm;;
         }
         clusters.push_back( clu );
-
-        // Now erase all hits from this cluster so that we can move on to find the next one
-        hits.erase( hits.begin() + left, hits.begin() + right + 1 );
-        maxAdcHit = FindMaxAdc( hits, anchor );
-    } // while maxAdcHit
+    } // loop on seeds
     return clusters;
 }
 
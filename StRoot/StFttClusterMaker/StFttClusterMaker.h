@@ -32,19 +32,29 @@ public:
 
 private:
     void ApplyHardwareMap();
-    std::vector<StFttCluster*> FindClusters( std::vector<StFttRawHit * > );
-    StFttRawHit * FindMaxAdc( std::vector<StFttRawHit *>, size_t &pos );
+    void FillStripArrays();
+    std::vector<StFttCluster*> FindClusters( size_t first, size_t last );
 
     void InjectTestData();
-    void SearchClusterEdges( std::vector< StFttRawHit * > hits, 
-                                            size_t start, // start index at MaxADC
-                                            size_t &left, size_t &right);
-    void CalculateClusterInfo( StFttCluster * clu );
+    void SearchClusterEdges( size_t start, // slot of the max ADC strip
+                             size_t rowBegin, size_t rowEnd, // slots of the row
+                             size_t &left, size_t &right );
+    void CalculateClusterInfo( StFttCluster * clu, size_t left, size_t right );
 
     // selection of raw hits for cluster building
     float GetThresholdFor( StFttRawHit * hit ) { return 0.0;}
     bool PassTimeCut( StFttRawHit * hit );
 
+    // Dense strip arrays, one slot per ROB, orientation, row and strip
+    // slot = ( ( (rob-1) * nOrientations + orientation ) * nRowsPerQuad + row ) * maxStripPerRow + strip
+    // so that the occupied slots sorted are in the order ROB, orientation, row, strip
+    std::vector<int>     mStripHit;     // index in mHits of the max ADC hit on the strip, -1 if none
+    std::vector<float>   mStripAdc;     // summed ADC of the hits on the strip
+    std::vector<UChar_t> mStripUsed;    // strip is already in a cluster
+    std::vector<size_t>  mOccupied;     // occupied slots of this event
+    std::vector<StFttRawHit*> mHits;    // hits passing the time cut
+    std::vector<int>     mNextHit;      // next hit on the same strip, -1 if none
+
     StEvent*             mEvent;
     StFttCollection*     mFttCollection;
     int                  mRunYear;
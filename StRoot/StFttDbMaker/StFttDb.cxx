@@ -127,11 +127,46 @@ void StFttDb::loadDataWindowsFromDb( St_fttDataWindows * dataset ) {
             }
             // sample output of first member variable
         }
+        buildWindowTable();
     } else {
         std::cout << "ERROR: dataset does not contain requested table" << std::endl;
     }
 }
 
+void StFttDb::buildChannelTable() {
+    FttChannelEntry none;
+    none.row = kNoChannel;
+    none.strip = 0;
+    none.orientation[0] = none.orientation[1] = kFttUnknownOrientation;
+    mChannelTable.assign( nChannelKeys, none );
+
+    for ( const auto &kv : mMap ){
+        if ( kv.first >= nChannelKeys ) continue;
+        int feb, vmm, ch, row, strip;
+        unpackKey( kv.first, feb, vmm, ch );
+        unpackVal( kv.second, row, strip );
+        FttChannelEntry &e = mChannelTable[ kv.first ];
+        e.row = row;
+        e.strip = strip;
+        // the orientation only depends on the parity of the rob
+        e.orientation[0] = getOrientation( 2, feb, vmm, row );
+        e.orientation[1] = getOrientation( 1, feb, vmm, row );
+    }
+}
+
+void StFttDb::buildWindowTable() {
+    FttDataWindow none;
+    none.uuid = 0;
+    none.mode = kNoWindow;
+    none.min = none.max = none.anchor = 0;
+    mWindowTable.assign( nPlane * nQuadPerPlane * nRowsPerQuad * nStripOrientations, none );
+
+    for ( const auto &kv : dwMap ){
+        if ( kv.first < mWindowTable.size() )
+            mWindowTable[ kv.first ] = kv.second;
+    }
+}
+
 void StFttDb::loadDataWindowsFromFile( std::string fn ) {
 
 
@@ -158,6 +193,7 @@ void StFttDb::loadHardwareMapFromDb( St_fttHardwareMap * dataset ) {
             }
             // sample output of first member variable
         }
+        buildChannelTable();
     } else {
         std::cout << "ERROR: dataset does not contain requested table" << std::endl;
     }
@@ -207,6 +243,7 @@ void StFttDb::loadHardwareMapFromFile( std::string fn ){
         }
     }
     inf.close();
+    buildChannelTable();
 }
 
 // same for all planes
@@ -270,31 +307,27 @@ UChar_t StFttDb::getOrientation( int rob, int feb, int vmm, int row ) const {
  */
 bool StFttDb::hardwareMap( int rob, int feb, int vmm, int ch, int &row, int &strip, UChar_t &orientation ) const{
     uint16_t key = packKey( feb, vmm, ch );
-    if ( mMap.count( key ) ){
-        uint16_t val = mMap.at( key );
-        unpackVal( val, row, strip );
-        orientation = getOrientation( rob, feb, vmm, row );
-        return true;
-    }
-    return false;
+    if ( key >= mChannelTable.size() || mChannelTable[ key ].row == kNoChannel )
+        return false;
+    const FttChannelEntry &e = mChannelTable[ key ];
+    row = e.row;
+    strip = e.strip;
+    orientation = e.orientation[ rob & 1 ];
+    return true;
 }
 
 bool StFttDb::hardwareMap( StFttRawHit * hit ) const{
     uint16_t key = packKey( hit->feb()+1, hit->vmm()+1, hit->channel() );
-    if ( mMap.count( key ) ){
-        uint16_t val = mMap.at( key );
-        int row=-1, strip=-1;
-        unpackVal( val, row, strip );
-        
-        u_char iPlane = hit->sector() - 1;
-        u_char iQuad = hit->rdo() - 1;
-        int rob = iQuad + ( iPlane *nQuadPerPlane ) + 1;
+    if ( key >= mChannelTable.size() || mChannelTable[ key ].row == kNoChannel )
+        return false;
+    const FttChannelEntry &e = mChannelTable[ key ];
 
-        UChar_t orientation = getOrientation( rob, hit->feb()+1, hit->vmm()+1, row );
-        hit->setMapping( iPlane, iQuad, row, strip, orientation );
-        return true;
-    }
-    return false;
+    u_char iPlane = hit->sector() - 1;
+    u_char iQuad = hit->rdo() - 1;
+    int rob = iQuad + ( iPlane *nQuadPerPlane ) + 1;
+
+    hit->setMapping( iPlane, iQuad, e.row, e.strip, e.orientation[ rob & 1 ] );
+    return true;
 }
 
 
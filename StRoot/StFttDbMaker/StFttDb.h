@@ -15,6 +15,7 @@
 #include "StEvent/StEnumerations.h"
 #include <stdint.h>
 #include <map>
+#include <vector>
 
 
 class StFttRawHit;
@@ -135,10 +136,10 @@ public:
 
         // load calibrated data windows from DB 
         size_t hit_uuid = uuid( hit );
-        if ( dwMap.count( hit_uuid ) ){
-            mode = dwMap[ hit_uuid ].mode;
-            l = dwMap[ hit_uuid ].min;
-            h = dwMap[ hit_uuid ].max;
+        if ( hit_uuid < mWindowTable.size() && mWindowTable[ hit_uuid ].mode != kNoWindow ){
+            mode = mWindowTable[ hit_uuid ].mode;
+            l = mWindowTable[ hit_uuid ].min;
+            h = mWindowTable[ hit_uuid ].max;
         }
     
     }
@@ -157,6 +158,22 @@ public:
 
     std :: map< uint16_t , FttDataWindow > dwMap;
 
+    // Flat tables built from mMap and dwMap when they are loaded, used for the per hit lookups
+    // channel table, indexed by packKey( feb, vmm, ch ); row == kNoChannel if the channel is not mapped
+    struct FttChannelEntry {
+        UChar_t row;
+        UChar_t strip;
+        UChar_t orientation[2]; // for even and odd rob
+    };
+    static const size_t nChannelKeys = 1 << 13; // feb, vmm: 3 bits, ch: 7 bits
+    static const UChar_t kNoChannel = 0xFF;
+    static const UChar_t kNoWindow = 0xFF;
+    std :: vector< FttChannelEntry > mChannelTable; //!
+    // data window table, indexed by uuid( hit ); mode == kNoWindow if there is no window
+    std :: vector< FttDataWindow > mWindowTable; //!
+    void buildChannelTable();
+    void buildWindowTable();
+
   ClassDef(StFttDb,1)   //StAF chain virtual base class for Makers        
 };
 
@@ -34,9 +34,11 @@ StFttPointMaker::StFttPointMaker( const char* name )
   mEvent( 0 ),          /// pointer to StEvent
   mDebug( false ),       /// print out of all full messages for debugging
   mUseTestData( false ),
-  mFttDb( nullptr )
+  mFttDb( nullptr ),
+  mRowMargin( 0 )
 {
     LOG_DEBUG << "StFttPointMaker::ctor"  << endm;
+    SetAttr( "rowMargin", 6.4 );            // mm, two strips
 }
 
 //_____________________________________________________________
@@ -47,6 +49,7 @@ StFttPointMaker::~StFttPointMaker()
 Int_t
 StFttPointMaker::Init()
 {
+    mRowMargin = DAttr( "rowMargin" );
     return kStOk;
 }
 
@@ -109,35 +112,71 @@ void StFttPointMaker::InjectTestData(){
 }
 
 void StFttPointMaker::MakeLocalPoints(){
-    // next we will need them in even more detail
-    // per strip group, but start here
-    // key, dir, value is cluster
-    // std::map< UChar_t, std::vector<StFttCluster *> > clustersPerRob[4][StFttDb::nRowsPerQuad];
+    // clusters per ROB (StFttDb::rob of a cluster is 0 - 15), row and orientation
     std::vector< StFttCluster *> clusters[StFttDb::nRob][StFttDb::nRowsPerQuad][StFttDb::nStripOrientations];
 
     for ( StFttCluster* clu : mFttCollection->clusters() ) {
         UChar_t rob = mFttDb->rob( clu );
         if ( clu->nStrips() < 2 ) continue;
+        if ( rob >= StFttDb::nRob || clu->row() >= StFttDb::nRowsPerQuad || clu->orientation() >= StFttDb::nStripOrientations ) continue;
         clusters[ rob ][ clu->row() ][ clu->orientation() ].push_back( clu );
     } // loop on hit
 
-    
-    for ( size_t iRob = 1; iRob < StFttDb::nRob; iRob ++ ){
-        for ( size_t iRowH = 0; iRowH < 3; iRowH++ ){
-            size_t nH = clusters[ iRob ][ iRowH ][ kFttHorizontal ].size();
+    for ( size_t iRob = 0; iRob < StFttDb::nRob; iRob ++ ){
+        std::vector< StFttCluster *> hClusters[3], vClusters[3];
+        for ( size_t iRow = 0; iRow < 3; iRow++ ){
+            hClusters[iRow].swap( clusters[ iRob ][ iRow ][ kFttHorizontal ] );
+            vClusters[iRow].swap( clusters[ iRob ][ iRow ][ kFttVertical ] );
+        }
+        MakeLocalPoints( hClusters, vClusters );
+    } // iRob
+} // MakeLocalPoints
+
+/* Points of one ROB
+ *
+ * A horizontal cluster measures y and covers the x range of its row, a
+ * vertical cluster measures x and covers the y range of its row. With the
+ * clusters of each row sorted by their coordinate, only the pairs whose
+ * pad regions overlap are looked at, instead of all nH x nV pairs.
+ * The extent of a row is given by rowExtent.
+ */
+void StFttPointMaker::MakeLocalPoints( std::vector<StFttCluster*> hClusters[], std::vector<StFttCluster*> vClusters[] ){
+    auto byX = []( const StFttCluster *a, const StFttCluster *b ) { return a->x() < b->x(); };
+
+    size_t nH = 0, nV = 0;
+    for ( size_t iRow = 0; iRow < 3; iRow++ ){
+        std::sort( hClusters[iRow].begin(), hClusters[iRow].end(), byX );
+        std::sort( vClusters[iRow].begin(), vClusters[iRow].end(), byX );
+        nH += hClusters[iRow].size();
+        nV += vClusters[iRow].size();
+    }
+    if ( nH == 0 || nV == 0 )
+        return;
+
+    size_t nPairs = 0;
+    for ( size_t iRowH = 0; iRowH < 3; iRowH++ ){
+        // x range covered by the horizontal strips of this row
+        float xLo, xHi;
+        rowExtent( iRowH, xLo, xHi );
+        for ( size_t iH = 0; iH < hClusters[iRowH].size(); iH++ ){
+            const float y = hClusters[iRowH][iH]->x();
             for ( size_t iRowV = 0; iRowV < 3; iRowV++ ){
-                size_t nV = clusters[ iRob ][ iRowV ][ kFttVertical ].size();
-                for ( size_t iH = 0; iH < nH; iH++ ){
-                    auto cluH = clusters[ iRob ][ iRowH ][ kFttHorizontal ][ iH ];
-                    for ( size_t iV = 0; iV < nV; iV++ ){
-                        auto cluV = clusters[ iRob ][ iRowV ][ kFttVertical ][ iV ];
-
-                        StFttPoint * p = makePoint( cluH, cluV );
-                    } // iV
-                } // iH
+                // the horizontal cluster has to be in the y range of the vertical strips of this row
+                float yLo, yHi;
+                rowExtent( iRowV, yLo, yHi );
+                if ( y < yLo || y > yHi )
+                    continue;
+                const std::vector<StFttCluster*> &vRow = vClusters[iRowV];
+                auto it = std::lower_bound( vRow.begin(), vRow.end(), xLo, []( const StFttCluster *c, float x ) { return c->x() < x; } );
+                for ( ; it != vRow.end() && (*it)->x() <= xHi; ++it ){
+                    makePoint( hClusters[iRowH][iH], *it );
+                    nPairs++;
+                }
             } // iRowV
-        } // iRowH
-    } // iRob
+        } // iH
+    } // iRowH
+
+    LOG_DEBUG << "StFttPointMaker: " << nH << " x " << nV << " clusters, " << nPairs << " overlapping pairs" << endm;
 } // MakeLocalPoints
 
 void StFttPointMaker::MakeGlobalPoints() {
@@ -200,19 +239,23 @@ StFttPoint * StFttPointMaker::makePoint( StFttCluster * cluH, StFttCluster * clu
     return nullptr;
 } // makePoint
 
+// range of the coordinate along the strips of a row, widened by rowMargin
+// since a cluster this close to a row edge overlaps the next row too
+void StFttPointMaker::rowExtent( size_t row, float &lo, float &hi ) const {
+    lo = row * StFttDb::rowLength - mRowMargin;
+    hi = ( row + 1 ) * StFttDb::rowLength + mRowMargin;
+}
+
 void StFttPointMaker::clusterBounds( StFttCluster* clu, float &x1, float &y1, float &x2, float &y2 ){
     // printf( "clusterBounds:" );
-    const float rowWidth = 176;
     if ( clu->orientation() == kFttHorizontal ){
         y1 = y2 = clu->x();
-        x1 = clu->row() * rowWidth; // rowWidth is a rough estimate of strip width
-        x2 = (clu->row() + 1) * rowWidth; // rowWidth is a rough estimate of strip width
+        rowExtent( clu->row(), x1, x2 );
     }
 
     if ( clu->orientation() == kFttVertical ){
         x1 = x2 = clu->x();
-        y1 = clu->row() * rowWidth; // rowWidth is a rough estimate of strip width
-        y2 = (clu->row() + 1) * rowWidth; // rowWidth is a rough estimate of strip width
+        rowExtent( clu->row(), y1, y2 );
     }
 } // cluster bounds
 
@@ -39,6 +39,8 @@ public:
 private:
     void InjectTestData();
     void MakeLocalPoints();
+    void MakeLocalPoints( std::vector<StFttCluster*> hClusters[], std::vector<StFttCluster*> vClusters[] );
+    void rowExtent( size_t row, float &lo, float &hi ) const;
     void clusterBounds( StFttCluster* clu, float &x1, float &y1, float &x2, float &y2 );
     StFttPoint *makePoint( StFttCluster * cluH, StFttCluster * cluV, int mode = 0 );
     void MakeGlobalPoints();
@@ -49,6 +51,8 @@ private:
     Bool_t               mUseTestData;
     StFttDb*             mFttDb;
 
+    Float_t              mRowMargin;        // mm, a cluster this close to a row edge overlaps the next row too
+
     ClassDef( StFttPointMaker, 1 )
 };
 
@@ -3,7 +3,6 @@
 const std::string FwdTrackerConfig::valDNE = std::string( "<DNE/>" );
 const std::string FwdTrackerConfig::pathDelim = std::string( "." );
 const std::string FwdTrackerConfig::attrDelim = std::string( ":" );
-std::stringstream FwdTrackerConfig::sstr;
 
 ////
 // template specializations
@@ -24,7 +24,6 @@ protected:
     bool mErrorParsing = false;
     // read only map of the config, read with get<> functions
     std::map<std::string, std::string> mNodes;
-    static std::stringstream sstr; // reused for string to numeric conversion
 
     // assumes bare path and adds [i] until DNE
     // reports lowest non-existant index
@@ -101,12 +100,11 @@ public:
     // dump config to a basic string representation - mostly for debugging
     std::string dump() const {
         using namespace std;
-        FwdTrackerConfig::sstr.str("");
-        FwdTrackerConfig::sstr.clear();
+        ostringstream sstr;
         for ( auto kv : mNodes ){
-            FwdTrackerConfig::sstr << "[" << kv.first << "] = " << kv.second << endl;
+            sstr << "[" << kv.first << "] = " << kv.second << endl;
         }
-        return FwdTrackerConfig::sstr.str();
+        return sstr.str();
     }
 
     // Does a path exist
@@ -120,13 +118,12 @@ public:
 
     // generic conversion to type T from std::string
     // override this for special conversions
+    // no shared state, so the config can be read from any thread
     template <typename T>
     T convert( std::string s ) const {
         T rv;
-        FwdTrackerConfig::sstr.str("");
-        FwdTrackerConfig::sstr.clear();
-        FwdTrackerConfig::sstr << s;
-        FwdTrackerConfig::sstr >> rv;
+        std::istringstream sstr( s );
+        sstr >> rv;
         return rv;
     }
 
@@ -176,6 +173,16 @@ public:
         return result;
     }
 
+    // sets a node or attribute, adding it if needed
+    // e.g. to override a value from the file for a single job
+    template <typename T>
+    void set( std::string path, T v ) {
+        canonize( path );
+        std::ostringstream sstr;
+        sstr << v;
+        mNodes[ path ] = sstr.str();
+    }
+
     // list the paths of children nodes for a given node
     std::vector<std::string> childrenOf( std::string path ) const {
         using namespace std;
@@ -28,6 +28,11 @@
 #include "StEvent/StPrimaryVertex.h"
 #include "StEvent/StEnumerations.h"
 #include "StEvent/StTrackDetectorInfo.h"
+#include "StEvent/StFcsCollection.h"
+#include "StEvent/StFcsCluster.h"
+#include "StEvent/StFwdTrack.h"
+#include "StEvent/StFwdTrackCollection.h"
+#include "StFcsDbMaker/StFcsDb.h"
 
 #include "StEventUtilities/StEventHelper.h"
 
@@ -49,11 +54,6 @@
 #include "TLorentzVector.h"
 
 FwdSystem* FwdSystem::sInstance = nullptr;
-TMVA::Reader * BDTCrit2::reader = nullptr;
-float BDTCrit2::Crit2_RZRatio = -999;
-float BDTCrit2::Crit2_DeltaRho = -999;
-float BDTCrit2::Crit2_DeltaPhi = -999;
-float BDTCrit2::Crit2_StraightTrackRatio = -999;
 
 //_______________________________________________________________________________________
 class GenfitUtils{
@@ -160,60 +160,13 @@ class SiRasterizer {
     double mRasterR, mRasterPhi;
 };
 
-//  Wrapper class around the forward tracker
-class ForwardTracker : public ForwardTrackMaker {
-  public:
-    // Replaces original initialization.  Config file and hitloader
-    // will be provided by the maker.
-    void initialize( bool genHistograms ) {
-        LOG_INFO << "ForwardTracker::initialize()" << endm;
-        nEvents = 1; // only process single event
-
-        // Create the forward system...
-        FwdSystem::sInstance = new FwdSystem();
-
-        // make our quality plotter
-        mQualityPlotter = new QualityPlotter(mConfig);
-        mQualityPlotter->makeHistograms(mConfig.get<size_t>("TrackFinder:nIterations", 1));
-
-        // initialize the track fitter
-        mTrackFitter = new TrackFitter(mConfig);
-        mTrackFitter->setGenerateHistograms(genHistograms);
-        mTrackFitter->setup();
-
-        ForwardTrackMaker::initialize( genHistograms );
-    }
-
-    void finish() {
-
-        if ( mGenHistograms ){
-            mQualityPlotter->finish();
-            writeEventHistograms();
-        }
-
-        if (FwdSystem::sInstance){
-            delete FwdSystem::sInstance;
-            FwdSystem::sInstance = 0;
-        }
-        if (mQualityPlotter){
-            delete mQualityPlotter;
-            mQualityPlotter = 0;
-        }
-        if (mTrackFitter){
-            delete mTrackFitter;
-            mTrackFitter= 0;
-        }
-    }
-};
-
-
-
 //________________________________________________________________________
 StFwdTrackMaker::StFwdTrackMaker() : StMaker("fwdTrack"), mGenHistograms(false), mGenTree(false), mForwardTracker(nullptr), mForwardData(nullptr){
     SetAttr("useFtt",1);                 // Default Ftt on 
     SetAttr("useFst",1);                 // Default Fst on
     SetAttr("config", "config.xml");     // Default configuration file (user may override before Init())
     SetAttr("fillEvent",1); // fill StEvent
+    SetAttr("fillFwdTracks",1); // fill the StFwdTrackCollection of StEvent, for StMuDstMaker / StPicoDstMaker
 };
 
 int StFwdTrackMaker::Finish() {
@@ -294,6 +247,15 @@ int StFwdTrackMaker::Init() {
         mTree->Branch("rnfst", &mTreeRNumFst, "rnfst[rnt]/s");
         mTree->Branch("rqual", &mTreeRQual, "rqual[rnt]/F");
 
+        // track finding budget decisions, one entry per iteration
+        mTree->Branch("budget_level", &mTreeBudgetLevel);
+        mTree->Branch("budget_nhits", &mTreeBudgetNHits);
+        mTree->Branch("budget_elapsed", &mTreeBudgetElapsed);
+        mTree->Branch("budget_nslices", &mTreeBudgetNSlices);
+        mTree->Branch("budget_tight", &mTreeBudgetTight);
+        mTree->Branch("budget_greedy", &mTreeBudgetGreedy);
+        mTree->Branch("budget_overruns", &mTreeBudgetOverruns);
+
         std::string path = "TrackFinder.Iteration[0].SegmentBuilder";
         std::vector<string> paths = mFwdConfig.childrenOf(path);
 
@@ -369,6 +331,8 @@ int StFwdTrackMaker::Init() {
     mForwardTracker->setData(mForwardData);
     mForwardTracker->initialize( mGenHistograms );
 
+    mFcsMatchParams = FwdFcsMatchParams::load( mFwdConfig );
+
     if ( mGenHistograms ){
         mHistograms["McEventEta"] = new TH1D("McEventEta", ";MC Track Eta", 1000, -5, 5);
         mHistograms["McEventPt"] = new TH1D("McEventPt", ";MC Track Pt (GeV/c)", 1000, 0, 10);
@@ -415,7 +379,7 @@ int StFwdTrackMaker::Init() {
     return kStOK;
 };
 
-TMatrixDSym makeSiCovMat(TVector3 hit, FwdTrackerConfig &xfg) {
+FwdHitCov makeSiCovMat(TVector3 hit, FwdTrackerConfig &xfg) {
     // we can calculate the CovMat since we know the det info, but in future we should probably keep this info in the hit itself
 
     float rSize = xfg.get<float>("SiRasterizer:r", 3.0);
@@ -423,9 +387,6 @@ TMatrixDSym makeSiCovMat(TVector3 hit, FwdTrackerConfig &xfg) {
 
     // measurements on a plane only need 2x2
     // for Si geom we need to convert from cylindrical to cartesian coords
-    TMatrixDSym cm(2);
-    TMatrixD T(2, 2);
-    TMatrixD J(2, 2);
     const float x = hit.X();
     const float y = hit.Y();
     const float R = sqrt(x * x + y * y);
@@ -436,38 +397,22 @@ TMatrixDSym makeSiCovMat(TVector3 hit, FwdTrackerConfig &xfg) {
     const float dr = rSize / sqrt12;
     const float dphi = (phiSize) / sqrt12;
 
-    // Setup the Transposed and normal Jacobian transform matrix;
+    // cov = T * diag(dr^2, dphi^2) * J, with the jacobian
+    // T = ( cosphi, -R sinphi ; sinphi, R cosphi ) and J = T^T
+    // written out, so that no TMatrix is needed per hit
     // note, the si fast sim did this wrong
-    // row col
-    T(0, 0) = cosphi;
-    T(0, 1) = -R * sinphi;
-    T(1, 0) = sinphi;
-    T(1, 1) = R * cosphi;
-
-    J(0, 0) = cosphi;
-    J(0, 1) = sinphi;
-    J(1, 0) = -R * sinphi;
-    J(1, 1) = R * cosphi;
-
-    TMatrixD cmcyl(2, 2);
-    cmcyl(0, 0) = dr * dr;
-    cmcyl(1, 1) = dphi * dphi;
+    const double dr2 = dr * dr;
+    const double rdphi2 = R * R * dphi * dphi;
 
-    TMatrixD r = T * cmcyl * J;
-
-    // note: float sigmaX = sqrt(r(0, 0));
-    // note: float sigmaY = sqrt(r(1, 1));
-
-    cm(0, 0) = r(0, 0);
-    cm(1, 1) = r(1, 1);
-    cm(0, 1) = r(0, 1);
-    cm(1, 0) = r(1, 0);
-
-    TMatrixDSym tamvoc(3);
-    tamvoc( 0, 0 ) = cm(0, 0); tamvoc( 0, 1 ) = cm(0, 1); tamvoc( 0, 2 ) = 0.0;
-    tamvoc( 1, 0 ) = cm(1, 0); tamvoc( 1, 1 ) = cm(1, 1); tamvoc( 1, 2 ) = 0.0;
-    tamvoc( 2, 0 ) = 0.0;      tamvoc( 2, 1 ) = 0.0; tamvoc( 2, 2 )      = 0.01*0.01;
+    FwdHitCov tamvoc;
+    tamvoc( 0, 0 ) = cosphi * cosphi * dr2 + sinphi * sinphi * rdphi2;
+    tamvoc( 1, 1 ) = sinphi * sinphi * dr2 + cosphi * cosphi * rdphi2;
+    tamvoc( 0, 1 ) = cosphi * sinphi * ( dr2 - rdphi2 );
+    tamvoc( 1, 0 ) = tamvoc( 0, 1 );
+    tamvoc( 2, 2 ) = 0.01*0.01;
 
+    // note: float sigmaX = sqrt(tamvoc(0, 0));
+    // note: float sigmaY = sqrt(tamvoc(1, 1));
 
     return tamvoc;
 }
@@ -505,7 +450,7 @@ void StFwdTrackMaker::loadStgcHitsFromGEANT( FwdDataSource::McTrackMap_t &mcTrac
     }
 
     // make the Covariance Matrix once and then reuse
-    TMatrixDSym hitCov3(3);
+    FwdHitCov hitCov3;
     const double sigXY = 0.01;
     hitCov3(0, 0) = sigXY * sigXY;
     hitCov3(1, 1) = sigXY * sigXY;
@@ -569,7 +514,7 @@ void StFwdTrackMaker::loadStgcHitsFromGEANT( FwdDataSource::McTrackMap_t &mcTrac
             }
         }
 
-        FwdHit *hit = new FwdHit(count++, x, y, z, -plane_id, track_id, hitCov3, mcTrackMap[track_id]);
+        FwdHit *hit = mForwardData->makeHit(count++, x, y, z, -plane_id, track_id, hitCov3, mcTrackMap[track_id].get());
 
         // Add the hit to the hit map
         hitMap[hit->getSector()].push_back(hit);
@@ -600,7 +545,7 @@ void StFwdTrackMaker::loadStgcHitsFromStEvent( FwdDataSource::McTrackMap_t &mcTr
     const StSPtrVecRnDHit &hits = rndCollection->hits();
 
     // we will reuse this to hold the cov mat
-    TMatrixDSym hitCov3(3);
+    FwdHitCov hitCov3;
     
     for (unsigned int stgchit_index = 0; stgchit_index < hits.size(); stgchit_index++) {
         StRnDHit *hit = hits[stgchit_index];
@@ -617,13 +562,13 @@ void StFwdTrackMaker::loadStgcHitsFromStEvent( FwdDataSource::McTrackMap_t &mcTr
         StMatrixF covmat = hit->covariantMatrix();
 
         // copy covariance matrix from StMatrixF
-        std::copy(&covmat(0,0), &covmat(0,0) + 9, hitCov3.GetMatrixArray());
+        std::copy(&covmat(0,0), &covmat(0,0) + 9, hitCov3.data());
 
-        shared_ptr<McTrack> mct = nullptr;
+        McTrack *mct = nullptr;
         if ( hit->idTruth() > 0 && mcTrackMap.count( hit->idTruth() ) ){
-            mct = mcTrackMap[hit->idTruth()];
+            mct = mcTrackMap[hit->idTruth()].get();
         }
-        FwdHit *fhit = new FwdHit(count++, hit->position().x(), hit->position().y(), hit->position().z(), -layer, hit->idTruth(), hitCov3, mct);
+        FwdHit *fhit = mForwardData->makeHit(count++, hit->position().x(), hit->position().y(), hit->position().z(), -layer, hit->idTruth(), hitCov3, mct);
 
         // Add the hit to the hit map
         hitMap[fhit->getSector()].push_back(fhit);
@@ -664,7 +609,7 @@ void StFwdTrackMaker::loadFstHitsFromStEvent( FwdDataSource::McTrackMap_t &mcTra
     const StSPtrVecRnDHit &hits = rndCollection->hits();
 
     // we will reuse this to hold the cov mat
-    TMatrixDSym hitCov3(3);
+    FwdHitCov hitCov3;
     
     for (unsigned int fsthit_index = 0; fsthit_index < hits.size(); fsthit_index++) {
         StRnDHit *hit = hits[fsthit_index];
@@ -683,7 +628,7 @@ void StFwdTrackMaker::loadFstHitsFromStEvent( FwdDataSource::McTrackMap_t &mcTra
         hitCov3(1,0) = covmat[1][0]; hitCov3(1,1) = covmat[1][1]; hitCov3(1,2) = covmat[1][2];
         hitCov3(2,0) = covmat[2][0]; hitCov3(2,1) = covmat[2][1]; hitCov3(2,2) = covmat[2][2];
 
-        FwdHit *fhit = new FwdHit(count++, hit->position().x(), hit->position().y(), hit->position().z(), hit->layer(), hit->idTruth(), hitCov3, mcTrackMap[hit->idTruth()]);
+        FwdHit *fhit = mForwardData->makeHit(count++, hit->position().x(), hit->position().y(), hit->position().z(), hit->layer(), hit->idTruth(), hitCov3, mcTrackMap[hit->idTruth()].get());
         // LOG_INFO << "FST HIT( " << hit->position().x() << ", " << hit->position().y() << ", " << hit->position().z() << ", " << hit->layer() << endm;
         size_t index = hit->layer()-4;
         // LOG_INFO << "FST Layer = " << hit->layer() << ", " << TString::Format("fsi%luHitMapZ", index).Data() << endm;
@@ -710,7 +655,7 @@ void StFwdTrackMaker::loadFstHitsFromGEANT( FwdDataSource::McTrackMap_t &mcTrack
     
 
     // reuse this to store cov mat
-    TMatrixDSym hitCov3(3);
+    FwdHitCov hitCov3;
     
     if ( mGenHistograms ) this->mHistograms["nHitsFSI"]->Fill(nfsi);
     // LOG_INFO << "# fsi hits = " << nfsi << endm;
@@ -759,7 +704,7 @@ void StFwdTrackMaker::loadFstHitsFromGEANT( FwdDataSource::McTrackMap_t &mcTrack
         }
 
         hitCov3 = makeSiCovMat( TVector3( x, y, z ), mFwdConfig );
-        FwdHit *hit = new FwdHit(count++, x, y, z, d, track_id, hitCov3, mcTrackMap[track_id]);
+        FwdHit *hit = mForwardData->makeHit(count++, x, y, z, d, track_id, hitCov3, mcTrackMap[track_id].get());
 
         // Add the hit to the hit map
         hitMap[hit->getSector()].push_back(hit);
@@ -815,6 +760,29 @@ void StFwdTrackMaker::loadMcTracks( FwdDataSource::McTrackMap_t &mcTrackMap ){
 } // loadMcTracks
 
 
+//________________________________________________________________________
+int StFwdTrackMaker::InitRun( int runnumber ) {
+    // the geometry is looked up once by the track fitter, when it is setup,
+    // so that FillTrack does not need a navigator and path lookups per track
+    mFttZ.clear();
+    if ( mForwardTracker && mForwardTracker->getTrackFitter() ) {
+        const FwdGeomCache &geom = mForwardTracker->getTrackFitter()->getGeometry();
+        if ( geom.fttFromGeometry )
+            mFttZ = geom.fttZ;
+    }
+
+    if ( mFttZ.size() < 4 || mFttZ[0] < 200.0 ) { // check that valid z-locations were found
+        LOG_ERROR << "Could not load Ftt geometry, tracks will be invalid" << endm;
+        mFttZ.resize( 4, 0.0 );
+    }
+
+    mFcsDb = static_cast<StFcsDb*>( GetDataSet( "fcsDb" ) );
+    if ( mFcsMatchParams.active && !mFcsDb ) {
+        LOG_WARN << "No fcsDb found, forward tracks will not be matched to FCS clusters" << endm;
+    }
+    return StMaker::InitRun( runnumber );
+}
+
 //________________________________________________________________________
 int StFwdTrackMaker::Make() {
     long long itStart = FwdTrackerUtils::nowNanoSecond();
@@ -868,7 +836,8 @@ int StFwdTrackMaker::Make() {
     }
     
     if ( IAttr("useFst") ) {
-        loadFstHits( mcTrackMap, fsiHitMap );
+        // continue the hit ids after the Ftt hits, so they are unique in the event
+        loadFstHits( mcTrackMap, fsiHitMap, mForwardData->nHits() );
     }
 
     // St_g2t_event *g2t_event = (St_g2t_event *)GetDataSet("geant/g2t_event");
@@ -889,10 +858,17 @@ int StFwdTrackMaker::Make() {
     // fill the ttree if we have it turned on (mGenTree)
     FillTTree();
 
-    LOG_DEBUG << "Forward tracking on this event took " << (FwdTrackerUtils::nowNanoSecond() - itStart) * 1e-6 << " ms" << endm;
+    StEvent *stEvent = static_cast<StEvent *>(GetInputDS("StEvent"));
 
+    if ( IAttr("fillFwdTracks") ) {
+        if ( stEvent )
+            FillFwdTracks( stEvent );
+        else
+            LOG_WARN << "No StEvent found, the forward tracks are not saved" << endm;
+    }
+
+    LOG_DEBUG << "Forward tracking on this event took " << (FwdTrackerUtils::nowNanoSecond() - itStart) * 1e-6 << " ms" << endm;
 
-    StEvent *stEvent = static_cast<StEvent *>(GetInputDS("StEvent"));
 
     if ( false && IAttr("fillEvent") ) {
 
@@ -1097,6 +1073,23 @@ void StFwdTrackMaker::FillTTree(){
             LOG_WARN << "Size mismatch between track seeds and track fits" << endm;
         }
 
+        mTreeBudgetLevel.clear();
+        mTreeBudgetNHits.clear();
+        mTreeBudgetElapsed.clear();
+        mTreeBudgetNSlices.clear();
+        mTreeBudgetTight.clear();
+        mTreeBudgetGreedy.clear();
+        mTreeBudgetOverruns.clear();
+        for ( const auto &budget : mForwardTracker->getBudgetDecisions() ){
+            mTreeBudgetLevel.push_back( budget.level );
+            mTreeBudgetNHits.push_back( budget.nHits );
+            mTreeBudgetElapsed.push_back( budget.elapsedMs );
+            mTreeBudgetNSlices.push_back( budget.nPhiSlices );
+            mTreeBudgetTight.push_back( budget.tightCriteria );
+            mTreeBudgetGreedy.push_back( budget.greedy );
+            mTreeBudgetOverruns.push_back( budget.nStep3Overruns );
+        }
+
         mTree->Fill();
     } // if mGenTree
 }
@@ -1105,6 +1098,7 @@ void StFwdTrackMaker::FillTTree(){
 void StFwdTrackMaker::Clear(const Option_t *opts) {
     LOG_DEBUG << "StFwdTrackMaker::CLEAR" << endm;
     mForwardData->clear();
+    mFcsClusters.clear();
 
     if (mGenTree){
         for ( size_t i = 0; i < MAX_TREE_ELEMENTS; i++ ){
@@ -1193,12 +1187,150 @@ void StFwdTrackMaker::FillEvent()
 }
 
 
-void StFwdTrackMaker::FillTrack( StTrack *otrack, const genfit::Track *itrack, const Seed_t &iseed, StTrackDetectorInfo *info )
+void StFwdTrackMaker::FillFwdTracks( StEvent *stEvent )
 {
-    vector<double> fttZ = FwdGeomUtils( gGeoManager ).fttZ( {0.0, 0.0, 0.0, 0.0} );
-    if ( fttZ.size() < 4 || fttZ[0] < 200.0 ) { // check that valid z-locations were found
-        LOG_ERROR << "Could not load Ftt geometry, tracks will be invalid" << endm;
+    StFwdTrackCollection *fwdTracks = stEvent->fwdTrackCollection();
+    if ( !fwdTracks ) {
+        fwdTracks = new StFwdTrackCollection();
+        stEvent->setFwdTrackCollection( fwdTracks );
+    }
+
+    const auto &seeds = mForwardTracker->getRecoTracks();
+    const auto &genfitTracks = mForwardTracker->globalTracks();
+    const auto &fitMoms = mForwardTracker->getFitMomenta();
+    const auto &numFstHits = mForwardTracker->getNumFstHits();
+
+    // the planes in StFwdTrack::ProjectionPlane order
+    const FwdGeomCache &geom = mForwardTracker->getTrackFitter()->getGeometry();
+    std::vector<genfit::SharedPlanePtr> planes;
+    planes.insert( planes.end(), geom.fstPlanes.begin(), geom.fstPlanes.end() );
+    planes.insert( planes.end(), geom.fttPlanes.begin(), geom.fttPlanes.end() );
+    planes.push_back( geom.ecalPlane );
+    planes.push_back( geom.hcalPlane );
+    if ( planes.size() != StFwdTrack::kNProjections ) {
+        LOG_WARN << "Forward geometry has " << planes.size() << " planes, expected " << (int)StFwdTrack::kNProjections << ", tracks are not projected" << endm;
+        planes.clear();
+    }
+    std::vector<FcsTrackState> fcsStates;
+
+    for ( size_t i = 0; i < genfitTracks.size(); i++ ) {
+        genfit::Track *track = genfitTracks[i];
+        if ( track->getNumPoints() <= 0 )
+            continue; // no hits were added to the track
+
+        genfit::AbsTrackRep *cardinal = track->getCardinalRep();
+        genfit::FitStatus *status = cardinal ? track->getFitStatus( cardinal ) : nullptr;
+        if ( !status || !status->isFitted() )
+            continue; // the seed was rejected by the prefit (it keeps its points) or the fit threw
+        const bool converged = status->isFitConverged();
+
+        StFwdTrack *fwdTrack = new StFwdTrack();
+        fwdTracks->addTrack( fwdTrack );
+
+        fwdTrack->setStatus( ( converged ? StFwdTrack::kFitConverged : 0 ) | ( numFstHits[i] > 0 ? StFwdTrack::kFstRefit : 0 ) );
+        fwdTrack->setCharge( status->getCharge() );
+        fwdTrack->setChi2( status->getChi2() );
+        fwdTrack->setNdf( status->getNdf() );
+        fwdTrack->setNHits( seeds[i].size(), numFstHits[i] );
+
+        double fqatruth = 0;
+        int idtruth = MCTruthUtils::dominantContribution( seeds[i], fqatruth );
+        fwdTrack->setIdTruth( idtruth, std::floor( fqatruth * 100 ) );
+
+        TVector3 mom = fitMoms[i];
+        try {
+            genfit::MeasuredStateOnPlane first = track->getFittedState( 0 );
+            const TVector3 pos = first.getPos();
+            fwdTrack->setOrigin( StThreeVectorF( pos.X(), pos.Y(), pos.Z() ) );
+            mom = first.getMom();
+        } catch ( genfit::Exception &e ) {
+            LOG_DEBUG << "No fitted state for forward track " << i << ": " << e.what() << endm;
+        }
+        fwdTrack->setMomentum( StThreeVectorF( mom.X(), mom.Y(), mom.Z() ) );
+
+        if ( !converged )
+            continue;
+
+        // the FST is upstream of the fitted points, the FTT and FCS downstream
+        FcsTrackState fcsState;
+        fcsState.track = fwdTrack;
+        fcsState.p = mom.Mag();
+        for ( size_t iPlane = 0; iPlane < planes.size(); iPlane++ ) {
+            try {
+                genfit::MeasuredStateOnPlane state = track->getFittedState( iPlane < StFwdTrack::kFtt0 ? 0 : -1 );
+                cardinal->extrapolateToPlane( state, planes[iPlane] );
+                const TMatrixDSym cov = state.get6DCov();
+                const TVector3 pos = state.getPos();
+                fwdTrack->setProjection( iPlane, StThreeVectorF( pos.X(), pos.Y(), pos.Z() ), sqrt( cov(0, 0) + cov(1, 1) ) );
+                // keep the calorimeter states, the matching does not extrapolate again
+                if ( iPlane == StFwdTrack::kEcal ) {
+                    fcsState.hasEcal = true;
+                    fcsState.ecalPos = pos;
+                    fcsState.ecalDir = state.getDir();
+                } else if ( iPlane == StFwdTrack::kHcal ) {
+                    fcsState.hasHcal = true;
+                    fcsState.hcalPos = pos;
+                    fcsState.hcalDir = state.getDir();
+                }
+            } catch ( genfit::Exception &e ) {
+                LOG_DEBUG << "Projection of forward track " << i << " to plane " << iPlane << " failed: " << e.what() << endm;
+            }
+        }
+        if ( fcsState.hasEcal || fcsState.hasHcal )
+            fcsStates.push_back( fcsState );
+    } // loop on genfitTracks
+
+    if ( mFcsMatchParams.active )
+        MatchFcsClusters( fcsStates );
+} // FillFwdTracks
+
+void StFwdTrackMaker::MatchFcsClusters( const std::vector<FcsTrackState> &states )
+{
+    if ( states.empty() || !mFcsDb )
+        return;
+    StEvent *stEvent = static_cast<StEvent *>( GetInputDS( "StEvent" ) );
+    StFcsCollection *fcsCollection = stEvent ? stEvent->fcsCollection() : nullptr;
+    if ( !fcsCollection )
+        return;
+
+    // the index entries point into mFcsClusters
+    mEcalClusterIndex.clear();
+    mHcalClusterIndex.clear();
+    mFcsClusters.clear();
+    for ( int det = 0; det <= kFcsHcalSouthDetId; det++ ) { // no PRES clusters are matched
+        const StSPtrVecFcsCluster &clusters = fcsCollection->clusters( det );
+        for ( size_t i = 0; i < clusters.size(); i++ ) {
+            const StThreeVectorD xyz = mFcsDb->getStarXYZ( clusters[i] );
+            const TVector3 pos( xyz.x(), xyz.y(), xyz.z() );
+            if ( det <= kFcsEcalSouthDetId )
+                mEcalClusterIndex.add( pos, clusters[i]->energy(), mFcsClusters.size() );
+            else
+                mHcalClusterIndex.add( pos, clusters[i]->energy(), mFcsClusters.size() );
+            mFcsClusters.push_back( clusters[i] );
+        }
+    }
+    mEcalClusterIndex.build( mFcsMatchParams.ecalRadius );
+    mHcalClusterIndex.build( mFcsMatchParams.hcalRadius );
+
+    for ( const auto &st : states ) {
+        if ( st.hasEcal ) {
+            FwdFcsClusterIndex::Match m = mEcalClusterIndex.closest( st.ecalPos, st.ecalDir, mFcsMatchParams.ecalRadius );
+            if ( m.index >= 0 )
+                st.track->setEcalMatch( mFcsClusters[m.index], m.distance, st.p > 0 ? m.energy / st.p : 0 );
+        }
+        if ( st.hasHcal ) {
+            FwdFcsClusterIndex::Match m = mHcalClusterIndex.closest( st.hcalPos, st.hcalDir, mFcsMatchParams.hcalRadius );
+            if ( m.index >= 0 )
+                st.track->setHcalMatch( mFcsClusters[m.index], m.distance, st.p > 0 ? m.energy / st.p : 0 );
+        }
     }
+} // MatchFcsClusters
+
+
+void StFwdTrackMaker::FillTrack( StTrack *otrack, const genfit::Track *itrack, const Seed_t &iseed, StTrackDetectorInfo *info )
+{
+    // z locations are looked up once in InitRun
+    const vector<double> &fttZ = mFttZ;
 
     // otrack == output track
     // itrack == input track (genfit)
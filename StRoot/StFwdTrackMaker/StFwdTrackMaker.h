@@ -5,6 +5,7 @@
 
 #ifndef __CINT__
 #include "GenFit/Track.h"
+#include "StFwdTrackMaker/include/Tracker/FwdFcsMatch.h"
 #endif
 
 #include "FwdTrackerConfig.h"
@@ -20,6 +21,7 @@ namespace genfit {
 class ForwardTracker;
 class FwdDataSource;
 class FwdHit;
+class FwdHitMap;
 class StarFieldAdaptor;
 
 class StGlobalTrack;
@@ -28,6 +30,10 @@ class StTrack;
 class StTrackDetectorInfo;
 class SiRasterizer;
 class McTrack;
+class StFcsDb;
+class StFcsCluster;
+class StEvent;
+class StFwdTrack;
 
 // ROOT includes
 #include "TNtuple.h"
@@ -47,6 +53,7 @@ class StFwdTrackMaker : public StMaker {
     ~StFwdTrackMaker(){/* nada */};
 
     int Init();
+    int InitRun(int runnumber);
     int Finish();
     int Make();
     void Clear(const Option_t *opts = "");
@@ -75,6 +82,13 @@ class StFwdTrackMaker : public StMaker {
     bool mGenTree = false;
     std::string mConfigFile;
 
+    // z of the FTT planes, from the geometry cache of the track fitter
+    std::vector<double> mFttZ;
+
+    // for the track to FCS cluster matching
+    StFcsDb *mFcsDb = nullptr;
+    std::vector<StFcsCluster *> mFcsClusters; // clusters of the event, indexed by the cluster index entries
+
     // elements used only if the mGenTree = true
     float mTreeX[MAX_TREE_ELEMENTS], mTreeY[MAX_TREE_ELEMENTS], mTreeZ[MAX_TREE_ELEMENTS], mTreeHPt[MAX_TREE_ELEMENTS];
     int mTreeN, mTreeTID[MAX_TREE_ELEMENTS], mTreeVID[MAX_TREE_ELEMENTS], mTreeHSV[MAX_TREE_ELEMENTS];
@@ -87,6 +101,8 @@ class StFwdTrackMaker : public StMaker {
 
     int mTreeNVert;
     float mTreeVertX[MAX_TREE_ELEMENTS], mTreeVertY[MAX_TREE_ELEMENTS], mTreeVertZ[MAX_TREE_ELEMENTS];
+    std::vector<int> mTreeBudgetLevel, mTreeBudgetNHits, mTreeBudgetNSlices, mTreeBudgetTight, mTreeBudgetGreedy, mTreeBudgetOverruns;
+    std::vector<float> mTreeBudgetElapsed;
     std::map<string, std::vector<float>> mTreeCrits;
     std::map<string, std::vector<int>> mTreeCritTrackIds;
 
@@ -97,16 +113,29 @@ class StFwdTrackMaker : public StMaker {
         FwdTrackerConfig mFwdConfig;
         std::shared_ptr<ForwardTracker> mForwardTracker;
         std::shared_ptr<FwdDataSource> mForwardData;
+        FwdFcsMatchParams mFcsMatchParams;
+        FwdFcsClusterIndex mEcalClusterIndex, mHcalClusterIndex; // rebuilt each event, kept to reuse the storage
+
+        // state of a converged track on the ECal and HCal planes, taken from the projections
+        struct FcsTrackState {
+            StFwdTrack *track;
+            double p;
+            bool hasEcal = false, hasHcal = false;
+            TVector3 ecalPos, ecalDir, hcalPos, hcalDir;
+        };
+        void MatchFcsClusters( const std::vector<FcsTrackState> &states );
         void loadMcTracks( std::map<int, std::shared_ptr<McTrack>> &mcTrackMap );
-        void loadStgcHits( std::map<int, std::shared_ptr<McTrack>> &mcTrackMap, std::map<int, std::vector<KiTrack::IHit *>> &hitMap, int count = 0 );
-        void loadStgcHitsFromGEANT( std::map<int, std::shared_ptr<McTrack>> &mcTrackMap, std::map<int, std::vector<KiTrack::IHit *>> &hitMap, int count = 0 );
-        void loadStgcHitsFromStEvent( std::map<int, std::shared_ptr<McTrack>> &mcTrackMap, std::map<int, std::vector<KiTrack::IHit *>> &hitMap, int count = 0 );
-        void loadFstHits( std::map<int, std::shared_ptr<McTrack>> &mcTrackMap, std::map<int, std::vector<KiTrack::IHit *>> &hitMap, int count = 0 );
-        void loadFstHitsFromGEANT( std::map<int, std::shared_ptr<McTrack>> &mcTrackMap, std::map<int, std::vector<KiTrack::IHit *>> &hitMap, int count = 0 );
-        void loadFstHitsFromStEvent( std::map<int, std::shared_ptr<McTrack>> &mcTrackMap, std::map<int, std::vector<KiTrack::IHit *>> &hitMap, int count = 0 );
+        void loadStgcHits( std::map<int, std::shared_ptr<McTrack>> &mcTrackMap, FwdHitMap &hitMap, int count = 0 );
+        void loadStgcHitsFromGEANT( std::map<int, std::shared_ptr<McTrack>> &mcTrackMap, FwdHitMap &hitMap, int count = 0 );
+        void loadStgcHitsFromStEvent( std::map<int, std::shared_ptr<McTrack>> &mcTrackMap, FwdHitMap &hitMap, int count = 0 );
+        void loadFstHits( std::map<int, std::shared_ptr<McTrack>> &mcTrackMap, FwdHitMap &hitMap, int count = 0 );
+        void loadFstHitsFromGEANT( std::map<int, std::shared_ptr<McTrack>> &mcTrackMap, FwdHitMap &hitMap, int count = 0 );
+        void loadFstHitsFromStEvent( std::map<int, std::shared_ptr<McTrack>> &mcTrackMap, FwdHitMap &hitMap, int count = 0 );
     #endif
 
     void FillTTree(); // if debugging ttree is turned on (mGenTree)
+    // Fill the StFwdTrackCollection of StEvent (read by StMuDstMaker)
+    void FillFwdTracks( StEvent *stEvent );
     // Fill StEvent
     void FillEvent();
     void FillDetectorInfo(StTrackDetectorInfo *info, const genfit::Track *track, bool increment);
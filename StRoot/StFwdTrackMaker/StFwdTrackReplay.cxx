@@ -0,0 +1,262 @@
+#include "StFwdTrackMaker/StFwdTrackReplay.h"
+#include "StFwdTrackMaker/FwdTrackerConfig.h"
+#include "StFwdTrackMaker/include/Tracker/FwdTracker.h"
+
+#include "StarMagField/StarMagField.h"
+#include "St_base/StMessMgr.h"
+
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TH1D.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+
+ClassImp(StFwdTrackReplay);
+
+namespace {
+    // size of the arrays in the Stg tree, see MAX_TREE_ELEMENTS in StFwdTrackMaker.h
+    const int sMaxTreeElements = 4000;
+
+    // value at quantile q of sorted values
+    double quantile( const std::vector<double> &sorted, double q ) {
+        if ( sorted.empty() )
+            return 0;
+        size_t i = std::min( sorted.size() - 1, (size_t)( q * ( sorted.size() - 1 ) + 0.5 ) );
+        return sorted[i];
+    }
+}
+
+//________________________________________________________________________
+StFwdTrackReplay::StFwdTrackReplay() : mConfigFile("config.xml"), mInputFile("mltree.root"), mOutputFile("fwdReplay.root"),
+    mMaxEvents(-1), mMaxThreads(1), mWarmupEvents(1), mGenHistograms(true), mFieldScale(1.0), mFttFilter(false) {
+}
+
+//________________________________________________________________________
+StFwdTrackReplay::~StFwdTrackReplay() {
+}
+
+//________________________________________________________________________
+int StFwdTrackReplay::Run() {
+    if ( !readEvents() )
+        return 0;
+
+    if ( mEvents.size() <= (size_t)mWarmupEvents ) {
+        LOG_ERROR << "StFwdTrackReplay: " << mEvents.size() << " events is not more than the " << mWarmupEvents << " warmup events" << endm;
+        return 0;
+    }
+
+    TDirectory *prevDir = gDirectory;
+    TFile *fOutput = new TFile( mOutputFile.c_str(), "RECREATE" );
+
+    FwdTrackerConfig config( mConfigFile );
+    mFttFilter = config.get<bool>( "Source:fttFilter", false );
+
+    if ( !StarMagField::Instance() && !config.get<bool>( "TrackFitter:constB", false ) )
+        new StarMagField( StarMagField::kMapped, mFieldScale );
+
+    // the geometry and the fitter are set up once, only the track finding threads change
+    std::shared_ptr<FwdDataSource> data( new FwdDataSource() );
+    ForwardTracker tracker;
+    tracker.setConfig( config );
+    tracker.setSaveCriteriaValues( false );
+    tracker.setData( data );
+    tracker.initialize( mGenHistograms );
+
+    for ( int nThreads = 1; nThreads <= std::max( mMaxThreads, 1 ); nThreads++ ) {
+        fOutput->cd();
+        fOutput->mkdir( TString::Format( "threads%d", nThreads ) )->cd();
+        replay( tracker, *data, nThreads );
+    }
+
+    // writes the tracker histograms, the step durations in there are those of the last thread count
+    fOutput->cd();
+    tracker.finish();
+    data->clear();
+
+    fOutput->Write();
+    fOutput->Close();
+    delete fOutput;
+    gDirectory = prevDir;
+
+    return mEvents.size();
+}
+
+//________________________________________________________________________
+bool StFwdTrackReplay::readEvents() {
+    mEvents.clear();
+
+    std::unique_ptr<TFile> fInput( TFile::Open( mInputFile.c_str() ) );
+    if ( !fInput || fInput->IsZombie() ) {
+        LOG_ERROR << "StFwdTrackReplay: cannot open " << mInputFile << endm;
+        return false;
+    }
+
+    TTree *tree = (TTree *)fInput->Get( "Stg" );
+    if ( !tree ) {
+        LOG_ERROR << "StFwdTrackReplay: no Stg tree in " << mInputFile << endm;
+        return false;
+    }
+
+    int n = 0, nt = 0, nvert = 0;
+    std::vector<float> x( sMaxTreeElements ), y( sMaxTreeElements ), z( sMaxTreeElements );
+    std::vector<int> tid( sMaxTreeElements ), vid( sMaxTreeElements );
+    std::vector<float> pt( sMaxTreeElements ), eta( sMaxTreeElements ), phi( sMaxTreeElements );
+    std::vector<short> q( sMaxTreeElements );
+    std::vector<int> vertId( sMaxTreeElements );
+    std::vector<float> vertx( sMaxTreeElements ), verty( sMaxTreeElements ), vertz( sMaxTreeElements );
+
+    // only the branches needed for tracking
+    tree->SetBranchStatus( "*", 0 );
+    auto address = [&]( const char *name, void *addr ) {
+        tree->SetBranchStatus( name, 1 );
+        tree->SetBranchAddress( name, addr );
+    };
+    address( "n", &n );
+    address( "x", x.data() );
+    address( "y", y.data() );
+    address( "z", z.data() );
+    address( "tid", tid.data() );
+    address( "vid", vid.data() );
+    address( "nt", &nt );
+    address( "pt", pt.data() );
+    address( "eta", eta.data() );
+    address( "phi", phi.data() );
+    address( "q", q.data() );
+    address( "vertid", vertId.data() );
+    address( "nvert", &nvert );
+    address( "vertx", vertx.data() );
+    address( "verty", verty.data() );
+    address( "vertz", vertz.data() );
+
+    Long64_t nEntries = tree->GetEntries();
+    if ( mMaxEvents >= 0 && nEntries > mMaxEvents )
+        nEntries = mMaxEvents;
+
+    mEvents.resize( nEntries );
+    for ( Long64_t i = 0; i < nEntries; i++ ) {
+        tree->GetEntry( i );
+        Event &event = mEvents[i];
+
+        event.x.assign( x.begin(), x.begin() + n );
+        event.y.assign( y.begin(), y.begin() + n );
+        event.z.assign( z.begin(), z.begin() + n );
+        event.tid.assign( tid.begin(), tid.begin() + n );
+        event.vid.assign( vid.begin(), vid.begin() + n );
+
+        event.pt.assign( pt.begin(), pt.begin() + nt );
+        event.eta.assign( eta.begin(), eta.begin() + nt );
+        event.phi.assign( phi.begin(), phi.begin() + nt );
+        event.q.assign( q.begin(), q.begin() + nt );
+        event.vertId.assign( vertId.begin(), vertId.begin() + nt );
+
+        // the maker tracks with the first (primary) GEANT vertex
+        event.vertex[0] = nvert > 0 ? vertx[0] : -999;
+        event.vertex[1] = nvert > 0 ? verty[0] : -999;
+        event.vertex[2] = nvert > 0 ? vertz[0] : -999;
+    }
+
+    LOG_INFO << "StFwdTrackReplay: read " << mEvents.size() << " events from " << mInputFile << endm;
+    return true;
+}
+
+//________________________________________________________________________
+void StFwdTrackReplay::loadEvent( const Event &event, FwdDataSource &data ) {
+    data.clear();
+
+    // the MC tracks are stored from index 1, in GEANT track id order
+    FwdDataSource::McTrackMap_t &mcTrackMap = data.getMcTracks();
+    for ( size_t i = 1; i < event.pt.size(); i++ )
+        mcTrackMap[i] = shared_ptr<McTrack>( new McTrack( event.pt[i], event.eta[i], event.phi[i], event.q[i], event.vertId[i] ) );
+
+    // same as StFwdTrackMaker::loadStgcHitsFromGEANT, the stored positions are already smeared
+    FwdHitCov hitCov3;
+    const double sigXY = 0.01;
+    hitCov3(0, 0) = sigXY * sigXY;
+    hitCov3(1, 1) = sigXY * sigXY;
+    hitCov3(2, 2) = 0.0;
+
+    FwdDataSource::HitMap_t &hitMap = data.getFttHits();
+    int count = 0;
+    for ( size_t i = 0; i < event.x.size(); i++ ) {
+        const int plane_id = event.vid[i];
+        if ( plane_id < 0 || plane_id >= 4 )
+            continue;
+
+        const int track_id = event.tid[i];
+        McTrack *mct = mcTrackMap.count( track_id ) ? mcTrackMap[track_id].get() : nullptr;
+        // same as StFwdTrackMaker::loadStgcHitsFromGEANT, rejects the hits of tracks with |eta| > 5
+        if ( mFttFilter && mct && fabs( mct->mEta ) > 5.0 )
+            continue;
+        FwdHit *hit = data.makeHit( count++, event.x[i], event.y[i], event.z[i], -plane_id, track_id, hitCov3, mct );
+
+        hitMap[hit->getSector()].push_back( hit );
+        if ( mct )
+            mct->addHit( hit );
+    }
+}
+
+//________________________________________________________________________
+void StFwdTrackReplay::replay( ForwardTracker &tracker, FwdDataSource &data, int nThreads ) {
+    tracker.setNThreads( nThreads );
+
+    for ( int i = 0; i < mWarmupEvents; i++ ) {
+        loadEvent( mEvents[i], data );
+        tracker.setEventVertex( TVector3( mEvents[i].vertex[0], mEvents[i].vertex[1], mEvents[i].vertex[2] ) );
+        tracker.doEvent();
+    }
+    // the step histograms should only hold the timed events of this thread count
+    const char *stepNames[] = { "Step1Duration", "Step2Duration", "Step3Duration", "Step4Duration", "FitDuration" };
+    for ( const char *name : stepNames ) {
+        if ( tracker.getHistogram( name ) )
+            tracker.getHistogram( name )->Reset();
+    }
+
+    TH1D *hEventDuration = new TH1D( "EventDuration", ";Duration (ms)", 5000, 0, 5000 );
+    std::vector<double> durations;
+    size_t nTracks = 0;
+
+    for ( size_t i = mWarmupEvents; i < mEvents.size(); i++ ) {
+        loadEvent( mEvents[i], data );
+        tracker.setEventVertex( TVector3( mEvents[i].vertex[0], mEvents[i].vertex[1], mEvents[i].vertex[2] ) );
+
+        long long itStart = FwdTrackerUtils::nowNanoSecond();
+        tracker.doEvent();
+        double duration = ( FwdTrackerUtils::nowNanoSecond() - itStart ) * 1e-6; // milliseconds
+
+        durations.push_back( duration );
+        hEventDuration->Fill( duration );
+        nTracks += tracker.getRecoTracks().size();
+    }
+    // only the tracking, not the loading of the events
+    double trackingDuration = std::accumulate( durations.begin(), durations.end(), 0.0 ) * 1e-3; // seconds
+    double rate = trackingDuration > 0 ? durations.size() / trackingDuration : 0;
+
+    std::sort( durations.begin(), durations.end() );
+    double mean = std::accumulate( durations.begin(), durations.end(), 0.0 ) / durations.size();
+
+    LOG_INFO << "StFwdTrackReplay: " << nThreads << " thread(s), " << durations.size() << " events, "
+             << nTracks << " track seeds, " << rate << " events/s" << endm;
+    LOG_INFO << TString::Format( "    doEvent (ms): mean = %.2f, median = %.2f, 90%% = %.2f, 99%% = %.2f, max = %.2f",
+                                 mean, quantile( durations, 0.5 ), quantile( durations, 0.9 ), quantile( durations, 0.99 ), durations.back() ) << endm;
+
+    for ( const char *name : stepNames ) {
+        TH1 *h = tracker.getHistogram( name );
+        if ( !h || h->GetEntries() == 0 )
+            continue;
+        double probs[3] = { 0.5, 0.9, 0.99 };
+        double quantiles[3] = { 0, 0, 0 };
+        h->GetQuantiles( 3, quantiles, probs );
+        LOG_INFO << TString::Format( "    %s (ms): mean = %.2f, median = %.2f, 90%% = %.2f, 99%% = %.2f",
+                                     name, h->GetMean(), quantiles[0], quantiles[1], quantiles[2] ) << endm;
+        // keep the step durations of this thread count
+        TH1 *hCopy = (TH1 *)h->Clone( name );
+        hCopy->SetDirectory( gDirectory );
+    }
+
+    TH1D *hRate = new TH1D( "EventsPerSecond", ";;events / s", 1, 0, 1 );
+    hRate->SetBinContent( 1, rate );
+}
@@ -0,0 +1,90 @@
+#ifndef ST_FWD_TRACK_REPLAY_H
+#define ST_FWD_TRACK_REPLAY_H
+
+#include "Rtypes.h"
+
+#include <string>
+#include <vector>
+
+class TFile;
+class TTree;
+class FwdDataSource;
+class ForwardTracker;
+
+/* Replays recorded forward tracking events for benchmarking
+ *
+ * Reads the FTT hits, MC tracks and vertices that StFwdTrackMaker writes to the
+ * "Stg" tree of mltree.root (SetGenerateTree), and runs ForwardTracker::doEvent
+ * on them without StChain, StEvent or the database. The events are read once
+ * and the tracker (geometry, fitter) is set up once, then the events are
+ * replayed with 1..N track finding threads (TrackFinder:nThreads). The hits
+ * are filtered as in StFwdTrackMaker (Source:fttFilter).
+ * For each thread count the per event latency of doEvent, the step durations of
+ * the tracker and the events / second (doEvent time only, without loading the
+ * events) are printed and written to the output file.
+ *
+ * The tree does not hold the FST hits, so the Si refit has nothing to add.
+ *
+ * Usage (root4star, after loading the StFwdTrackMaker libraries):
+ *   StFwdTrackReplay replay;
+ *   replay.SetConfigFile( "config.xml" );
+ *   replay.SetInputFile( "mltree.root" );
+ *   replay.SetMaxThreads( 4 );
+ *   replay.Run();
+ */
+class StFwdTrackReplay {
+
+    ClassDef(StFwdTrackReplay, 0);
+
+  public:
+    StFwdTrackReplay();
+    virtual ~StFwdTrackReplay();
+
+    void SetConfigFile( std::string n ) { mConfigFile = n; }
+    void SetInputFile( std::string n ) { mInputFile = n; }
+    void SetOutputFile( std::string n ) { mOutputFile = n; }
+    void SetMaxEvents( int n ) { mMaxEvents = n; }
+    // replays with 1, 2, ..., n threads
+    void SetMaxThreads( int n ) { mMaxThreads = n; }
+    // events run before the timed ones for each thread count (lazy setup, caches)
+    void SetWarmupEvents( int n ) { mWarmupEvents = n; }
+    // the step duration histograms need these, the QualityPlotter they enable adds a little per event cost
+    void SetGenerateHistograms( bool gen ) { mGenHistograms = gen; }
+    // StarMagField scale, used if no field exists yet and the config does not ask for a constant field
+    void SetFieldScale( float scale ) { mFieldScale = scale; }
+
+    // @returns the number of events replayed, 0 on error
+    int Run();
+
+  protected:
+
+    std::string mConfigFile;
+    std::string mInputFile;
+    std::string mOutputFile;
+    int mMaxEvents;
+    int mMaxThreads;
+    int mWarmupEvents;
+    bool mGenHistograms;
+    float mFieldScale;
+    bool mFttFilter; // Source:fttFilter of the config
+
+    #ifndef __CINT__
+    // one recorded event
+    struct Event {
+        std::vector<float> x, y, z;
+        std::vector<int> tid, vid;
+        std::vector<float> pt, eta, phi;
+        std::vector<short> q;
+        std::vector<int> vertId;
+        float vertex[3];
+    };
+    std::vector<Event> mEvents;
+
+    bool readEvents();
+    void loadEvent( const Event &event, FwdDataSource &data );
+    // replays all events with nThreads, writes the results to the current directory
+    void replay( ForwardTracker &tracker, FwdDataSource &data, int nThreads );
+    #endif
+};
+
+#endif
@@ -4,6 +4,14 @@
 #include "TMVA/Reader.h"
 #include "Criteria/ICriterion.h"
 
+#include "St_base/StMessMgr.h"
+#include "StFwdTrackMaker/include/Tracker/FwdHit.h"
+#include "StFwdTrackMaker/include/Tracker/BDTForest.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 
 /** Criterion: the difference of the sqrt(x^2 + y^2) of two hits.
 */
@@ -22,7 +30,19 @@ public:
 
         _saveValues = false;
 
-        
+        // TMVA booking touches global ROOT state, so it is done here (loadCriteria, on the
+        // main thread at initialize) and never from areCompatible on a worker thread
+        if ( !forest().valid() ){
+            reader.reset( new TMVA::Reader("!Color:!Silent") );
+
+            // setup the inputs
+            reader->AddVariable("Crit2_RZRatio", &Crit2_RZRatio);
+            reader->AddVariable("Crit2_DeltaRho", &Crit2_DeltaRho);
+            reader->AddVariable("Crit2_DeltaPhi", &Crit2_DeltaPhi);
+            reader->AddVariable("Crit2_StraightTrackRatio", &Crit2_StraightTrackRatio);
+
+            reader->BookMVA("BDT method", "bdt2-Copy1.xml");
+        }
     }
 
 
@@ -97,21 +117,83 @@ public:
         return sqrt( ratioSquared );
     }
   
-  virtual bool areCompatible( KiTrack::Segment* parent , KiTrack::Segment* child ){
+    /* The forest of the BDT, compiled once and shared by all threads (read only)
+     * Invalid if it could not reproduce TMVA, then each criterion evaluates its own reader
+     */
+    static const BDTForest &forest(){
+        static const BDTForest sForest = compileForest();
+        return sForest;
+    }
 
+    static BDTForest compileForest(){
+        float inputs[4] = {0, 0, 0, 0};
+        TMVA::Reader compileReader("!Color:Silent");
+        compileReader.AddVariable("Crit2_RZRatio", &inputs[0]);
+        compileReader.AddVariable("Crit2_DeltaRho", &inputs[1]);
+        compileReader.AddVariable("Crit2_DeltaPhi", &inputs[2]);
+        compileReader.AddVariable("Crit2_StraightTrackRatio", &inputs[3]);
+        compileReader.BookMVA("BDT method", "bdt2-Copy1.xml");
+
+        BDTForest f;
+        if ( false == f.compile( compileReader, "BDT method", inputs, 4 ) ){
+            LOG_WARN << "Crit2_BDT: could not compile the BDT forest, evaluating it through TMVA::Reader" << endm;
+        }
+        return f;
+    }
 
-    if ( reader == nullptr ){
-        BDTCrit2::reader = new TMVA::Reader("!Color:!Silent");
+    /* rho and phi of a hit, computed once per hit and cached by FwdHit::_id
+     * the criterion is reused for every event, but only by one thread at a time,
+     * so the cache needs no locking; the ids restart with each event, so the cache
+     * must be cleared with clearHitCache() before each event (or phi slice)
+     */
+    void rhoPhi( KiTrack::IHit *h, float &rho, float &phi ){
+        const unsigned int id = static_cast<FwdHit *>( h )->_id;
+        if ( id >= mHitCached.size() ){
+            mHitCached.resize( id + 1, 0 );
+            mHitRho.resize( id + 1 );
+            mHitPhi.resize( id + 1 );
+        }
+        if ( !mHitCached[id] ){
+            mHitRho[id] = sqrt( h->getX()*h->getX() + h->getY()*h->getY() );
+            mHitPhi[id] = atan2( h->getY(), h->getX() );
+            mHitCached[id] = 1;
+        }
+        rho = mHitRho[id];
+        phi = mHitPhi[id];
+    }
 
-        // setup the inputs
-        BDTCrit2::reader->AddVariable("Crit2_RZRatio", &BDTCrit2::Crit2_RZRatio);
-        BDTCrit2::reader->AddVariable("Crit2_DeltaRho", &BDTCrit2::Crit2_DeltaRho);
-        BDTCrit2::reader->AddVariable("Crit2_DeltaPhi", &BDTCrit2::Crit2_DeltaPhi);
-        BDTCrit2::reader->AddVariable("Crit2_StraightTrackRatio", &BDTCrit2::Crit2_StraightTrackRatio);
+    // forgets the rho, phi of the hits of the previous event (keeps the storage)
+    void clearHitCache(){
+        std::fill( mHitCached.begin(), mHitCached.end(), 0 );
+    }
+
+    /* computes the 4 BDT inputs ( RZRatio, DeltaRho, DeltaPhi, StraightTrackRatio )
+     * same as the Eval* functions above, but using the cached rho and phi of the hits
+     */
+    void evalInputs( KiTrack::IHit*a, KiTrack::IHit*b, float *x ){
+        float rhoA, phiA, rhoB, phiB;
+        rhoPhi( a, rhoA, phiA );
+        rhoPhi( b, rhoB, phiB );
+
+        float deltaPhi = phiA - phiB;
+        if (deltaPhi > M_PI) deltaPhi -= 2*M_PI;           //to the range from -pi to pi
+        if (deltaPhi < -M_PI) deltaPhi += 2*M_PI;           //to the range from -pi to pi
+        if (( rhoB*rhoB < 0.0001 )||( rhoA*rhoA < 0.0001 )) deltaPhi = 0.; // In case one of the hits is too close to the origin
+
+        const float az = a->getZ();
+        const float bz = b->getZ();
 
-        BDTCrit2::reader->BookMVA("BDT method", "bdt2-Copy1.xml");
+        x[0] = EvalRZRatio( a, b );
+        x[1] = rhoA - rhoB;
+        x[2] = 180.*fabs( deltaPhi ) / M_PI;
+        // sqrt( rhoA^2 bz^2 / ( rhoB^2 az^2 ) )
+        x[3] = ( rhoB > 0. && az != 0. ) ? ( rhoA * fabs( bz ) ) / ( rhoB * fabs( az ) ) : 0.;
     }
 
+  virtual bool areCompatible( KiTrack::Segment* parent , KiTrack::Segment* child ){
+
+    const BDTForest &compiled = forest();
+
     if (( parent->getHits().size() == 1 )&&( child->getHits().size() == 1 )){
     } //a criterion for 1-segments
     else {
@@ -131,19 +213,26 @@ public:
     
 
     // compute input values
-    BDTCrit2::Crit2_DeltaPhi = EvalDeltaPhi( a, b );
-    BDTCrit2::Crit2_DeltaRho = EvalDeltaRho( a, b );
-    BDTCrit2::Crit2_RZRatio  = EvalRZRatio( a, b );
-    BDTCrit2::Crit2_StraightTrackRatio  = EvalStraightTrackRatio( a, b );
-
-    float score = BDTCrit2::reader->EvaluateMVA("BDT method");
+    float x[4];
+    evalInputs( a, b, x );
+
+    float score = 0;
+    if ( compiled.valid() ){
+        score = compiled.evaluate( x );
+    } else {
+        Crit2_RZRatio  = x[0];
+        Crit2_DeltaRho = x[1];
+        Crit2_DeltaPhi = x[2];
+        Crit2_StraightTrackRatio  = x[3];
+        score = reader->EvaluateMVA("BDT method");
+    }
 
     if (_saveValues){
       _map_name_value["Crit2_BDT"] = score;
-      _map_name_value["Crit2_BDT_DeltaPhi"] = BDTCrit2::Crit2_DeltaPhi;
-      _map_name_value["Crit2_BDT_DeltaRho"] = BDTCrit2::Crit2_DeltaRho;
-      _map_name_value["Crit2_BDT_RZRatio"] = BDTCrit2::Crit2_RZRatio;
-      _map_name_value["Crit2_BDT_StraightTrackRatio"] = BDTCrit2::Crit2_StraightTrackRatio;
+      _map_name_value["Crit2_BDT_DeltaPhi"] = x[2];
+      _map_name_value["Crit2_BDT_DeltaRho"] = x[1];
+      _map_name_value["Crit2_BDT_RZRatio"] = x[0];
+      _map_name_value["Crit2_BDT_StraightTrackRatio"] = x[3];
     }
 
     if ( score < _scoreMin || score > _scoreMax ) return false;
@@ -157,9 +246,16 @@ private:
   
   float _scoreMin{};
   float _scoreMax{};
-  static TMVA::Reader *reader;
+  // TMVA::Reader is bound to the addresses of the input variables and is not thread-safe,
+  // so each criterion owns its reader and inputs; a criterion is only used by one thread at a time
+  // (the tracker keeps one set of criteria per worker), so there is one reader per worker
+  std::unique_ptr<TMVA::Reader> reader;
   // values input to BDT
-  static float Crit2_RZRatio, Crit2_DeltaRho, Crit2_DeltaPhi, Crit2_StraightTrackRatio;
+  float Crit2_RZRatio = -999, Crit2_DeltaRho = -999, Crit2_DeltaPhi = -999, Crit2_StraightTrackRatio = -999;
+
+  // per hit rho, phi cache ( index = FwdHit::_id )
+  std::vector<char> mHitCached;
+  std::vector<float> mHitRho, mHitPhi;
   
   
   
@@ -181,7 +277,15 @@ public:
 
         _saveValues = false;
 
-        
+        // booked here and not in areCompatible, see BDTCrit2
+        reader.reset( new TMVA::Reader("!Color:!Silent") );
+
+        // setup the inputs
+        reader->AddVariable("Crit3_ChangeRZRatio", &Crit3_ChangeRZRatio);
+        reader->AddVariable("Crit3_3DAngle", &Crit3_3DAngle);
+        reader->AddVariable("Crit3_2DAngle", &Crit3_2DAngle);
+
+        reader->BookMVA("BDT3 method", "bdt2-Copy1.xml");
     }
 
 
@@ -200,17 +304,6 @@ public:
 
     virtual bool areCompatible( KiTrack::Segment* parent , KiTrack::Segment* child ){
 
-        if ( reader == nullptr ){
-            BDTCrit3::reader = new TMVA::Reader("!Color:!Silent");
-
-            // setup the inputs
-            BDTCrit3::reader->AddVariable("Crit3_ChangeRZRatio", &BDTCrit3::Crit3_ChangeRZRatio);
-            BDTCrit3::reader->AddVariable("Crit3_3DAngle", &BDTCrit3::Crit3_3DAngle);
-            BDTCrit3::reader->AddVariable("Crit3_2DAngle", &BDTCrit3::Crit3_2DAngle);
-
-            BDTCrit3::reader->BookMVA("BDT method", "bdt2-Copy1.xml");
-        }
-
         if (( parent->getHits().size() == 2 )&&( child->getHits().size() == 2 )){
         } //a criterion for 1-segments
         else {
@@ -227,17 +320,17 @@ public:
         KiTrack::IHit* c = parent-> getHits()[1];
 
         // compute input values
-        BDTCrit3::Crit3_2DAngle         =  Eval2DAngle( a, b, c );
-        BDTCrit3::Crit3_3DAngle         =  Eval3DAngle( a, b, c );
-        BDTCrit3::Crit3_ChangeRZRatio   =  EvalChangeRZRatio( a, b, c );
+        Crit3_2DAngle         =  Eval2DAngle( a, b, c );
+        Crit3_3DAngle         =  Eval3DAngle( a, b, c );
+        Crit3_ChangeRZRatio   =  EvalChangeRZRatio( a, b, c );
         
-        float score = BDTCrit3::reader->EvaluateMVA("BDT3 method");
+        float score = reader->EvaluateMVA("BDT3 method");
 
         if (_saveValues){
             _map_name_value["Crit3_BDT"] = score;
-            _map_name_value["Crit3_BDT_2DAngle"] = BDTCrit3::Crit3_2DAngle;
-            _map_name_value["Crit3_BDT_3DAngle"] = BDTCrit3::Crit3_3DAngle;
-            _map_name_value["Crit3_BDT_ChangeRZRatio"] = BDTCrit3::Crit3_ChangeRZRatio;
+            _map_name_value["Crit3_BDT_2DAngle"] = Crit3_2DAngle;
+            _map_name_value["Crit3_BDT_3DAngle"] = Crit3_3DAngle;
+            _map_name_value["Crit3_BDT_ChangeRZRatio"] = Crit3_ChangeRZRatio;
             
         }
 
@@ -251,9 +344,10 @@ private:
   
     float _scoreMin{};
     float _scoreMax{};
-    static TMVA::Reader *reader;
+    // see BDTCrit2, one reader per criterion
+    std::unique_ptr<TMVA::Reader> reader;
     // values input to BDT
-    static float Crit3_ChangeRZRatio, Crit3_3DAngle, Crit3_2DAngle;
+    float Crit3_ChangeRZRatio = -999, Crit3_3DAngle = -999, Crit3_2DAngle = -999;
   
 };
 
@@ -0,0 +1,175 @@
+#ifndef BDT_Forest_h
+#define BDT_Forest_h
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "TMVA/Reader.h"
+#include "TMVA/MethodBDT.h"
+#include "TMVA/DecisionTree.h"
+#include "TMVA/DecisionTreeNode.h"
+
+/** Flattened copy of the forest of a booked TMVA BDT
+ *
+ * The trees are stored as one array of nodes, each with the index of the
+ * next node for both outcomes of its cut, so evaluating a tree is a tight
+ * loop without virtual calls or TMVA::Event bookkeeping. Evaluation only
+ * reads the nodes, so one instance can be shared by all threads.
+ *
+ * The way TMVA combines the leaves (AdaBoost yes/no leaves, purities or
+ * gradient boost responses) is not public, so compile() tries each of them
+ * against the reader itself and keeps the one that reproduces it. If none
+ * does (e.g. input transformations or fisher cuts) the forest stays invalid
+ * and the reader has to be used instead.
+ */
+class BDTForest {
+  public:
+    BDTForest() {}
+
+    /* compile
+     * @param reader: reader with the method booked, its variables bound to inputs
+     * @param method: method tag used when booking
+     * @param inputs: the variables bound to the reader, in the order they were added
+     * @param nInputs: number of variables
+     * @returns true if the flattened forest reproduces the reader
+     */
+    bool compile( TMVA::Reader &reader, const char *method, float *inputs, size_t nInputs ) {
+        mNodes.clear();
+        mRoots.clear();
+        mWeights.clear();
+        mValid = false;
+
+        TMVA::MethodBDT *bdt = dynamic_cast<TMVA::MethodBDT *>( reader.FindMVA( method ) );
+        if ( bdt == nullptr )
+            return false;
+
+        const std::vector<TMVA::DecisionTree *> &forest = bdt->GetForest();
+        const std::vector<double> &weights = bdt->GetBoostWeights();
+        if ( forest.empty() )
+            return false;
+
+        std::vector<float> cutMin( nInputs, 0 ), cutMax( nInputs, 0 );
+        std::vector<bool> cutSeen( nInputs, false );
+        for ( size_t i = 0; i < forest.size(); i++ ) {
+            mRoots.push_back( mNodes.size() );
+            mWeights.push_back( i < weights.size() ? weights[i] : 1.0 );
+            if ( false == addNode( static_cast<TMVA::DecisionTreeNode *>( forest[i]->GetRoot() ), nInputs, cutMin, cutMax, cutSeen ) )
+                return false;
+        }
+
+        // check each way of combining the trees against TMVA on inputs spread over the range of the cuts
+        std::mt19937 rng( 12345 );
+        std::vector<std::vector<float>> samples;
+        std::vector<float> expected;
+        for ( size_t k = 0; k < 200; k++ ) {
+            std::vector<float> x( nInputs );
+            for ( size_t v = 0; v < nInputs; v++ ) {
+                float lo = cutSeen[v] ? cutMin[v] : -1.0f;
+                float hi = cutSeen[v] ? cutMax[v] : 1.0f;
+                float margin = 0.1f * ( hi - lo ) + 1e-3f;
+                x[v] = std::uniform_real_distribution<float>( lo - margin, hi + margin )( rng );
+                inputs[v] = x[v];
+            }
+            samples.push_back( x );
+            expected.push_back( reader.EvaluateMVA( method ) );
+        }
+
+        for ( int mode = kYesNoLeaf; mode <= kGradResponse; mode++ ) {
+            mMode = (Mode)mode;
+            bool matches = true;
+            for ( size_t k = 0; k < samples.size() && matches; k++ ) {
+                if ( fabs( evaluate( samples[k].data() ) - expected[k] ) > 1e-4 * ( 1 + fabs( expected[k] ) ) )
+                    matches = false;
+            }
+            if ( matches ) {
+                mValid = true;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool valid() const { return mValid; }
+
+    // @returns the BDT score of the input variables x (same order as given to the reader)
+    float evaluate( const float *x ) const {
+        double sum = 0, norm = 0;
+        for ( size_t t = 0; t < mRoots.size(); t++ ) {
+            int n = mRoots[t];
+            while ( mNodes[n].var >= 0 )
+                n = mNodes[n].next[ x[ mNodes[n].var ] >= mNodes[n].cut ];
+
+            const Node &leaf = mNodes[n];
+            switch ( mMode ) {
+                case kYesNoLeaf:   sum += mWeights[t] * leaf.nodeType; break;
+                case kPurity:      sum += mWeights[t] * leaf.purity; break;
+                case kGradPurity:  sum += leaf.purity; break;
+                case kGradResponse:sum += leaf.response; break;
+            }
+            norm += mWeights[t];
+        }
+
+        if ( mMode == kGradPurity || mMode == kGradResponse )
+            return 2.0 / ( 1.0 + exp( -2.0 * sum ) ) - 1;
+        return norm > std::numeric_limits<double>::epsilon() ? sum / norm : 0;
+    }
+
+  protected:
+    enum Mode { kYesNoLeaf = 0, kPurity, kGradPurity, kGradResponse };
+
+    struct Node {
+        int var = -1;      // input variable of the cut, -1 for a leaf
+        float cut = 0;
+        int next[2] = {0, 0}; // next node for x < cut, x >= cut
+        float nodeType = 0, purity = 0, response = 0; // leaf values
+    };
+
+    bool addNode( TMVA::DecisionTreeNode *tn, size_t nInputs, std::vector<float> &cutMin, std::vector<float> &cutMax, std::vector<bool> &cutSeen ) {
+        if ( tn == nullptr )
+            return false;
+
+        const int index = mNodes.size();
+        mNodes.push_back( Node() );
+        Node node;
+
+        TMVA::DecisionTreeNode *left = static_cast<TMVA::DecisionTreeNode *>( tn->GetLeft() );
+        TMVA::DecisionTreeNode *right = static_cast<TMVA::DecisionTreeNode *>( tn->GetRight() );
+        if ( left == nullptr || right == nullptr ) {
+            node.nodeType = tn->GetNodeType();
+            node.purity = tn->GetPurity();
+            node.response = tn->GetResponse();
+            mNodes[index] = node;
+            return true;
+        }
+
+        if ( tn->GetNFisherCoeff() != 0 || tn->GetSelector() < 0 || (size_t)tn->GetSelector() >= nInputs )
+            return false; // not a plain cut
+
+        node.var = tn->GetSelector();
+        node.cut = tn->GetCutValue();
+        if ( !cutSeen[node.var] || node.cut < cutMin[node.var] ) cutMin[node.var] = node.cut;
+        if ( !cutSeen[node.var] || node.cut > cutMax[node.var] ) cutMax[node.var] = node.cut;
+        cutSeen[node.var] = true;
+
+        // TMVA goes right if ( x >= cut ) == cutType
+        node.next[ tn->GetCutType() ? 1 : 0 ] = mNodes.size();
+        if ( false == addNode( right, nInputs, cutMin, cutMax, cutSeen ) )
+            return false;
+        node.next[ tn->GetCutType() ? 0 : 1 ] = mNodes.size();
+        if ( false == addNode( left, nInputs, cutMin, cutMax, cutSeen ) )
+            return false;
+
+        mNodes[index] = node;
+        return true;
+    }
+
+    std::vector<Node> mNodes;
+    std::vector<int> mRoots;
+    std::vector<double> mWeights;
+    Mode mMode = kYesNoLeaf;
+    bool mValid = false;
+};
+
+#endif
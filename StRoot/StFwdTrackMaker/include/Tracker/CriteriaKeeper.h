@@ -20,6 +20,8 @@ class CriteriaKeeper : public KiTrack::ICriterion {
         mChild = nullptr;
     }
 
+    KiTrack::ICriterion *getChild() { return mChild; }
+
     virtual bool areCompatible(KiTrack::Segment *parent, KiTrack::Segment *child) {
         bool result = mChild->areCompatible(parent, child);
 
@@ -1,23 +1,147 @@
 #ifndef FWD_FWD_DATA_SOURCE_H
 #define FWD_FWD_DATA_SOURCE_H
 
+#include <array>
 #include <map>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include "StFwdTrackMaker/include/Tracker/FwdHit.h"
 
 
+/* Hits sorted by layer (the sector of the hit)
+ *
+ * Fixed array with one entry per layer instead of a std::map, so that
+ * the per layer vectors keep their capacity from one event to the next.
+ * Iterates like the map it replaced ( kv.first is the layer, kv.second the hits ),
+ * but every layer is always present (possibly empty).
+ */
+class FwdHitMap {
+  public:
+    using Layer_t = std::pair<int, std::vector<KiTrack::IHit*>>;
+    using Storage_t = std::array<Layer_t, FwdSystem::sNFwdLayers>;
+
+    FwdHitMap() {
+        for ( size_t i = 0; i < mLayers.size(); i++ )
+            mLayers[i].first = i;
+    }
+
+    // throws std::out_of_range for a layer >= FwdSystem::sNFwdLayers
+    std::vector<KiTrack::IHit*> &operator[]( int layer ) { return mLayers.at( layer ).second; }
+
+    Storage_t::iterator begin() { return mLayers.begin(); }
+    Storage_t::iterator end() { return mLayers.end(); }
+    Storage_t::const_iterator begin() const { return mLayers.begin(); }
+    Storage_t::const_iterator end() const { return mLayers.end(); }
+
+    size_t nHits() const {
+        size_t n = 0;
+        for ( const auto &kv : mLayers )
+            n += kv.second.size();
+        return n;
+    }
+    bool empty() const { return nHits() == 0; }
+
+    // empties the layers but keeps their memory
+    void clear() {
+        for ( auto &kv : mLayers )
+            kv.second.clear();
+    }
+
+  protected:
+    Storage_t mLayers;
+};
+
+/* Hits used by accepted tracks, one bit per FwdHit::_id
+ *
+ * Lets later tracking iterations skip hits without erasing them from
+ * the hit map. Reset at the start of every event.
+ */
+class FwdHitUsage {
+  public:
+    void reset( size_t nHits ) { mUsed.assign( nHits, false ); }
+
+    bool isUsed( const KiTrack::IHit *hit ) const {
+        const unsigned int id = static_cast<const FwdHit *>( hit )->_id;
+        return id < mUsed.size() && mUsed[id];
+    }
+
+    // @returns true if the hit was not used before
+    bool markUsed( const KiTrack::IHit *hit ) {
+        const unsigned int id = static_cast<const FwdHit *>( hit )->_id;
+        if ( id >= mUsed.size() )
+            mUsed.resize( id + 1, false );
+        if ( mUsed[id] )
+            return false;
+        mUsed[id] = true;
+        return true;
+    }
+
+  protected:
+    std::vector<bool> mUsed;
+};
+
+/* Event scoped storage for the FwdHits
+ *
+ * Hits are constructed in place inside fixed size blocks. clear() destroys
+ * the hits but keeps the blocks for the next event, so after the first few
+ * events no memory is allocated for hits at all.
+ * The pointers handed out stay valid until clear() is called.
+ */
+class FwdHitArena {
+  public:
+    static const size_t sBlockSize = 1024; // hits per block
+
+    FwdHitArena() : mNHits(0) {}
+    ~FwdHitArena() { clear(); }
+
+    template <typename... Args>
+    FwdHit *create( Args&&... args ) {
+        if ( mNHits == mBlocks.size() * sBlockSize )
+            mBlocks.push_back( std::unique_ptr<Slot_t[]>( new Slot_t[sBlockSize] ) );
+
+        void *mem = &mBlocks[mNHits / sBlockSize][mNHits % sBlockSize];
+        FwdHit *hit = new (mem) FwdHit( std::forward<Args>( args )... );
+        mNHits++;
+        return hit;
+    }
+
+    // destroys all hits, the blocks are kept for reuse
+    void clear() {
+        for ( size_t i = 0; i < mNHits; i++ )
+            reinterpret_cast<FwdHit *>( &mBlocks[i / sBlockSize][i % sBlockSize] )->~FwdHit();
+        mNHits = 0;
+    }
+
+    size_t size() const { return mNHits; }
+
+  protected:
+    using Slot_t = std::aligned_storage<sizeof(FwdHit), alignof(FwdHit)>::type;
+
+    std::vector<std::unique_ptr<Slot_t[]>> mBlocks;
+    size_t mNHits;
+
+  private:
+    FwdHitArena( const FwdHitArena & ) = delete;
+    FwdHitArena &operator=( const FwdHitArena & ) = delete;
+};
+
 /* Authoritative Data Source for Fwd tracks + hits
  *
- * Separation here is not great, but the track/hit loading 
+ * Separation here is not great, but the track/hit loading
  * is tightly bound to the StMaker through the ttree and histogram
  * creation, as well as through the Datasets (StEvent, geant )
- * 
- * So while the filling is done elsewhere, this holds that 
+ *
+ * So while the filling is done elsewhere, this holds that
  * data and releases the pointers when needed.
  */
 class FwdDataSource {
   public:
 
-    using HitMap_t = std::map<int, std::vector<KiTrack::IHit*>>;
+    using HitMap_t = FwdHitMap;
+    // hits by sector in the form KiTrack::SegmentBuilder takes them
+    using SectorHitMap_t = std::map<int, std::vector<KiTrack::IHit*>>;
     using McTrackMap_t = std::map<int, shared_ptr<McTrack>>;
 
     HitMap_t &getFttHits( ) {
@@ -30,28 +154,24 @@ class FwdDataSource {
         return mMcTracks;
     };
 
-    // Cleanup
-    void clear() {
-
-      // delete the hits from the hitmap
-      for ( auto kv : mFttHits ){
-          for ( auto h : kv.second ){
-              delete h;
-          }
-          kv.second.clear();
-      }
+    // number of hits made this event
+    size_t nHits() const { return mHitArena.size(); }
 
-      for ( auto kv : mFstHits ){
-          for ( auto h : kv.second ){
-              delete h;
-          }
-          kv.second.clear();
-      }
+    // make a new hit, owned by the data source until clear()
+    template <typename... Args>
+    FwdHit *makeHit( Args&&... args ) {
+        return mHitArena.create( std::forward<Args>( args )... );
+    }
 
-      // the tracks are shared pointers, so they will be taken care of by clearing the map (below)
+    // Cleanup
+    void clear() {
 
+      // the hit maps only hold pointers into the arena
       mFttHits.clear();
       mFstHits.clear();
+      mHitArena.clear();
+
+      // the tracks are shared pointers, so they will be taken care of by clearing the map
       mMcTracks.clear();
     }
 
@@ -59,6 +179,9 @@ class FwdDataSource {
     HitMap_t mFttHits;
     HitMap_t mFstHits;
     McTrackMap_t mMcTracks;
+
+  protected:
+    FwdHitArena mHitArena;
 };
 
 
@@ -0,0 +1,164 @@
+#ifndef FWD_FCS_MATCH_H
+#define FWD_FCS_MATCH_H
+
+#include "TVector3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "StFwdTrackMaker/FwdTrackerConfig.h"
+
+/* Track to FCS cluster matching parameters (FcsMatch)
+ *
+ * A track is matched to the closest cluster of each calorimeter within
+ * ecalRadius / hcalRadius (cm, in x-y at the z of the cluster).
+ */
+struct FwdFcsMatchParams {
+    bool active = true;
+    double ecalRadius = 15.0;
+    double hcalRadius = 25.0;
+
+    static FwdFcsMatchParams load( const FwdTrackerConfig &cfg ) {
+        FwdFcsMatchParams p;
+        p.active = cfg.get<bool>( "FcsMatch:active", true );
+        p.ecalRadius = cfg.get<double>( "FcsMatch:ecalRadius", 15.0 );
+        p.hcalRadius = cfg.get<double>( "FcsMatch:hcalRadius", 25.0 );
+        return p;
+    }
+};
+
+/* Uniform x-y grid over the clusters of one calorimeter (north and south)
+ *
+ * Built once per event. A track is given by its state on the calorimeter
+ * plane, which is computed once per track, and carried along a straight
+ * line to the z of each candidate cluster (the FCS is outside of the
+ * field), so no extrapolation through the track representation is done per
+ * track-cluster pair. Only the bins within the match radius, widened by
+ * the largest straight line shift between the plane and the cluster z, are
+ * looked into.
+ */
+class FwdFcsClusterIndex {
+  public:
+    struct Match {
+        int index = -1;      // index given to add, -1 if no match
+        double distance = -1;
+        double energy = 0;
+    };
+
+    void clear() {
+        mEntries.clear();
+        mOffsets.clear();
+    }
+
+    /* add
+     * @param pos: cluster position in the STAR frame (cm)
+     * @param energy: cluster energy (GeV)
+     * @param index: index stored with the match (e.g. in the MuDst cluster array)
+     */
+    void add( const TVector3 &pos, double energy, int index ) {
+        Entry e;
+        e.x = pos.X();
+        e.y = pos.Y();
+        e.z = pos.Z();
+        e.energy = energy;
+        e.index = index;
+        mEntries.push_back( e );
+    }
+
+    /* build
+     * @param binWidth: width of the x and y bins (cm), ideally close to the match radius
+     */
+    void build( double binWidth ) {
+        mBinWidth = binWidth > 0 ? binWidth : 10.0;
+        mOffsets.clear();
+        if ( mEntries.empty() )
+            return;
+
+        mXMin = mXMax = mEntries[0].x;
+        mYMin = mYMax = mEntries[0].y;
+        mZMin = mZMax = mEntries[0].z;
+        for ( const auto &e : mEntries ) {
+            mXMin = std::min( mXMin, e.x ); mXMax = std::max( mXMax, e.x );
+            mYMin = std::min( mYMin, e.y ); mYMax = std::max( mYMax, e.y );
+            mZMin = std::min( mZMin, e.z ); mZMax = std::max( mZMax, e.z );
+        }
+        mNX = (int)( ( mXMax - mXMin ) / mBinWidth ) + 1;
+        mNY = (int)( ( mYMax - mYMin ) / mBinWidth ) + 1;
+
+        for ( auto &e : mEntries )
+            e.bin = bin( xBin( e.x ), yBin( e.y ) );
+        std::stable_sort( mEntries.begin(), mEntries.end(), []( const Entry &a, const Entry &b ){ return a.bin < b.bin; } );
+
+        mOffsets.assign( (size_t)mNX * mNY + 1, 0 );
+        for ( const auto &e : mEntries )
+            mOffsets[ e.bin + 1 ]++;
+        for ( size_t i = 1; i < mOffsets.size(); i++ )
+            mOffsets[i] += mOffsets[i - 1];
+    }
+
+    /* closest
+     * @param pos, dir: track state on the calorimeter plane
+     * @param radius: match radius (cm)
+     * @returns the closest cluster within radius in x-y, at the z of the cluster
+     */
+    Match closest( const TVector3 &pos, const TVector3 &dir, double radius ) const {
+        Match m;
+        if ( mOffsets.empty() || dir.Z() == 0 )
+            return m;
+
+        const double tx = dir.X() / dir.Z();
+        const double ty = dir.Y() / dir.Z();
+        const double dzMax = std::max( fabs( mZMin - pos.Z() ), fabs( mZMax - pos.Z() ) );
+        const double wx = radius + fabs( tx ) * dzMax;
+        const double wy = radius + fabs( ty ) * dzMax;
+
+        const int xLo = std::max( 0, xBin( pos.X() - wx ) ), xHi = std::min( mNX - 1, xBin( pos.X() + wx ) );
+        const int yLo = std::max( 0, yBin( pos.Y() - wy ) ), yHi = std::min( mNY - 1, yBin( pos.Y() + wy ) );
+        double best = radius * radius;
+        for ( int ix = xLo; ix <= xHi; ix++ ) {
+            for ( int iy = yLo; iy <= yHi; iy++ ) {
+                const size_t b = bin( ix, iy );
+                for ( size_t k = mOffsets[b]; k < mOffsets[b + 1]; k++ ) {
+                    const Entry &e = mEntries[k];
+                    const double dz = e.z - pos.Z();
+                    const double dx = pos.X() + tx * dz - e.x;
+                    const double dy = pos.Y() + ty * dz - e.y;
+                    const double d2 = dx * dx + dy * dy;
+                    // ties go to the lower index, so the result does not depend on the binning
+                    if ( d2 < best || ( d2 == best && m.index >= 0 && e.index < m.index ) ) {
+                        best = d2;
+                        m.index = e.index;
+                        m.energy = e.energy;
+                    }
+                }
+            }
+        }
+        if ( m.index >= 0 )
+            m.distance = sqrt( best );
+        return m;
+    }
+
+    size_t size() const { return mEntries.size(); }
+
+  protected:
+    struct Entry {
+        double x, y, z;
+        double energy;
+        int index;
+        size_t bin;
+    };
+
+    int xBin( double x ) const { return (int)floor( ( x - mXMin ) / mBinWidth ); }
+    int yBin( double y ) const { return (int)floor( ( y - mYMin ) / mBinWidth ); }
+    size_t bin( int ix, int iy ) const { return (size_t)ix * mNY + iy; }
+
+    double mBinWidth = 10.0;
+    double mXMin = 0, mXMax = 0, mYMin = 0, mYMax = 0, mZMin = 0, mZMax = 0;
+    int mNX = 0, mNY = 0;
+
+    std::vector<Entry> mEntries;  // clusters sorted by bin
+    std::vector<size_t> mOffsets; // start of each bin in mEntries
+};
+
+#endif
@@ -5,6 +5,12 @@
 #include "TGeoNode.h"
 #include "TGeoMatrix.h"
 #include "TGeoNavigator.h"
+#include "TVector3.h"
+
+#include "GenFit/DetPlane.h"
+
+#include <sstream>
+#include <vector>
 
 class FwdGeomUtils {
     public:
@@ -91,4 +97,61 @@ class FwdGeomUtils {
     TGeoNavigator *_navigator = nullptr;
 };
 
-#endif
\ No newline at end of file
+/* Forward detector geometry looked up once
+ *
+ * Each FwdGeomUtils adds a navigator to the TGeoManager and every z lookup
+ * walks the geometry by path, so consumers should read the z locations and
+ * planes from here instead of doing their own lookups.
+ */
+class FwdGeomCache {
+    public:
+        /* build
+         * @param gMan: geometry to look into, may be null (defaults are used)
+         * @param fstDefaultZ, fttDefaultZ: used if the detector is not in the geometry
+         * @param ecalZ, hcalZ: z of the front face of the FCS ECal and HCal (not in the tracking geometry)
+         */
+        void build( TGeoManager *gMan, const std::vector<double> &fstDefaultZ, const std::vector<double> &fttDefaultZ, double ecalZ, double hcalZ ) {
+            FwdGeomUtils fwdGeoUtils( gMan );
+
+            fstFromGeometry = gMan != nullptr && fwdGeoUtils.fstZ( 0 ) > 1.0; // returns 0.0 on failure
+            fstZ = fstFromGeometry ? fwdGeoUtils.fstZ( fstDefaultZ ) : fstDefaultZ;
+            fttFromGeometry = gMan != nullptr && fwdGeoUtils.fttZ( 0 ) > 1.0;
+            fttZ = fttFromGeometry ? fwdGeoUtils.fttZ( fttDefaultZ ) : fttDefaultZ;
+
+            fstPlanes.clear();
+            fstPlanesInner.clear();
+            fstPlanesOuter.clear();
+            for ( auto z : fstZ ) {
+                fstPlanes.push_back( makePlane( z ) );
+                // Inner and outer module planes
+                fstPlanesInner.push_back( makePlane( z - sDzInnerFst ) );
+                fstPlanesInner.push_back( makePlane( z + sDzInnerFst ) );
+                fstPlanesOuter.push_back( makePlane( z - sDzOuterFst ) );
+                fstPlanesOuter.push_back( makePlane( z + sDzOuterFst ) );
+            }
+
+            fttPlanes.clear();
+            for ( auto z : fttZ )
+                fttPlanes.push_back( makePlane( z ) );
+
+            ecalPlane = makePlane( ecalZ );
+            hcalPlane = makePlane( hcalZ );
+        }
+
+        // plane at z, facing along the z-axis
+        static genfit::SharedPlanePtr makePlane( double z ) {
+            return genfit::SharedPlanePtr( new genfit::DetPlane( TVector3( 0, 0, z ), TVector3( 1, 0, 0 ), TVector3( 0, 1, 0 ) ) );
+        }
+
+        static constexpr double sDzInnerFst = 1.715 + 0.04; // cm relative to "center" of disk + residual...
+        static constexpr double sDzOuterFst = 0.240 + 0.04; // cm relative to "center" of disk
+
+        std::vector<double> fstZ, fttZ;
+        bool fstFromGeometry = false, fttFromGeometry = false;
+
+        std::vector<genfit::SharedPlanePtr> fstPlanes, fstPlanesInner, fstPlanesOuter;
+        std::vector<genfit::SharedPlanePtr> fttPlanes;
+        genfit::SharedPlanePtr ecalPlane, hcalPlane;
+};
+
+#endif
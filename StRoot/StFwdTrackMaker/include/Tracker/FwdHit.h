@@ -6,6 +6,9 @@
 #include "KiTrack/ISectorSystem.h"
 #include "KiTrack/KiTrackExceptions.h"
 
+#include "TMatrixDSym.h"
+
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string.h>
@@ -61,14 +64,37 @@ class McTrack {
 };
 
 
+/* Compact 3x3 hit covariance matrix
+ * Stored inline (row major, same layout as TMatrixDSym::GetMatrixArray)
+ * so that making a hit does not need a heap allocated TMatrixDSym
+ */
+struct FwdHitCov {
+    FwdHitCov() { std::fill( m, m + 9, 0.0 ); }
+    FwdHitCov( const TMatrixDSym &cm ) {
+        std::fill( m, m + 9, 0.0 );
+        for ( int i = 0; i < 3 && i < cm.GetNrows(); i++ )
+            for ( int j = 0; j < 3 && j < cm.GetNcols(); j++ )
+                m[3 * i + j] = cm(i, j);
+    }
+
+    double &operator()( int i, int j ) { return m[3 * i + j]; }
+    double operator()( int i, int j ) const { return m[3 * i + j]; }
+    double *data() { return m; }
+
+    double m[9];
+};
+
 /*
  * Note, this class does not follow STAR naming convention.
  * Instead, keep the conventions of KiTrack
+ *
+ * The mc track is owned by the McTrackMap of the FwdDataSource, which lives
+ * as long as the hit (both are cleared at the end of the event)
  */
 class FwdHit : public KiTrack::IHit {
   public:
     FwdHit(unsigned int id, float x, float y, float z, int vid, int tid,
-           TMatrixDSym covmat, std::shared_ptr<McTrack> mcTrack = nullptr )
+           const FwdHitCov &covmat, McTrack *mcTrack = nullptr )
         : KiTrack::IHit() {
         _id = id;
         _x = x;
@@ -78,7 +104,6 @@ class FwdHit : public KiTrack::IHit {
         _vid = vid;
         _mcTrack = mcTrack;
         _hit = 0;
-        _covmat.ResizeTo( 3, 3 );
         _covmat = covmat;
 
         // these are the sector ids mapped to layers
@@ -101,8 +126,8 @@ class FwdHit : public KiTrack::IHit {
     int _tid; // aka ID truth
     int _vid; // volume id
     unsigned int _id; // just a unique id for each hit in this event.
-    std::shared_ptr<McTrack> _mcTrack;
-    TMatrixDSym _covmat;
+    McTrack *_mcTrack;
+    FwdHitCov _covmat;
 
     StHit *_hit;
 };
@@ -142,26 +167,22 @@ class FwdConnector : public KiTrack::ISectorConnector {
 };                           // FwdConnector
 
 struct SeedQual {
-    inline double operator()(Seed_t s) { return double(s.size()) / FwdSystem::sNFttLayers ; } // seeds only use the 4 hits from Ftt
+    inline double operator()(const Seed_t &s) const { return double(s.size()) / FwdSystem::sNFttLayers ; } // seeds only use the 4 hits from Ftt
 };
 
 struct SeedCompare {
-    inline bool operator()(Seed_t trackA, Seed_t trackB) {
-        std::map<unsigned int, unsigned int> hit_counts;
+    inline bool operator()(const Seed_t &trackA, const Seed_t &trackB) const {
+        // seeds only have a handful of hits, so a direct comparison is
+        // cheaper than any lookup structure.
         // we are assuming that the same hit can never be used twice on a single
         // track!
-
-        for (auto h : trackA) {
-            hit_counts[static_cast<FwdHit *>(h)->_id]++;
-        }
-
-        // now look at the other track and see if it has the same hits in it
-        for (auto h : trackB) {
-            hit_counts[static_cast<FwdHit *>(h)->_id]++;
+        for (auto ha : trackA) {
+            const unsigned int id = static_cast<FwdHit *>(ha)->_id;
 
             // incompatible if they share a single hit
-            if (hit_counts[static_cast<FwdHit *>(h)->_id] >= 2) {
-                return false;
+            for (auto hb : trackB) {
+                if (static_cast<FwdHit *>(hb)->_id == id)
+                    return false;
             }
         }
 
@@ -0,0 +1,139 @@
+#ifndef FWD_HIT_INDEX_H
+#define FWD_HIT_INDEX_H
+
+#include "TMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "StFwdTrackMaker/include/Tracker/FwdHit.h"
+#include "StFwdTrackMaker/include/Tracker/FwdDataSource.h"
+
+/* Binned (r, phi) index over the hits on one disk
+ *
+ * Built once per event from a list of hits, the r and phi of each hit
+ * are computed only once. Queries return the hits within a window
+ * |dr| < dr and |dphi| < dphi (with the 2pi wrap handled) by only
+ * looking into the bins overlapping the window.
+ */
+class FwdHitIndex {
+  public:
+    FwdHitIndex() {}
+
+    /* build
+     * @param hits: the hits to index, the pointers must stay valid while the index is used
+     * @param rBinWidth: width of the r bins (cm), ideally close to the typical query window
+     * @param phiBinWidth: width of the phi bins (rad), ideally close to the typical query window
+     * @param usage: optional, hits marked as used are not indexed
+     */
+    void build( const Seed_t &hits, double rBinWidth, double phiBinWidth, const FwdHitUsage *usage = nullptr ) {
+        mEntries.clear();
+        mOffsets.clear();
+
+        mRBinWidth = rBinWidth > 0 ? rBinWidth : 1.0;
+        mNPhiBins = std::max( 1, (int)( 2 * TMath::Pi() / (phiBinWidth > 0 ? phiBinWidth : 0.1) ) );
+        mPhiBinWidth = 2 * TMath::Pi() / mNPhiBins;
+
+        mRMin = 0;
+        double rMax = 0;
+        mEntries.reserve( hits.size() );
+        for ( size_t i = 0; i < hits.size(); i++ ) {
+            if ( usage && usage->isUsed( hits[i] ) ) continue;
+            Entry e;
+            e.hit = hits[i];
+            e.order = i;
+            e.r = sqrt( hits[i]->getX() * hits[i]->getX() + hits[i]->getY() * hits[i]->getY() );
+            e.phi = atan2( hits[i]->getY(), hits[i]->getX() );
+            if ( mEntries.empty() || e.r < mRMin ) mRMin = e.r;
+            if ( e.r > rMax ) rMax = e.r;
+            mEntries.push_back( e );
+        }
+        mNRBins = (int)( (rMax - mRMin) / mRBinWidth ) + 1;
+
+        // sort the hits into their bins
+        for ( auto &e : mEntries )
+            e.bin = bin( rBin( e.r ), phiBin( e.phi ) );
+        std::stable_sort( mEntries.begin(), mEntries.end(), []( const Entry &a, const Entry &b ){ return a.bin < b.bin; } );
+
+        mOffsets.assign( (size_t)mNRBins * mNPhiBins + 1, 0 );
+        for ( auto &e : mEntries )
+            mOffsets[ e.bin + 1 ]++;
+        for ( size_t i = 1; i < mOffsets.size(); i++ )
+            mOffsets[i] += mOffsets[i - 1];
+    }
+
+    /* query
+     * @returns the hits with |r - probe_r| < dr and |phi - probe_phi| < dphi, in the order they were given to build
+     */
+    Seed_t query( double probe_r, double probe_phi, double dr, double dphi ) const {
+        Seed_t found_hits;
+        if ( mEntries.empty() )
+            return found_hits;
+
+        std::vector<const Entry *> found;
+        const int rLo = std::max( 0, rBin( probe_r - dr ) );
+        const int rHi = std::min( mNRBins - 1, rBin( probe_r + dr ) );
+        // number of phi bins needed on each side of the probe bin, never more than the full circle
+        const int nPhi = std::min( mNPhiBins / 2, (int)ceil( dphi / mPhiBinWidth ) );
+        const int pc = phiBin( probe_phi );
+
+        for ( int ir = rLo; ir <= rHi; ir++ ) {
+            for ( int dp = -nPhi; dp <= nPhi; dp++ ) {
+                if ( 2 * nPhi + 1 > mNPhiBins && dp == nPhi ) continue; // do not visit the same bin twice
+                const int ip = ( pc + dp + mNPhiBins ) % mNPhiBins;
+                const size_t b = bin( ir, ip );
+                for ( size_t k = mOffsets[b]; k < mOffsets[b + 1]; k++ ) {
+                    const Entry &e = mEntries[k];
+                    double mdphi = fabs( e.phi - probe_phi );
+                    if ( mdphi > TMath::Pi() ) mdphi = 2 * TMath::Pi() - mdphi; // handle 2pi edge
+                    if ( mdphi < dphi && fabs( e.r - probe_r ) < dr )
+                        found.push_back( &e );
+                }
+            }
+        }
+
+        // keep the original hit order so results do not depend on the binning
+        std::sort( found.begin(), found.end(), []( const Entry *a, const Entry *b ){ return a->order < b->order; } );
+        for ( auto e : found )
+            found_hits.push_back( e->hit );
+        return found_hits;
+    }
+
+    size_t size() const { return mEntries.size(); }
+
+  protected:
+    struct Entry {
+        KiTrack::IHit *hit;
+        size_t order; // index in the input list
+        size_t bin;
+        double r, phi;
+    };
+
+    int rBin( double r ) const {
+        if ( r < mRMin ) return -1;
+        return (int)( (r - mRMin) / mRBinWidth );
+    }
+    int phiBin( double phi ) const {
+        int ip = (int)( (phi + TMath::Pi()) / mPhiBinWidth );
+        if ( ip < 0 ) ip = 0;
+        if ( ip >= mNPhiBins ) ip = mNPhiBins - 1;
+        return ip;
+    }
+    size_t bin( int ir, int ip ) const {
+        if ( ir < 0 ) ir = 0;
+        if ( ir >= mNRBins ) ir = mNRBins - 1;
+        return (size_t)ir * mNPhiBins + ip;
+    }
+
+    double mRMin = 0;
+    double mRBinWidth = 1.0;
+    double mPhiBinWidth = 0.1;
+    int mNRBins = 0;
+    int mNPhiBins = 1;
+
+    std::vector<Entry> mEntries;  // hits sorted by bin
+    std::vector<size_t> mOffsets; // start of each bin in mEntries
+};
+
+#endif
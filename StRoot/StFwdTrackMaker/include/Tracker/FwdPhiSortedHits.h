@@ -0,0 +1,102 @@
+#ifndef FWD_PHI_SORTED_HITS_H
+#define FWD_PHI_SORTED_HITS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "StFwdTrackMaker/include/Tracker/FwdHit.h"
+#include "StFwdTrackMaker/include/Tracker/FwdDataSource.h"
+
+/* Hits of each layer sorted by phi
+ *
+ * Built once per tracking iteration, after which a phi slice is just an
+ * index range per layer (a View_t) found by binary search. The phi of
+ * each hit is computed only once, and the storage is reused between
+ * iterations and events.
+ */
+class FwdPhiSortedHits {
+  public:
+    struct Range {
+        size_t begin = 0, end = 0;
+        size_t size() const { return end - begin; }
+    };
+    using View_t = std::array<Range, FwdSystem::sNFwdLayers>;
+
+    /* build
+     * @param hitmap: the hits to sort, the pointers must stay valid while the views are used
+     * @param usage: optional, hits marked as used are left out
+     */
+    void build( const FwdDataSource::HitMap_t &hitmap, const FwdHitUsage *usage = nullptr ) {
+        for ( const auto &kv : hitmap ) {
+            std::vector<Entry> &layer = mLayers[kv.first];
+            layer.clear();
+            layer.reserve( kv.second.size() );
+            for ( KiTrack::IHit *hit : kv.second ) {
+                if ( usage && usage->isUsed( hit ) ) continue;
+                Entry e;
+                e.phi = atan2( hit->getY(), hit->getX() );
+                e.hit = hit;
+                layer.push_back( e );
+            }
+            // stable, so hits with equal phi keep the hitmap order
+            std::stable_sort( layer.begin(), layer.end(), []( const Entry &a, const Entry &b ){ return a.phi < b.phi; } );
+        }
+    }
+
+    // view over all of the hits
+    View_t all() const {
+        View_t view;
+        for ( size_t i = 0; i < mLayers.size(); i++ ) {
+            view[i].begin = 0;
+            view[i].end = mLayers[i].size();
+        }
+        return view;
+    }
+
+    // view over the hits with phi_min <= phi <= phi_max
+    View_t slice( double phi_min, double phi_max ) const {
+        View_t view;
+        for ( size_t i = 0; i < mLayers.size(); i++ ) {
+            const std::vector<Entry> &layer = mLayers[i];
+            auto lo = std::lower_bound( layer.begin(), layer.end(), phi_min, []( const Entry &e, double phi ){ return e.phi < phi; } );
+            auto hi = std::upper_bound( lo, layer.end(), phi_max, []( double phi, const Entry &e ){ return phi < e.phi; } );
+            view[i].begin = lo - layer.begin();
+            view[i].end = hi - layer.begin();
+        }
+        return view;
+    }
+
+    static size_t nHits( const View_t &view ) {
+        size_t n = 0;
+        for ( const auto &r : view )
+            n += r.size();
+        return n;
+    }
+
+    /* fill
+     * @brief copies the hits in the view into the std::map form that KiTrack::SegmentBuilder needs.
+     * Only non-empty layers are added. Safe to call concurrently for different outputs.
+     */
+    void fill( const View_t &view, FwdDataSource::SectorHitMap_t &outputMap ) const {
+        outputMap.clear();
+        for ( size_t i = 0; i < mLayers.size(); i++ ) {
+            if ( view[i].size() == 0 ) continue;
+            std::vector<KiTrack::IHit *> &hits = outputMap[i];
+            hits.reserve( view[i].size() );
+            for ( size_t k = view[i].begin; k < view[i].end; k++ )
+                hits.push_back( mLayers[i][k].hit );
+        }
+    }
+
+  protected:
+    struct Entry {
+        double phi;
+        KiTrack::IHit *hit;
+    };
+
+    std::array<std::vector<Entry>, FwdSystem::sNFwdLayers> mLayers;
+};
+
+#endif
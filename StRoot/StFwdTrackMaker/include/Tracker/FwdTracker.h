@@ -13,12 +13,18 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <string>
 #include <vector>
 #include <unordered_map>
 
 #include "StFwdTrackMaker/include/Tracker/FwdHit.h"
 #include "StFwdTrackMaker/include/Tracker/FwdDataSource.h"
+#include "StFwdTrackMaker/include/Tracker/FwdHitIndex.h"
+#include "StFwdTrackMaker/include/Tracker/FwdPhiSortedHits.h"
+#include "StFwdTrackMaker/include/Tracker/FwdTrackerParams.h"
+#include "StFwdTrackMaker/include/Tracker/SeedConflicts.h"
 #include "StFwdTrackMaker/include/Tracker/QualityPlotter.h"
 #include "StFwdTrackMaker/include/Tracker/TrackFitter.h"
 #include "StFwdTrackMaker/include/Tracker/BDTCriteria.h"
@@ -35,6 +41,7 @@
 
 #include "StFwdTrackMaker/FwdTrackerConfig.h"
 #include "StFwdTrackMaker/Common.h"
+#include "StarClassLibrary/StParallelFor.hh"
 
 // Utility class for evaluating ID and QA truth
 struct MCTruthUtils {
@@ -68,6 +75,10 @@ class ForwardTrackMaker {
     ForwardTrackMaker() : mConfigFile("config.xml"), mEventVertex(-999, -999, -999) {
         // noop
     }
+
+    virtual ~ForwardTrackMaker() {
+        clearIterationCriteria();
+    }
     
     const std::vector<Seed_t> &getRecoTracks() const { return mRecoTracks; }
     const std::vector<TVector3> &getFitMomenta() const { return mFitMoms; }
@@ -97,6 +108,41 @@ class ForwardTrackMaker {
 
         if (!mConfig.exists("TrackFitter"))
             mDoTrackFitting = false;
+
+        // compile the config into typed parameters, nothing below reads mConfig per event
+        mParams = FwdTrackerParams::load( mConfig );
+
+        buildIterationCriteria();
+    }
+
+    // Sets the number of track finding threads of all iterations (TrackFinder:nThreads)
+    // after initialize, only the criteria are rebuilt, not the geometry or the fitter
+    void setNThreads( size_t nThreads ) {
+        for ( auto &itp : mParams.iterations )
+            itp.nThreads = nThreads > 0 ? nThreads : 1;
+        buildIterationCriteria();
+    }
+
+    // build the criteria once, one set per thread of each iteration, and reuse them every event
+    void buildIterationCriteria() {
+        clearIterationCriteria();
+        mIterationCriteria.resize( mParams.iterations.size() );
+        for ( size_t i = 0; i < mParams.iterations.size(); i++ ){
+            FwdIterationParams &itp = mParams.iterations[i];
+            if ( mSaveCriteriaValues ){
+                // the saved criteria values only make sense for a single slice at a time
+                itp.nThreads = 1;
+            }
+            // the budget may use more slices than configured
+            size_t maxPhiSlices = mParams.budget.levelHits.empty() && mParams.budget.maxMs <= 0 ? itp.nPhiSlices : budgetPhiSlices( itp.nPhiSlices );
+            mIterationCriteria[i].resize( std::min( itp.nThreads, maxPhiSlices ) );
+            for ( auto &crits : mIterationCriteria[i] ){
+                crits.twoHit = loadCriteria( itp.segmentBuilderPath );
+                crits.threeHit = loadCriteria( itp.threeHitSegmentsPath );
+                if ( false == mParams.budget.threeHitSegmentsPath.empty() )
+                    crits.threeHitTight = loadCriteria( mParams.budget.threeHitSegmentsPath );
+            }
+        }
     }
 
 
@@ -161,6 +207,45 @@ class ForwardTrackMaker {
         return crits;
     }
 
+    // deletes criteria created by loadCriteria (CriteriaKeeper owns its child)
+    void clearCriteria( std::vector<KiTrack::ICriterion *> &crits ) {
+        for ( auto crit : crits )
+            delete crit;
+        crits.clear();
+    }
+
+    void clearIterationCriteria() {
+        mTwoHitCrit.clear();
+        mThreeHitCrit.clear();
+        for ( auto &sets : mIterationCriteria ){
+            for ( auto &crits : sets ){
+                clearCriteria( crits.twoHit );
+                clearCriteria( crits.threeHit );
+                clearCriteria( crits.threeHitTight );
+            }
+        }
+        mIterationCriteria.clear();
+    }
+
+    // phi slices used at the budget levels >= 1
+    size_t budgetPhiSlices( size_t nPhiSlices ) const {
+        return std::min<size_t>( nPhiSlices * mParams.budget.phiSliceFactor, 100 );
+    }
+
+    // forgets the values saved and the hits cached by reused criteria, so they only hold those of the current slice
+    void resetCriteriaValues( std::vector<KiTrack::ICriterion *> &crits ) {
+        for ( auto crit : crits ){
+            CriteriaKeeper *keeper = dynamic_cast<CriteriaKeeper *>( crit );
+            if ( keeper ){
+                keeper->clear();
+                crit = keeper->getChild();
+            }
+            BDTCrit2 *bdt = dynamic_cast<BDTCrit2 *>( crit );
+            if ( bdt )
+                bdt->clearHitCache();
+        }
+    }
+
     std::vector<float> getCriteriaValues(std::string crit_name) {
         std::vector<float> em;
         if (mSaveCriteriaValues != true) {
@@ -246,11 +331,15 @@ class ForwardTrackMaker {
         }
     }
 
+    // number of hits in the hitmap that are not used by a track yet
     size_t nHitsInHitMap(FwdDataSource::HitMap_t &hitmap) {
         size_t n = 0;
 
-        for (auto kv : hitmap) {
-            n += kv.second.size();
+        for (const auto &kv : hitmap) {
+            for (auto h : kv.second) {
+                if (false == mHitUsage.isUsed(h))
+                    n++;
+            }
         }
 
         return n;
@@ -287,14 +376,17 @@ class ForwardTrackMaker {
         mHist["Step2Duration"] = new TH1I("Step2Duration", ";Duration (ms)", 500, 0, 500);
         mHist["Step3Duration"] = new TH1I("Step3Duration", ";Duration (ms)", 500, 0, 500);
         mHist["Step4Duration"] = new TH1I("Step4Duration", ";Duration (ms)", 500, 0, 500);
+        mHist["BudgetLevel"] = new TH1I("BudgetLevel", ";Budget level;# iterations", FwdBudgetParams::sMaxLevel + 1, 0, FwdBudgetParams::sMaxLevel + 1);
     }
 
     void fillHistograms() {
 
         if (mGenHistograms && mDataSource != nullptr) {
-            auto hm = mDataSource->getFttHits();
-            for (auto hp : hm)
+            auto &hm = mDataSource->getFttHits();
+            for (const auto &hp : hm){
+                if ( hp.second.empty() ) continue; // layer not used
                 mHist["input_nhits"]->Fill(hp.second.size());
+            }
         }
     }
 
@@ -341,19 +433,17 @@ class ForwardTrackMaker {
         }
     }
 
+    /* removeHits
+     * Marks the hits of the tracks as used, later iterations skip them.
+     * The hitmap itself is left untouched.
+     */
     void removeHits(FwdDataSource::HitMap_t &hitmap, std::vector<Seed_t> &tracks) {
 
-        for (auto track : tracks) {
+        for (const auto &track : tracks) {
             for (auto hit : track) {
-                int sector = hit->getSector();
-
-                auto hitit = std::find(hitmap[sector].begin(), hitmap[sector].end(), hit);
-
-                if (hitit != hitmap[sector].end()) {
-                    hitmap[sector].erase(hitit);
+                if (mHitUsage.markUsed(hit)) {
                     mTotalHitsRemoved++;
                 }
-
             } // loop on hits in track
         }         // loop on track
     } // removeHits
@@ -387,6 +477,12 @@ class ForwardTrackMaker {
         }
 
         mTotalHitsRemoved = 0;
+        mHitUsage.reset( mDataSource->nHits() );
+        mEventStart = FwdTrackerUtils::nowNanoSecond();
+        mBudgetDecisions.clear();
+
+        // the field scale factor may change between runs
+        mTrackFitter->updateField();
 
         /*************************************************************/
         // Step 1
@@ -402,19 +498,14 @@ class ForwardTrackMaker {
             mHist["Step1Duration"]->Fill( duration );
 
 
-        bool mcTrackFinding = true;
-
-        if (mConfig.exists("TrackFinder"))
-            mcTrackFinding = false;
-
         /***********************************************/
         // MC Track Finding
-        if (mcTrackFinding) {
+        if (mParams.mcTrackFinding) {
             doMcTrackFinding(mcTrackMap);
 
             /***********************************************/
             // REFIT with Silicon hits
-            if (mConfig.get<bool>("TrackFitter:refitSi", true)) {
+            if (mParams.refitSi) {
                 addSiHitsMc();
             } else {
                 // skip Si refit
@@ -431,9 +522,7 @@ class ForwardTrackMaker {
         /***********************************************/
         // Standard Track Finding
         // plus initial fit
-        size_t nIterations = mConfig.get<size_t>("TrackFinder:nIterations", 0);
-
-        for (size_t iIteration = 0; iIteration < nIterations; iIteration++) {
+        for (size_t iIteration = 0; iIteration < mParams.iterations.size(); iIteration++) {
             doTrackIteration(iIteration, hitmap);
         }
         /***********************************************/
@@ -441,7 +530,7 @@ class ForwardTrackMaker {
 
         /***********************************************/
         // REFIT with Silicon hits
-        if (mConfig.get<bool>("TrackFitter:refitSi", true)) {
+        if (mParams.refitSi) {
             addSiHits();
         } else {
             // Skipping Si Refit
@@ -453,127 +542,108 @@ class ForwardTrackMaker {
         }
     } // doEvent
 
-    void trackFitting(Seed_t &track) {
+    /* fitTrackSeeds
+     * Fits a batch of track seeds (e.g. all seeds from one iteration).
+     * The per-seed preparation (MC truth, vertex) is done for the whole batch first,
+     * then the seeds are fit one after the other. The fits stay on one thread: GenFit's
+     * MaterialEffects is a process wide singleton that keeps state between steps, and
+     * StarMagField::Field keeps static search hints.
+     * The results are appended to mFitMoms, mGlobalTracks, ... in seed order.
+     */
+    void fitTrackSeeds(std::vector<Seed_t> &seeds) {
 
+        const size_t nSeeds = seeds.size();
         if ( mGenHistograms ){
-            mHist["FitStatus"]->Fill("Seeds", 1);
-        }
-
-        // Calculate the MC info first and check filters
-        int idt = 0;
-        double qual = 0;
-        idt = MCTruthUtils::dominantContribution(track, qual);
-        
-        
-
-
-        TVector3 mcSeedMom;
-
-        auto mctm = mDataSource->getMcTracks();
-        // get the MC track momentum if we can
-        if (mctm.count(idt)) {
-            auto mct = mctm[idt];
-            mcSeedMom.SetPtEtaPhi(mct->mPt, mct->mEta, mct->mPhi);
+            mHist["FitStatus"]->Fill("Seeds", nSeeds);
         }
 
+        if (!mDoTrackFitting || nSeeds == 0)
+            return;
 
-        // Mc Filter
-        bool bailout = false;
-        if (qual < mConfig.get<float>("TrackFitter.McFilter:quality-min", 0.0)) {
-            bailout = true;
-            // LOG_INFO << "BAIL OUT on Fit bc quality = " << qual << endm;
-        }
-        if (mctm.count(idt)) {
-            auto mct = mctm[idt];
-            mcSeedMom.SetPtEtaPhi(mct->mPt, mct->mEta, mct->mPhi);
-            if (mct->mPt < mConfig.get<float>("TrackFitter.McFilter:pt-min", 0.0) ||
-                mct->mPt > mConfig.get<float>("TrackFitter.McFilter:pt-max", 1e10)) {
-                bailout = true;
-                // LOG_INFO << "BAIL OUT on Fit bc Pt = " << mct->mPt << endm;
-            }
-            if (mct->mEta < mConfig.get<float>("TrackFitter.McFilter:eta-min", 0) ||
-                mct->mEta > mConfig.get<float>("TrackFitter.McFilter:eta-max", 1e10)) {
-                bailout = true;
-                // LOG_INFO << "BAIL OUT on Fit bc eta = " << mct->mEta << endm;
+        // Calculate the MC info first
+        std::vector<int> idts( nSeeds, 0 );
+        std::vector<double> quals( nSeeds, 0 );
+        std::vector<TVector3> mcSeedMoms( nSeeds );
+        // vertex used for each fit, either the event vertex or one drawn from the simulated distribution
+        std::vector<double> vertices( 3 * nSeeds, 0 );
+
+        auto &mctm = mDataSource->getMcTracks();
+        bool useEventVertex = fabs(mEventVertex.X()) < 100; // only use it if it has been set from default
+        for ( size_t i = 0; i < nSeeds; i++ ){
+            idts[i] = MCTruthUtils::dominantContribution(seeds[i], quals[i]);
+
+            // get the MC track momentum if we can
+            if (mctm.count(idts[i])) {
+                auto mct = mctm[idts[i]];
+                mcSeedMoms[i].SetPtEtaPhi(mct->mPt, mct->mEta, mct->mPhi);
             }
-            
-        } else {
-            // cannot find the track
-        }
 
-        // if ( bailout ){
+            // NOTE: the McFilter (TrackFitter.McFilter) is currently disabled, all seeds are fit
 
-        //     for ( KiTrack::IHit * h : track ){
-        //         FwdHit *fh = static_cast<FwdHit*>( h );
-        //         LOG_INFO << "Hit on Track from trackId: " << fh->_tid << endm;
-        //     }
-
-        // }
-
-
-        bailout = false;
-        // if (bailout)
-        //     return;
-        // Done with Mc Filter
-
-        TVector3 p;
-        p.SetPtEtaPhi( 0, -999, 0 );
-        genfit::FitStatus fitStatus;
-        
-        genfit::AbsTrackRep *trackRep = nullptr;//new genfit::RKTrackRep(211); // pdg for pi+
-        genfit::Track *genTrack = nullptr;//new genfit::Track( trackRep, TVector3(0, 0, 0), TVector3(0, 0, 0) );
-
-
-        if (mDoTrackFitting && !bailout) {
-            if ( mGenHistograms ){
-                mHist["FitStatus"]->Fill("AttemptFit", 1);
+            if ( useEventVertex ){
+                vertices[3*i + 0] = mEventVertex.X();
+                vertices[3*i + 1] = mEventVertex.Y();
+                vertices[3*i + 2] = mEventVertex.Z();
+            } else {
+                mTrackFitter->sampleVertex( &vertices[3*i] );
             }
+        }
 
-            double vertex[3] = { mEventVertex.X(), mEventVertex.Y(), mEventVertex.Z() };
+        bool useMcSeed = mParams.mcSeed;
 
-            double * pVertex = 0;
-            if ( fabs(mEventVertex.X()) < 100 ){
-                pVertex = vertex; // only use it if it has been set from default
-            }
+        std::vector<TVector3> moms( nSeeds );
+        std::vector<genfit::FitStatus> statuses( nSeeds );
+        std::vector<genfit::Track *> tracks( nSeeds, nullptr );
+        std::vector<genfit::AbsTrackRep *> reps( nSeeds, nullptr );
 
-            
-            if (true == mConfig.get<bool>("TrackFitter:mcSeed", false)) {
+        long long itStart = FwdTrackerUtils::nowNanoSecond();
+        for ( size_t i = 0; i < nSeeds; i++ ){
+            if ( useMcSeed ) {
                 // use the MC pt, eta, phi as the seed for fitting
-                p = mTrackFitter->fitTrack(track, pVertex, &mcSeedMom);
+                moms[i] = mTrackFitter->fitTrack(seeds[i], &vertices[3*i], &mcSeedMoms[i]);
             } else {
                 // Normal case, real data
-                p = mTrackFitter->fitTrack(track, pVertex);
+                moms[i] = mTrackFitter->fitTrack(seeds[i], &vertices[3*i]);
             }
 
+            // take ownership of the fit results, no need to copy them
+            statuses[i] = mTrackFitter->getStatus();
+            tracks[i] = mTrackFitter->releaseTrack();
+            reps[i] = mTrackFitter->releaseTrackRep();
+        }
+        long long duration = (FwdTrackerUtils::nowNanoSecond() - itStart) * 1e-6; // milliseconds
+        if ( mGenHistograms ){
+            this->mHist["FitDuration"]->Fill(duration);
+        }
+
+        // Save everything, in seed order
+        for ( size_t i = 0; i < nSeeds; i++ ){
+            TVector3 &p = moms[i];
+            genfit::Track *genTrack = tracks[i];
+            genTrack->setMcTrackId(idts[i]);
+
             if ( mGenHistograms ){
+                mHist["FitStatus"]->Fill("AttemptFit", 1);
                 if (p.Perp() > 1e-3) {
                     mHist["FitStatus"]->Fill("GoodFit", 1);
                 } else {
                     mHist["FitStatus"]->Fill("BadFit", 1);
                 }
-            }
 
-            // assign the fit results to be saved
-            fitStatus = mTrackFitter->getStatus();
-            genTrack = new genfit::Track(*mTrackFitter->getTrack());
-            trackRep = mTrackFitter->getTrackRep()->clone(); // Clone the track rep
-            genTrack->setMcTrackId(idt);
-            
-            if ( mGenHistograms && genTrack->getFitStatus(genTrack->getCardinalRep())->isFitConverged() && p.Perp() > 1e-3) {
-                mHist["FitStatus"]->Fill("GoodCardinal", 1);
+                if ( genTrack->getFitStatus(genTrack->getCardinalRep())->isFitConverged() && p.Perp() > 1e-3) {
+                    mHist["FitStatus"]->Fill("GoodCardinal", 1);
+                }
             }
 
-            // Save everything
             mFitMoms.push_back(p);
             mGlobalTracks.push_back(genTrack);
-            mGlobalTrackReps.push_back(trackRep);
-            mFitStatus.push_back(fitStatus);
-            mRecoTrackQuality.push_back(qual);
-            mRecoTrackIdTruth.push_back(idt);
+            mGlobalTrackReps.push_back(reps[i]);
+            mFitStatus.push_back(statuses[i]);
+            mRecoTrackQuality.push_back(quals[i]);
+            mRecoTrackIdTruth.push_back(idts[i]);
             mNumFstHits.push_back(0);
-            
-        } // if (mDoTrackFitting && !bailout)
-    }
+        }
+    } // fitTrackSeeds
 
     void doMcTrackFinding(FwdDataSource::McTrackMap_t &mcTrackMap) {
 
@@ -607,16 +677,8 @@ class ForwardTrackMaker {
             }
         }
 
-        long long itStart = FwdTrackerUtils::nowNanoSecond();
         // Fit each accepted track seed
-        for (auto t : mRecoTracks) {
-            trackFitting(t);
-        }
-        long long itEnd = FwdTrackerUtils::nowNanoSecond();
-        long long duration = (itEnd - itStart) * 1e-6; // milliseconds
-        if ( mGenHistograms ){
-            this->mHist["FitDuration"]->Fill(duration);
-        }
+        fitTrackSeeds( mRecoTracks );
 
         if ( mGenHistograms ){
             mQualityPlotter->afterIteration(0, mRecoTracks);
@@ -624,71 +686,35 @@ class ForwardTrackMaker {
     }
 
 
-    /**
-    * @brief Slices a hitmap into a phi section
-    * 
-    * @param inputMap INPUT hitmap to process
-    * @param outputMap OUTPUT hitmap, will be cleared and filled with only the hits from inputMap that are within phi region
-    * @param phi_min The minimum phi to accept
-    * @param phi_max The maximum Phi to accept
-    * 
-    * @returns The number of hits in the outputMap
-    */
-    size_t sliceHitMapInPhi( FwdDataSource::HitMap_t &inputMap, FwdDataSource::HitMap_t &outputMap, float phi_min, float phi_max ){
-        size_t n_hits_kept = 0;
-
-        outputMap.clear(); // child STL containers will get cleared too
-        for ( auto kv : inputMap ){
-            for ( KiTrack::IHit* hit : kv.second ){
-                TVector3 vec(hit->getX(), hit->getY(), hit->getZ() );
-                if ( vec.Phi() < phi_min || vec.Phi() > phi_max ) continue;
-
-                // now add the hits to the sliced map
-                outputMap[kv.first].push_back( hit );
-                n_hits_kept ++;
-            } // loop on hits
-        } // loop on map
-        return n_hits_kept;
-    }
-
     /*doTrackingOnHitmapSubset
      * @brief Does track finding steps on a subset of hits (phi slice)
-     * @param iIteration: tracking iteration (for determining params)
+     * May be called concurrently for different slices, so it only touches
+     * the hitmap and criteria it is given (plus mutex protected histograms)
+     * @param params: parameters of the tracking iteration
      * @param hitmap: the hitmap to use, should already be subset of original
+     * @param crits: the criteria to use, not shared with any other concurrent call
+     * @param budget: the budget decision for the iteration
+     * @param step3Overrun: OUTPUT, set if the three hit step was too slow and the greedy subset selection was used
      * @returns a list of track seeds
      */
-    vector<Seed_t> doTrackingOnHitmapSubset( size_t iIteration, FwdDataSource::HitMap_t &hitmap  ) {
+    vector<Seed_t> doTrackingOnHitmapSubset( const FwdIterationParams &params, FwdDataSource::SectorHitMap_t &hitmap, CriteriaSet &crits, const FwdBudgetDecision &budget, bool &step3Overrun ) {
         long long itStart = FwdTrackerUtils::nowNanoSecond();
         /*************************************************************/
         // Step 2
         // build 2-hit segments (setup parent child relationships)
         /*************************************************************/
         // Initialize the segment builder with sorted hits
-        KiTrack::SegmentBuilder builder(hitmap);
+        // (the hitmap is not needed after this, let the builder take it over)
+        KiTrack::SegmentBuilder builder(std::move(hitmap));
 
-        // Load the criteria used for 2-hit segments
-        // This loads from XML config if available
-        std::string criteriaPath = "TrackFinder.Iteration[" + std::to_string(iIteration) + "].SegmentBuilder";
-
-        if (false == mConfig.exists(criteriaPath)) {
-            // Use the default for all iterations if it is given.
-            // If not then no criteria will be applied
-            criteriaPath = "TrackFinder.SegmentBuilder";
-        }
-
-        mTwoHitCrit.clear();
-        mTwoHitCrit = loadCriteria(criteriaPath);
-        builder.addCriteria(mTwoHitCrit);
+        // The criteria used for 2-hit segments (built from the XML config at initialize)
+        std::vector<KiTrack::ICriterion *> &threeHitCrit = budget.tightCriteria ? crits.threeHitTight : crits.threeHit;
+        resetCriteriaValues(crits.twoHit);
+        resetCriteriaValues(threeHitCrit);
+        builder.addCriteria(crits.twoHit);
 
         // Setup the connector (this tells it how to connect hits together into segments)
-        std::string connPath = "TrackFinder.Iteration[" + std::to_string(iIteration) + "].Connector";
-
-        if (false == mConfig.exists(connPath))
-            connPath = "TrackFinder.Connector";
-
-        unsigned int distance = mConfig.get<unsigned int>(connPath + ":distance", 1);
-        
-        FwdConnector connector(distance);
+        FwdConnector connector(params.connectorDistance);
         builder.addSectorConnector(&connector);
 
         // Get the segments and return an automaton object for further work
@@ -700,8 +726,10 @@ class ForwardTrackMaker {
         // we can apply an optional parameter <nHits> to only get tracks with >=nHits in them
 
         long long duration = (FwdTrackerUtils::nowNanoSecond() - itStart) * 1e-6; // milliseconds
-        if (mGenHistograms)
+        if (mGenHistograms){
+            std::lock_guard<std::mutex> lock( mHistMutex );
             mHist["Step2Duration"]->Fill( duration );
+        }
         itStart = FwdTrackerUtils::nowNanoSecond();
 
         /*************************************************************/
@@ -710,18 +738,11 @@ class ForwardTrackMaker {
         /*************************************************************/
         automaton.clearCriteria();
         automaton.resetStates();
-        criteriaPath = "TrackFinder.Iteration[" + std::to_string(iIteration) + "].ThreeHitSegments";
-
-        if (false == mConfig.exists(criteriaPath))
-            criteriaPath = "TrackFinder.ThreeHitSegments";
-
-        mThreeHitCrit.clear();
-        mThreeHitCrit = loadCriteria(criteriaPath);
-        automaton.addCriteria(mThreeHitCrit);
+        automaton.addCriteria(threeHitCrit);
         automaton.lengthenSegments();
 
-        bool doAutomation = mConfig.get<bool>(criteriaPath + ":doAutomation", true);
-        bool doCleanBadStates = mConfig.get<bool>(criteriaPath + ":cleanBadStates", true);
+        bool doAutomation = params.doAutomation;
+        bool doCleanBadStates = params.cleanBadStates;
 
         if (doAutomation) {
             automaton.doAutomaton();
@@ -734,67 +755,83 @@ class ForwardTrackMaker {
         }
 
         duration = (FwdTrackerUtils::nowNanoSecond() - itStart) * 1e-6; // milliseconds
-        if (mGenHistograms)
+        if (mGenHistograms){
+            std::lock_guard<std::mutex> lock( mHistMutex );
             mHist["Step3Duration"]->Fill( duration );
-        if (duration > 200){
-            LOG_WARN << "The Three Hit Criteria took more than 200ms to process, duration: " << duration << " ms" << endm;
-            LOG_WARN << "bailing out" << endm;
-            std::vector<Seed_t> acceptedTracks;
-            return acceptedTracks;
+        }
+        // keep the tracks, but do not risk the O(N^2) subset selection after a slow three hit step
+        step3Overrun = duration > mParams.budget.step3MaxMs;
+        if (step3Overrun){
+            std::lock_guard<std::mutex> lock( mHistMutex );
+            LOG_WARN << "The Three Hit Criteria took more than " << mParams.budget.step3MaxMs << "ms to process, duration: " << duration << " ms" << endm;
+            LOG_WARN << "using greedy subset selection" << endm;
         }
         itStart = FwdTrackerUtils::nowNanoSecond();
         /*************************************************************/
         // Step 4
         // Get the tracks from the possible tracks that are the best subset
         /*************************************************************/
-        std::string subsetPath = "TrackFinder.Iteration[" + std::to_string(iIteration) + "].SubsetNN";
-
-        if (false == mConfig.exists(subsetPath))
-            subsetPath = "TrackFinder.SubsetNN";
-
         //  only for debug really
-        bool findSubsets = mConfig.get<bool>(subsetPath + ":active", true);
+        bool findSubsets = params.findSubsets;
         std::vector<Seed_t> acceptedTracks;
         std::vector<Seed_t> rejectedTracks;
 
         if (findSubsets) {
-            size_t minHitsOnTrack = mConfig.get<size_t>(subsetPath + ":min-hits-on-track", 7);
             // Getting all tracks with at least minHitsOnTrack hits on them
-            std::vector<Seed_t> tracks = automaton.getTracks(minHitsOnTrack);
+            std::vector<Seed_t> tracks = automaton.getTracks(params.minHitsOnTrack);
 
-            float omega = mConfig.get<float>(subsetPath + ".Omega", 0.75);
-            float stableThreshold = mConfig.get<float>(subsetPath + ".StableThreshold", 0.1);
-            float Ti = mConfig.get<float>(subsetPath + ".InitialTemp", 2.1);
-            float Tf = mConfig.get<float>(subsetPath + ".InfTemp", 0.1);
+            float omega = params.omega;
+            float stableThreshold = params.stableThreshold;
+            float Ti = params.initialTemp;
+            float Tf = params.infTemp;
 
-            KiTrack::SubsetHopfieldNN<Seed_t> subset;
-            subset.add(tracks);
-            subset.setOmega(omega);
-            subset.setLimitForStable(stableThreshold);
-            subset.setTStart(Ti);
-            subset.setTInf(Tf);
+            // the network is O(N^2) in time and memory, above this many candidates use a greedy selection instead
+            size_t maxCandidates = params.maxCandidates;
 
-            SeedCompare comparer;
-            SeedQual quality;
+            if (tracks.size() > maxCandidates || budget.greedy || step3Overrun) {
+                if (tracks.size() > maxCandidates) {
+                    std::lock_guard<std::mutex> lock( mHistMutex );
+                    LOG_WARN << "Greedy subset selection for " << tracks.size() << " candidates (max-candidates = " << maxCandidates << ")" << endm;
+                }
+                acceptedTracks = greedySeedSubset(tracks);
+            } else {
+                // the network works on indices into tracks, with the conflicts between them computed once
+                std::vector<size_t> trackIndices(tracks.size());
+                std::iota(trackIndices.begin(), trackIndices.end(), 0);
 
-            subset.calculateBestSet(comparer, quality);
+                KiTrack::SubsetHopfieldNN<size_t> subset;
+                subset.add(trackIndices);
+                subset.setOmega(omega);
+                subset.setLimitForStable(stableThreshold);
+                subset.setTStart(Ti);
+                subset.setTInf(Tf);
 
-            acceptedTracks = subset.getAccepted();
+                SeedConflictMatrix conflicts(tracks);
+                SeedIndexCompare comparer(conflicts);
+                SeedIndexQual quality(tracks);
+
+                subset.calculateBestSet(comparer, quality);
+
+                for (size_t index : subset.getAccepted())
+                    acceptedTracks.push_back(tracks[index]);
+            }
 
             // this call takes a long time due to possible huge combinatorics.
             // rejectedTracks = subset.getRejected();
             // LOG_DEBUG << "We had " << tracks.size() << " tracks. Accepted = " << acceptedTracks.size() << ", Rejected = " << rejectedTracks.size() << endm;
 
         } else { // the subset and hit removal
-            size_t minHitsOnTrack = mConfig.get<size_t>(subsetPath + ":min-hits-on-track", FwdSystem::sNFttLayers);
-            acceptedTracks = automaton.getTracks(minHitsOnTrack);
+            acceptedTracks = automaton.getTracks(params.minHitsOnTrack);
         }// subset off
 
         duration = (FwdTrackerUtils::nowNanoSecond() - itStart) * 1e-6; // milliseconds
-        if (mGenHistograms)
+        if (mGenHistograms){
+            std::lock_guard<std::mutex> lock( mHistMutex );
             mHist["Step4Duration"]->Fill( duration );
-        if (duration > 500){
-            LOG_WARN << "The took more than 500ms to process, duration: " << duration << " ms" << endm;
+        }
+        if (duration > mParams.budget.step4WarnMs){
+            std::lock_guard<std::mutex> lock( mHistMutex );
+            LOG_WARN << "The subset selection took more than " << mParams.budget.step4WarnMs << "ms to process, duration: " << duration << " ms" << endm;
             LOG_WARN << "We got " << acceptedTracks.size() << " tracks this round" << endm;
         }
         return acceptedTracks;
@@ -819,68 +856,109 @@ class ForwardTrackMaker {
         }
 
 
-        if ( false ) { // no phi slicing!
-            /*************************************************************/
-            // Steps 2 - 4 here
-            /*************************************************************/
-            auto acceptedTracks = doTrackingOnHitmapSubset( iIteration, hitmap );
-            mRecoTracksThisItertion.insert( mRecoTracksThisItertion.end(), acceptedTracks.begin(), acceptedTracks.end() );
-        } else {
+        const FwdIterationParams &params = mParams.iterations[iIteration];
+        std::vector<CriteriaSet> &critsPerThread = mIterationCriteria[iIteration];
+
+        // degrade the track finding of busy events according to the budget
+        FwdBudgetDecision budget;
+        budget.iteration = iIteration;
+        budget.nHits = nHitsThisIteration;
+        budget.elapsedMs = (FwdTrackerUtils::nowNanoSecond() - mEventStart) * 1e-6;
+        budget.level = mParams.budget.level( budget.nHits, budget.elapsedMs );
+        budget.nPhiSlices = budget.level >= 1 ? budgetPhiSlices( params.nPhiSlices ) : params.nPhiSlices;
+        budget.tightCriteria = budget.level >= 2 && false == mParams.budget.threeHitSegmentsPath.empty();
+        budget.greedy = budget.level >= 3;
 
-            FwdDataSource::HitMap_t slicedHitMap;
-            std::string pslPath = "TrackFinder.Iteration["+ std::to_string(iIteration) + "]:nPhiSlices";
-            if ( false == mConfig.exists( pslPath ) ) pslPath = "TrackFinder:nPhiSlices";
-            size_t phi_slice_count = mConfig.get<size_t>( pslPath, 1 );
+        size_t phi_slice_count = budget.nPhiSlices;
 
-            if ( phi_slice_count == 0 || phi_slice_count > 100 ){
-                LOG_WARN << "Invalid phi_slice_count = " << phi_slice_count << ", resetting to 1" << endm;
-                phi_slice_count= 1;
+        // number of threads used to process the phi slices concurrently, each uses its own criteria
+        size_t nThreads = critsPerThread.size();
+
+        /*************************************************************/
+        // Step 1A
+        // Slice the hitmap into phi sections if needed
+        // The hits are sorted in phi once, so each slice is just a range
+        // of that storage. Check that we arent wasting time on empty sections
+        /*************************************************************/
+        mPhiSortedHits.build( hitmap, &mHitUsage );
+        std::vector<FwdPhiSortedHits::View_t> sliceViews( phi_slice_count );
+        std::vector<bool> sliceActive( phi_slice_count, false );
+        float phi_slice = 2 * TMath::Pi() / (float) phi_slice_count;
+        for ( size_t phi_slice_index = 0; phi_slice_index < phi_slice_count; phi_slice_index++ ){
+
+            float phi_min = phi_slice_index * phi_slice - TMath::Pi();
+            float phi_max = (phi_slice_index + 1) * phi_slice - TMath::Pi();
+
+            if ( phi_slice_count > 1 ){
+                sliceViews[phi_slice_index] = mPhiSortedHits.slice( phi_min, phi_max );
+            } else { // no need to slice
+                sliceViews[phi_slice_index] = mPhiSortedHits.all();
             }
+            // nothing to do for slices with less than 4 hits
+            sliceActive[phi_slice_index] = FwdPhiSortedHits::nHits( sliceViews[phi_slice_index] ) >= 4;
+        } // loop on phi slices
 
-            float phi_slice = 2 * TMath::Pi() / (float) phi_slice_count;
-            for ( size_t phi_slice_index = 0; phi_slice_index < phi_slice_count; phi_slice_index++ ){
-
-                float phi_min = phi_slice_index * phi_slice - TMath::Pi();
-                float phi_max = (phi_slice_index + 1) * phi_slice - TMath::Pi();
-
-                /*************************************************************/
-                // Step 1A
-                // Slice the hitmap into a phi section if needed
-                // If we do that, check again that we arent wasting time on empty sections
-                /*************************************************************/
-                size_t nHitsThisSlice = 0;
-                if ( phi_slice_count > 1 ){
-                    nHitsThisSlice = sliceHitMapInPhi( hitmap, slicedHitMap, phi_min, phi_max );
-                    if ( nHitsThisSlice < 4 ) {
-                        continue;
-                    }
-                } else { // no need to slice
-                    // I think this incurs a copy, maybe we can find a way to avoid.
-                    slicedHitMap = hitmap;
-                }
-                
-                /*************************************************************/
-                // Steps 2 - 4 here
-                /*************************************************************/
-                auto acceptedTracks = doTrackingOnHitmapSubset( iIteration, slicedHitMap );
-                mRecoTracksThisItertion.insert( mRecoTracksThisItertion.end(), acceptedTracks.begin(), acceptedTracks.end() );
-            } //loop on phi slices
-        }// if loop on phi slices
+        /*************************************************************/
+        // Steps 2 - 4 here, each slice is independent
+        // Results are stored per slice and merged in slice order below,
+        // so the output does not depend on the number of threads
+        /*************************************************************/
+        std::vector<std::vector<Seed_t>> acceptedTracksPerSlice( phi_slice_count );
+        // the criteria set that each slice ran with
+        std::vector<CriteriaSet *> critsPerSlice( phi_slice_count, nullptr );
+        std::vector<char> step3OverrunPerSlice( phi_slice_count, 0 );
+
+        StParallelFor( phi_slice_count, nThreads, [&]( size_t phi_slice_index, size_t worker ){
+            if ( false == sliceActive[phi_slice_index] )
+                return;
+            try {
+                // KiTrack wants the hits as a std::map, which is only made here
+                FwdDataSource::SectorHitMap_t slicedHitMap;
+                mPhiSortedHits.fill( sliceViews[phi_slice_index], slicedHitMap );
+                critsPerSlice[phi_slice_index] = &critsPerThread[worker];
+                bool step3Overrun = false;
+                acceptedTracksPerSlice[phi_slice_index] = doTrackingOnHitmapSubset( params, slicedHitMap, critsPerThread[worker], budget, step3Overrun );
+                step3OverrunPerSlice[phi_slice_index] = step3Overrun;
+            } catch ( std::exception &e ) {
+                std::lock_guard<std::mutex> lock( mHistMutex );
+                LOG_ERROR << "Track finding failed in phi slice " << phi_slice_index << ": " << e.what() << endm;
+            }
+        } );
+
+        // keep the criteria from the last slice that ran for the saved values, as before
+        mTwoHitCrit.clear();
+        mThreeHitCrit.clear();
+        for ( size_t phi_slice_index = 0; phi_slice_index < phi_slice_count; phi_slice_index++ ){
+            mRecoTracksThisItertion.insert( mRecoTracksThisItertion.end(), acceptedTracksPerSlice[phi_slice_index].begin(), acceptedTracksPerSlice[phi_slice_index].end() );
+
+            if ( critsPerSlice[phi_slice_index] ){
+                mTwoHitCrit = critsPerSlice[phi_slice_index]->twoHit;
+                mThreeHitCrit = budget.tightCriteria ? critsPerSlice[phi_slice_index]->threeHitTight : critsPerSlice[phi_slice_index]->threeHit;
+            }
+            if ( step3OverrunPerSlice[phi_slice_index] )
+                budget.nStep3Overruns++;
+        }
+
+        // record what the budget did to this event
+        mBudgetDecisions.push_back( budget );
+        if ( budget.level > 0 || budget.nStep3Overruns > 0 ){
+            LOG_INFO << "Track finding budget, iteration " << iIteration << ": " << budget.nHits << " hits, " << budget.elapsedMs << " ms elapsed -> level " << budget.level
+                     << " (" << budget.nPhiSlices << " phi slices" << (budget.tightCriteria ? ", tight criteria" : "") << (budget.greedy ? ", greedy subsets" : "")
+                     << "), " << budget.nStep3Overruns << " slow slices" << endm;
+        }
+        if ( mGenHistograms ){
+            mHist["BudgetLevel"]->Fill( budget.level );
+        }
 
         /*************************************************************/
         // Step 5
         // Remove the hits from any track that was found
         /*************************************************************/
-        std::string hrmPath = "TrackFinder.Iteration["+ std::to_string(iIteration) + "].HitRemover";
-        if ( false == mConfig.exists( hrmPath ) ) hrmPath = "TrackFinder.HitRemover";
-
-        if ( true == mConfig.get<bool>( hrmPath + ":active", true ) ){
+        if ( params.removeHits ){
             removeHits( hitmap, mRecoTracksThisItertion );
         }
 
-        for (auto t : mRecoTracksThisItertion) {
-            trackFitting(t);
-        }
+        fitTrackSeeds( mRecoTracksThisItertion );
 
         if ( mGenHistograms ){
             mQualityPlotter->afterIteration( iIteration, mRecoTracksThisItertion );
@@ -892,7 +970,7 @@ class ForwardTrackMaker {
     } // doTrackIteration
 
     void addSiHitsMc() {
-        FwdDataSource::HitMap_t hitmap = mDataSource->getFstHits();
+        FwdDataSource::HitMap_t &hitmap = mDataSource->getFstHits();
 
         for (size_t i = 0; i < mGlobalTracks.size(); i++) {
 
@@ -909,6 +987,8 @@ class ForwardTrackMaker {
 
             for (size_t j = 0; j < 3; j++) {
                 for (auto h0 : hitmap[j]) {
+                    if (mHitUsage.isUsed(h0))
+                        continue;
                     if (dynamic_cast<FwdHit *>(h0)->_tid == mGlobalTracks[i]->getMcTrackId()) {
                         si_hits_for_this_track[j] = h0;
                         break;
@@ -954,7 +1034,13 @@ class ForwardTrackMaker {
     }         // ad Si hits via MC associations
 
     void addSiHits() {
-        FwdDataSource::HitMap_t hitmap = mDataSource->getFstHits();
+        FwdDataSource::HitMap_t &hitmap = mDataSource->getFstHits();
+
+        // index the hits on each disk once, instead of scanning all of them for every track
+        FwdHitIndex siHitIndex[FwdSystem::sNFstLayers];
+        for ( int i = 0; i < FwdSystem::sNFstLayers; i++ ){
+            siHitIndex[i].build( hitmap[i], mSiHitWindowR, mSiHitWindowPhi, &mHitUsage );
+        }
 
         // loop on global tracks
         for (size_t i = 0; i < mGlobalTracks.size(); i++) {
@@ -976,9 +1062,9 @@ class ForwardTrackMaker {
                 auto msp0 = mTrackFitter->projectToFst(0, mGlobalTracks[i]);
 
                 // now look for Si hits near these
-                hits_near_disk2 = findSiHitsNearMe(hitmap[2], msp2);
-                hits_near_disk1 = findSiHitsNearMe(hitmap[1], msp1);
-                hits_near_disk0 = findSiHitsNearMe(hitmap[0], msp0);
+                hits_near_disk2 = findSiHitsNearMe(siHitIndex[2], msp2);
+                hits_near_disk1 = findSiHitsNearMe(siHitIndex[1], msp1);
+                hits_near_disk0 = findSiHitsNearMe(siHitIndex[0], msp0);
             } catch (genfit::Exception &e) {
                 // Failed to project to Si disk: ", e.what()
             }
@@ -1043,45 +1129,44 @@ class ForwardTrackMaker {
         } // loop on globals
     }     // addSiHits
 
-    Seed_t findSiHitsNearMe(Seed_t &available_hits, genfit::MeasuredStateOnPlane &msp, double dphi = 0.004 * 9.5, double dr = 2.75) {
+    Seed_t findSiHitsNearMe(const FwdHitIndex &available_hits, genfit::MeasuredStateOnPlane &msp, double dphi = mSiHitWindowPhi, double dr = mSiHitWindowR) {
         double probe_phi = TMath::ATan2(msp.getPos().Y(), msp.getPos().X());
         double probe_r = sqrt(pow(msp.getPos().X(), 2) + pow(msp.getPos().Y(), 2));
 
-        Seed_t found_hits;
-
-        for (auto h : available_hits) {
-            double h_phi = TMath::ATan2(h->getY(), h->getX());
-            double h_r = sqrt(pow(h->getX(), 2) + pow(h->getY(), 2));
-            double mdphi = fabs(h_phi - probe_phi);
-            
-            if ( mdphi < dphi && fabs( h_r - probe_r ) < dr) { // handle 2pi edge
-                found_hits.push_back(h);
-            }
-        }
-
-        return found_hits;
+        return available_hits.query( probe_r, probe_phi, dr, dphi );
     }
 
     bool getSaveCriteriaValues() { return mSaveCriteriaValues; }
+    const std::vector<FwdBudgetDecision> &getBudgetDecisions() const { return mBudgetDecisions; }
     std::vector<KiTrack::ICriterion *> getTwoHitCriteria() { return mTwoHitCrit; }
     std::vector<KiTrack::ICriterion *> getThreeHitCriteria() { return mThreeHitCrit; }
 
     TrackFitter *getTrackFitter() { return mTrackFitter; }
+    // histogram by name, nullptr if it does not exist (only made if histograms are generated)
+    TH1 *getHistogram( const std::string &name ) { return mHist.count( name ) ? mHist[name] : nullptr; }
     void setEventVertex( TVector3 v ) { mEventVertex = v; }
 
   protected:
     unsigned long long int nEvents;
 
     bool mDoTrackFitting = true;
+
+    // window used to associate FST hits to the projection of a track
+    static constexpr double mSiHitWindowPhi = 0.004 * 9.5;
+    static constexpr double mSiHitWindowR = 2.75;
     bool mSaveCriteriaValues = true;
 
     FwdTrackerConfig mConfig;
     std::string mConfigFile;
     size_t mTotalHitsRemoved;
+    // hits used by the tracks found so far this event
+    FwdHitUsage mHitUsage;
     
 
     std::vector<Seed_t> mRecoTracks; // the tracks recod from all iterations
     std::vector<Seed_t> mRecoTracksThisItertion;
+    // phi sorted view of the hits for slicing, rebuilt every iteration
+    FwdPhiSortedHits mPhiSortedHits;
 
     // Set to the Primary vertex for the event
     TVector3 mEventVertex;
@@ -1101,9 +1186,29 @@ class ForwardTrackMaker {
 
     TrackFitter *mTrackFitter = nullptr;
 
+    // the config compiled at initialize
+    FwdTrackerParams mParams;
+
+    // start of the current event and the budget decisions made so far, one per iteration
+    long long mEventStart = 0;
+    std::vector<FwdBudgetDecision> mBudgetDecisions;
+
+    // criteria of one phi slice thread, built once at initialize
+    struct CriteriaSet {
+        std::vector<KiTrack::ICriterion *> twoHit;
+        std::vector<KiTrack::ICriterion *> threeHit;
+        std::vector<KiTrack::ICriterion *> threeHitTight; // TrackFinder.Budget.ThreeHitSegments, if given
+    };
+    // [iteration][thread], owns the criteria
+    std::vector<std::vector<CriteriaSet>> mIterationCriteria;
+
+    // the criteria of the last slice that ran, for the saved values (not owned)
     std::vector<KiTrack::ICriterion *> mTwoHitCrit;
     std::vector<KiTrack::ICriterion *> mThreeHitCrit;
 
+    // guards histograms and logging from the phi slice worker threads
+    std::mutex mHistMutex;
+
     // histograms of the raw input data
     bool mGenHistograms = false; // controls these histograms and use of QualityPlotter
     std::map<std::string, TH1 *> mHist;
@@ -1112,4 +1217,50 @@ class ForwardTrackMaker {
     
 };
 
+//  Wrapper class around the forward tracker
+class ForwardTracker : public ForwardTrackMaker {
+  public:
+    // Replaces original initialization.  Config file and hitloader
+    // will be provided by the maker (or the replay, see StFwdTrackReplay).
+    void initialize( bool genHistograms ) {
+        LOG_INFO << "ForwardTracker::initialize()" << endm;
+        nEvents = 1; // only process single event
+
+        // Create the forward system...
+        FwdSystem::sInstance = new FwdSystem();
+
+        // make our quality plotter
+        mQualityPlotter = new QualityPlotter(mConfig);
+        mQualityPlotter->makeHistograms(mConfig.get<size_t>("TrackFinder:nIterations", 1));
+
+        // initialize the track fitter
+        mTrackFitter = new TrackFitter(mConfig);
+        mTrackFitter->setGenerateHistograms(genHistograms);
+        mTrackFitter->setup();
+
+        ForwardTrackMaker::initialize( genHistograms );
+    }
+
+    void finish() {
+
+        if ( mGenHistograms ){
+            mQualityPlotter->finish();
+            writeEventHistograms();
+        }
+
+        if (FwdSystem::sInstance){
+            delete FwdSystem::sInstance;
+            FwdSystem::sInstance = 0;
+        }
+        if (mQualityPlotter){
+            delete mQualityPlotter;
+            mQualityPlotter = 0;
+        }
+        if (mTrackFitter){
+            delete mTrackFitter;
+            mTrackFitter= 0;
+        }
+    }
+};
+
 #endif
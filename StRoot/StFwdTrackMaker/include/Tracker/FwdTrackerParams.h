@@ -0,0 +1,167 @@
+#ifndef FWD_TRACKER_PARAMS_H
+#define FWD_TRACKER_PARAMS_H
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "St_base/StMessMgr.h"
+
+#include "StFwdTrackMaker/FwdTrackerConfig.h"
+#include "StFwdTrackMaker/include/Tracker/FwdHit.h"
+
+/* Typed snapshot of the track finding parameters of one iteration
+ *
+ * Read from the FwdTrackerConfig once (at initialize), so the per event and
+ * per phi slice code does no path building, map lookups or string parsing.
+ * Each value falls back from TrackFinder.Iteration[i].X to TrackFinder.X
+ * exactly as the per event lookups did.
+ */
+struct FwdIterationParams {
+    // config paths of the criteria lists, the criteria are built from these once
+    std::string segmentBuilderPath;
+    std::string threeHitSegmentsPath;
+
+    unsigned int connectorDistance = 1;
+
+    bool doAutomation = true;
+    bool cleanBadStates = true;
+
+    // SubsetNN
+    bool findSubsets = true;
+    size_t minHitsOnTrack = 7;
+    float omega = 0.75;
+    float stableThreshold = 0.1;
+    float initialTemp = 2.1;
+    float infTemp = 0.1;
+    size_t maxCandidates = 3000;
+
+    size_t nPhiSlices = 1;
+    size_t nThreads = 1;
+
+    bool removeHits = true;
+
+    static FwdIterationParams load( const FwdTrackerConfig &cfg, size_t iIteration ) {
+        FwdIterationParams p;
+        const std::string iterPath = "TrackFinder.Iteration[" + std::to_string( iIteration ) + "]";
+
+        // the iteration's own node if it exists, else the default for all iterations
+        auto node = [&]( const std::string &name ) {
+            return cfg.exists( iterPath + name ) ? iterPath + name : "TrackFinder" + name;
+        };
+
+        p.segmentBuilderPath = node( ".SegmentBuilder" );
+        p.connectorDistance = cfg.get<unsigned int>( node( ".Connector" ) + ":distance", 1 );
+
+        p.threeHitSegmentsPath = node( ".ThreeHitSegments" );
+        p.doAutomation = cfg.get<bool>( p.threeHitSegmentsPath + ":doAutomation", true );
+        p.cleanBadStates = cfg.get<bool>( p.threeHitSegmentsPath + ":cleanBadStates", true );
+
+        const std::string subsetPath = node( ".SubsetNN" );
+        p.findSubsets = cfg.get<bool>( subsetPath + ":active", true );
+        p.minHitsOnTrack = cfg.get<size_t>( subsetPath + ":min-hits-on-track", p.findSubsets ? 7 : FwdSystem::sNFttLayers );
+        p.omega = cfg.get<float>( subsetPath + ".Omega", 0.75 );
+        p.stableThreshold = cfg.get<float>( subsetPath + ".StableThreshold", 0.1 );
+        p.initialTemp = cfg.get<float>( subsetPath + ".InitialTemp", 2.1 );
+        p.infTemp = cfg.get<float>( subsetPath + ".InfTemp", 0.1 );
+        p.maxCandidates = cfg.get<size_t>( subsetPath + ":max-candidates", 3000 );
+
+        p.nPhiSlices = cfg.get<size_t>( node( ":nPhiSlices" ), 1 );
+        if ( p.nPhiSlices == 0 || p.nPhiSlices > 100 ){
+            LOG_WARN << "Invalid phi_slice_count = " << p.nPhiSlices << ", resetting to 1" << endm;
+            p.nPhiSlices = 1;
+        }
+        p.nThreads = cfg.get<size_t>( node( ":nThreads" ), 1 );
+        if ( p.nThreads == 0 )
+            p.nThreads = 1;
+
+        p.removeHits = cfg.get<bool>( node( ".HitRemover" ) + ":active", true );
+        return p;
+    }
+};
+
+/* Per event latency budget for the track finding (TrackFinder.Budget)
+ *
+ * Instead of dropping all tracks of a busy event, the track finding of an
+ * iteration is degraded in steps. The level is set by the number of hits in the
+ * iteration (nHits thresholds for levels 1, 2, 3) and raised to the maximum once
+ * the event has used up maxMs:
+ *   1: nPhiSlices is multiplied by phiSliceFactor
+ *   2: as 1, plus the tighter TrackFinder.Budget.ThreeHitSegments criteria (if given)
+ *   3: as 2, plus greedy instead of Hopfield subset selection
+ * A phi slice whose three hit step takes longer than step3MaxMs uses the greedy
+ * subset selection, regardless of the level.
+ */
+struct FwdBudgetParams {
+    static const int sMaxLevel = 3;
+
+    double maxMs = 0;                // per event, 0 = no time budget
+    std::vector<size_t> levelHits;   // hits in the iteration at which levels 1, 2, 3 start, empty = off
+    size_t phiSliceFactor = 2;
+    std::string threeHitSegmentsPath; // empty if no tighter criteria are given
+    double step3MaxMs = 200;
+    double step4WarnMs = 500;
+
+    // level for an iteration with nHits hits, elapsedMs into the event
+    int level( size_t nHits, double elapsedMs ) const {
+        if ( maxMs > 0 && elapsedMs >= maxMs )
+            return sMaxLevel;
+        int l = 0;
+        for ( size_t h : levelHits ){
+            if ( nHits >= h && l < sMaxLevel )
+                l++;
+        }
+        return l;
+    }
+
+    static FwdBudgetParams load( const FwdTrackerConfig &cfg ) {
+        FwdBudgetParams p;
+        p.maxMs = cfg.get<double>( "TrackFinder.Budget:maxMs", 0 );
+        p.levelHits = cfg.getVector<size_t>( "TrackFinder.Budget:nHits", {} );
+        std::sort( p.levelHits.begin(), p.levelHits.end() );
+        p.phiSliceFactor = std::max<size_t>( 1, cfg.get<size_t>( "TrackFinder.Budget:phiSliceFactor", 2 ) );
+        if ( cfg.exists( "TrackFinder.Budget.ThreeHitSegments" ) )
+            p.threeHitSegmentsPath = "TrackFinder.Budget.ThreeHitSegments";
+        p.step3MaxMs = cfg.get<double>( "TrackFinder.Budget:step3MaxMs", 200 );
+        p.step4WarnMs = cfg.get<double>( "TrackFinder.Budget:step4WarnMs", 500 );
+        return p;
+    }
+};
+
+/* What the budget decided for one iteration of an event */
+struct FwdBudgetDecision {
+    size_t iteration = 0;
+    size_t nHits = 0;            // hits available to the iteration
+    double elapsedMs = 0;        // event time used before the iteration
+    int level = 0;
+    size_t nPhiSlices = 1;       // slices used
+    bool tightCriteria = false;  // Budget.ThreeHitSegments used
+    bool greedy = false;         // greedy subset selection in all slices
+    size_t nStep3Overruns = 0;   // slices that switched to greedy since the three hit step was too slow
+};
+
+/* Typed snapshot of the per event tracker parameters, see FwdIterationParams */
+struct FwdTrackerParams {
+    bool mcTrackFinding = true; // no TrackFinder node, the tracks are built from MC
+    bool refitSi = true;
+    bool mcSeed = false;
+    FwdBudgetParams budget;
+    std::vector<FwdIterationParams> iterations;
+
+    static FwdTrackerParams load( const FwdTrackerConfig &cfg ) {
+        FwdTrackerParams p;
+        p.mcTrackFinding = !cfg.exists( "TrackFinder" );
+        p.refitSi = cfg.get<bool>( "TrackFitter:refitSi", true );
+        p.mcSeed = cfg.get<bool>( "TrackFitter:mcSeed", false );
+
+        if ( !p.mcTrackFinding ){
+            p.budget = FwdBudgetParams::load( cfg );
+            size_t nIterations = cfg.get<size_t>( "TrackFinder:nIterations", 0 );
+            for ( size_t i = 0; i < nIterations; i++ )
+                p.iterations.push_back( FwdIterationParams::load( cfg, i ) );
+        }
+        return p;
+    }
+};
+
+#endif
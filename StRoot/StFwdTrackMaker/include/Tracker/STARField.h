@@ -5,6 +5,10 @@
 #include "StarMagField/StarMagField.h"
 #include "GenFit/AbsBField.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 //_______________________________________________________________________________________
 // Adaptor for STAR magnetic field loaded via StarMagField Maker
 class StarFieldAdaptor : public genfit::AbsBField {
@@ -33,5 +37,185 @@ class StarFieldAdaptor : public genfit::AbsBField {
     };
 };
 
+//_______________________________________________________________________________________
+// Adaptor for the STAR magnetic field using a precomputed grid over the forward region.
+// The field is sampled once from StarMagField on a regular cartesian grid and then
+// evaluated with trilinear interpolation, avoiding the virtual dispatch, Search and
+// map interpolation of StarMagField::Field on every RK step.
+// The default grid, |x|, |y| < 220 cm and 0 < z < 900 cm, covers the projections up to the
+// FCS (r ~ 200 cm), so they are taken from the grid. It has 111 x 111 x 181 nodes (~36 MB).
+// Points outside of the grid fall back to StarMagField directly, which is NOT thread-safe
+// (its interpolation keeps static search hints). With setFallback(false) they take the field
+// of the nearest grid point instead, then the grid is read-only once built and lookups are
+// safe from several threads (threadSafe()).
+// maxDeviation() compares the grid with StarMagField over the grid volume.
+class StarFieldGridAdaptor : public genfit::AbsBField {
+  public:
+    // one grid node, padded to 16 bytes so that 4 nodes fill a cache line
+    struct alignas(16) FieldNode {
+        float B[4];
+    };
+
+    StarFieldGridAdaptor( double rMax = 220.0, double zMin = 0.0, double zMax = 900.0, double dxy = 4.0, double dz = 5.0 ) :
+        mRMax( rMax ), mZMin( zMin ), mZMax( zMax ), mDxy( dxy ), mDz( dz ) {
+        build();
+    }
+
+    // (re)builds the grid from StarMagField, no-op if the field scale has not changed
+    // returns true if the grid was rebuilt
+    bool build() {
+        StarMagField *field = StarMagField::Instance();
+        float scale = field ? field->GetFactor() * field->GetRescale() : 0.0;
+        if ( !mNodes.empty() && scale == mScale )
+            return false;
+        mScale = scale;
+
+        mNxy = std::max( (int)( 2 * mRMax / mDxy ) + 1, 2 );
+        mNz = std::max( (int)( (mZMax - mZMin) / mDz ) + 1, 2 );
+        mInvDxy = 1.0 / mDxy;
+        mInvDz = 1.0 / mDz;
+        mNodes.assign( (size_t)mNxy * mNxy * mNz, FieldNode() );
+
+        double x[3] = {0, 0, 0};
+        double B[3] = {0, 0, 0};
+        for ( int ix = 0; ix < mNxy; ix++ ) {
+            for ( int iy = 0; iy < mNxy; iy++ ) {
+                for ( int iz = 0; iz < mNz; iz++ ) {
+                    x[0] = -mRMax + ix * mDxy;
+                    x[1] = -mRMax + iy * mDxy;
+                    x[2] = mZMin + iz * mDz;
+                    B[0] = B[1] = B[2] = 0;
+                    if ( field )
+                        field->Field( x, B );
+                    FieldNode &n = mNodes[ index( ix, iy, iz ) ];
+                    n.B[0] = B[0];
+                    n.B[1] = B[1];
+                    n.B[2] = B[2];
+                    n.B[3] = 0;
+                }
+            }
+        }
+        return true;
+    }
+
+    // false: points outside of the grid take the field of the nearest grid point instead of StarMagField
+    // (only correct where the field is nearly constant beyond the grid edge; a grid smaller than the
+    // default misses the FCS projections, r ~ 200 cm, which then always take the edge field)
+    void setFallback( bool fallback ) { mFallback = fallback; }
+    // true if lookups never call StarMagField, so they can be made from several threads
+    bool threadSafe() const { return !mFallback; }
+
+    /* largest difference |B_grid - B_StarMagField| [kGauss] at the centers of the grid cells
+     * (where the trilinear interpolation is the least accurate), checking every step-th cell
+     * along each axis. Returns -1 without StarMagField. Calls StarMagField, single thread only.
+     */
+    double maxDeviation( int step = 1 ) const {
+        StarMagField *field = StarMagField::Instance();
+        if ( !field || mNodes.empty() )
+            return -1;
+        step = std::max( step, 1 );
+        double maxDev = 0;
+        double x[3] = {0, 0, 0};
+        double B[3] = {0, 0, 0};
+        double Bg[3] = {0, 0, 0};
+        for ( int ix = 0; ix < mNxy - 1; ix += step ) {
+            for ( int iy = 0; iy < mNxy - 1; iy += step ) {
+                for ( int iz = 0; iz < mNz - 1; iz += step ) {
+                    x[0] = -mRMax + ( ix + 0.5 ) * mDxy;
+                    x[1] = -mRMax + ( iy + 0.5 ) * mDxy;
+                    x[2] = mZMin + ( iz + 0.5 ) * mDz;
+                    B[0] = B[1] = B[2] = 0;
+                    field->Field( x, B );
+                    interpolate( x[0], x[1], x[2], Bg[0], Bg[1], Bg[2] );
+                    const double dev = sqrt( (Bg[0] - B[0]) * (Bg[0] - B[0]) + (Bg[1] - B[1]) * (Bg[1] - B[1]) + (Bg[2] - B[2]) * (Bg[2] - B[2]) );
+                    maxDev = std::max( maxDev, dev );
+                }
+            }
+        }
+        return maxDev;
+    }
+
+    virtual TVector3 get(const TVector3 &position) const {
+        double B[3] = {0, 0, 0};
+        get( position[0], position[1], position[2], B[0], B[1], B[2] );
+        return TVector3(B);
+    }
+
+    virtual void get(const double &_x, const double &_y, const double &_z, double &Bx, double &By, double &Bz) const {
+        if ( interpolate( _x, _y, _z, Bx, By, Bz, !mFallback ) )
+            return;
+
+        // outside of the grid
+        double x[] = {_x, _y, _z};
+        double B[] = {0, 0, 0};
+        if (StarMagField::Instance())
+            StarMagField::Instance()->Field(x, B);
+        Bx = B[0];
+        By = B[1];
+        Bz = B[2];
+    }
+
+    // batch lookup for n positions (structure of arrays in and out)
+    void get( size_t n, const double *x, const double *y, const double *z, double *Bx, double *By, double *Bz ) const {
+        for ( size_t i = 0; i < n; i++ )
+            get( x[i], y[i], z[i], Bx[i], By[i], Bz[i] );
+    }
+
+  protected:
+    // z is the fastest index since RK steps in the forward region mostly move along z
+    inline size_t index( int ix, int iy, int iz ) const {
+        return ( (size_t)ix * mNxy + iy ) * mNz + iz;
+    }
+
+    // trilinear interpolation, returns false if the point is outside of the grid
+    // unless clamp is set, then the point is moved to the nearest grid point first
+    inline bool interpolate( double x, double y, double z, double &Bx, double &By, double &Bz, bool clamp = false ) const {
+        double fx = ( x + mRMax ) * mInvDxy;
+        double fy = ( y + mRMax ) * mInvDxy;
+        double fz = ( z - mZMin ) * mInvDz;
+        if ( !( fx >= 0 && fy >= 0 && fz >= 0 && fx < mNxy - 1 && fy < mNxy - 1 && fz < mNz - 1 ) ) {
+            if ( !clamp || mNodes.empty() )
+                return false;
+            fx = std::min( std::max( fx, 0.0 ), mNxy - 1.0 );
+            fy = std::min( std::max( fy, 0.0 ), mNxy - 1.0 );
+            fz = std::min( std::max( fz, 0.0 ), mNz - 1.0 );
+        }
+
+        // the last node of an axis is interpolated from the last cell (t = 1)
+        const int ix = std::min( (int)fx, mNxy - 2 );
+        const int iy = std::min( (int)fy, mNxy - 2 );
+        const int iz = std::min( (int)fz, mNz - 2 );
+        const float tx = fx - ix;
+        const float ty = fy - iy;
+        const float tz = fz - iz;
+
+        const size_t sx = (size_t)mNxy * mNz; // stride in x
+        const size_t sy = mNz;                // stride in y
+        const FieldNode *n = &mNodes[ index( ix, iy, iz ) ];
+
+        float b[3];
+        for ( int c = 0; c < 3; c++ ) {
+            // interpolate along z (contiguous pairs) then y then x
+            const float c00 = n[0].B[c]       + tz * ( n[1].B[c]           - n[0].B[c] );
+            const float c01 = n[sy].B[c]      + tz * ( n[sy + 1].B[c]      - n[sy].B[c] );
+            const float c10 = n[sx].B[c]      + tz * ( n[sx + 1].B[c]      - n[sx].B[c] );
+            const float c11 = n[sx + sy].B[c] + tz * ( n[sx + sy + 1].B[c] - n[sx + sy].B[c] );
+            const float c0 = c00 + ty * ( c01 - c00 );
+            const float c1 = c10 + ty * ( c11 - c10 );
+            b[c] = c0 + tx * ( c1 - c0 );
+        }
+        Bx = b[0];
+        By = b[1];
+        Bz = b[2];
+        return true;
+    }
+
+    double mRMax, mZMin, mZMax, mDxy, mDz;
+    double mInvDxy = 1, mInvDz = 1;
+    int mNxy = 0, mNz = 0;
+    float mScale = 0; // StarMagField factor * rescale the grid was built with
+    bool mFallback = true; // points outside of the grid use StarMagField
+    std::vector<FieldNode> mNodes;
+};
 
 #endif
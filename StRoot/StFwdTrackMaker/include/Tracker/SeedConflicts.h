@@ -0,0 +1,118 @@
+#ifndef SEED_CONFLICTS_H
+#define SEED_CONFLICTS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "StFwdTrackMaker/include/Tracker/FwdHit.h"
+
+/* Pairwise compatibility of a set of track seeds
+ *
+ * Two seeds conflict if they share a hit. The conflicts are found once
+ * through a hit id -> seeds lookup (only seeds sharing a hit are ever
+ * compared) and stored as one bitset row per seed, so that the
+ * O(N^2) compatibility checks of the Hopfield network are a bit lookup.
+ */
+class SeedConflictMatrix {
+  public:
+    SeedConflictMatrix( const std::vector<Seed_t> &seeds ) : mN( seeds.size() ), mNWords( ( seeds.size() + 63 ) / 64 ) {
+        mBits.assign( mN * mNWords, 0 );
+
+        // seeds using each hit
+        std::vector<std::pair<unsigned int, unsigned int>> hitSeed; // ( hit id, seed index )
+        for ( size_t i = 0; i < mN; i++ ) {
+            for ( auto h : seeds[i] )
+                hitSeed.push_back( std::make_pair( static_cast<FwdHit *>( h )->_id, (unsigned int)i ) );
+        }
+        std::sort( hitSeed.begin(), hitSeed.end() );
+
+        // every pair of seeds within the same hit conflicts
+        for ( size_t lo = 0; lo < hitSeed.size(); ) {
+            size_t hi = lo + 1;
+            while ( hi < hitSeed.size() && hitSeed[hi].first == hitSeed[lo].first )
+                hi++;
+            for ( size_t a = lo; a < hi; a++ ) {
+                for ( size_t b = a + 1; b < hi; b++ ) {
+                    set( hitSeed[a].second, hitSeed[b].second );
+                    set( hitSeed[b].second, hitSeed[a].second );
+                }
+            }
+            lo = hi;
+        }
+    }
+
+    bool compatible( size_t i, size_t j ) const {
+        return 0 == ( mBits[i * mNWords + j / 64] & ( uint64_t( 1 ) << ( j % 64 ) ) );
+    }
+
+    size_t size() const { return mN; }
+
+  protected:
+    void set( size_t i, size_t j ) { mBits[i * mNWords + j / 64] |= uint64_t( 1 ) << ( j % 64 ); }
+
+    size_t mN;
+    size_t mNWords;
+    std::vector<uint64_t> mBits;
+};
+
+// SeedCompare / SeedQual for seeds given as indices into a list (KiTrack::SubsetHopfieldNN<size_t>)
+struct SeedIndexCompare {
+    SeedIndexCompare( const SeedConflictMatrix &conflicts ) : mConflicts( conflicts ) {}
+    inline bool operator()( size_t a, size_t b ) const { return mConflicts.compatible( a, b ); }
+    const SeedConflictMatrix &mConflicts;
+};
+
+struct SeedIndexQual {
+    SeedIndexQual( const std::vector<Seed_t> &seeds ) : mSeeds( seeds ) {}
+    inline double operator()( size_t i ) const { return SeedQual()( mSeeds[i] ); }
+    const std::vector<Seed_t> &mSeeds;
+};
+
+/* Greedy best subset
+ * For when there are too many candidates for the Hopfield network:
+ * seeds are taken in order of decreasing quality (ties keep their order),
+ * each one is accepted if it shares no hit with an already accepted seed.
+ * @returns the accepted seeds, in the order they were given
+ */
+inline std::vector<Seed_t> greedySeedSubset( const std::vector<Seed_t> &seeds ) {
+    std::vector<size_t> order( seeds.size() );
+    std::iota( order.begin(), order.end(), 0 );
+    std::vector<double> quality( seeds.size() );
+    for ( size_t i = 0; i < seeds.size(); i++ )
+        quality[i] = SeedQual()( seeds[i] );
+    std::stable_sort( order.begin(), order.end(), [&]( size_t a, size_t b ){ return quality[a] > quality[b]; } );
+
+    std::vector<bool> hitUsed;
+    std::vector<bool> accepted( seeds.size(), false );
+    for ( size_t i : order ) {
+        bool free = true;
+        for ( auto h : seeds[i] ) {
+            unsigned int id = static_cast<FwdHit *>( h )->_id;
+            if ( id < hitUsed.size() && hitUsed[id] ) {
+                free = false;
+                break;
+            }
+        }
+        if ( !free )
+            continue;
+
+        accepted[i] = true;
+        for ( auto h : seeds[i] ) {
+            unsigned int id = static_cast<FwdHit *>( h )->_id;
+            if ( id >= hitUsed.size() )
+                hitUsed.resize( id + 1, false );
+            hitUsed[id] = true;
+        }
+    }
+
+    std::vector<Seed_t> result;
+    for ( size_t i = 0; i < seeds.size(); i++ ) {
+        if ( accepted[i] )
+            result.push_back( seeds[i] );
+    }
+    return result;
+}
+
+#endif
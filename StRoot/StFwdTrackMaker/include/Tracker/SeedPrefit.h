@@ -0,0 +1,155 @@
+#ifndef SEED_PREFIT_H
+#define SEED_PREFIT_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "StFwdTrackMaker/include/Tracker/FwdHit.h"
+
+/* Fast analytic fit of a track seed, before the Kalman fit
+ *
+ * Fits the transverse projection of the helix (a circle) and a straight
+ * line to the hits (plus optionally the vertex) by weighted least squares.
+ * The circle chi2 tells how well the hits follow a helix at all, and the
+ * difference to the line chi2 how significant the curvature is, i.e. whether
+ * the charge sign is determined by the hits.
+ */
+class SeedPrefit {
+  public:
+    struct Result {
+        bool valid = false;
+        double xc = 0, yc = 0, R = 0;   // circle center and radius (cm)
+        double chi2Circle = 0, chi2Line = 0;
+        int ndfCircle = 0;
+        int orientation = 0;            // +1 counter clockwise (seen from +z), -1 clockwise, moving in +z
+
+        double chi2PerNdf() const { return ndfCircle > 0 ? chi2Circle / ndfCircle : 0; }
+        // significance of the curvature, compared to a straight line
+        double deltaChi2() const { return chi2Line - chi2Circle; }
+        // charge sign given the sign of Bz
+        int charge( double bz ) const { return ( bz >= 0 ? -1 : 1 ) * orientation; }
+    };
+
+    /* fit
+     * @param seed: the hits
+     * @param vertex: optional vertex (x, y, z) to include, may be null
+     * @param vertexSigmaXY: transverse uncertainty of the vertex (cm)
+     */
+    static Result fit( const Seed_t &seed, const double *vertex, double vertexSigmaXY ) {
+        Result result;
+
+        std::vector<Point> points;
+        points.reserve( seed.size() + 1 );
+        if ( vertex != nullptr )
+            points.push_back( Point( vertex[0], vertex[1], vertex[2], 1.0 / ( vertexSigmaXY * vertexSigmaXY ) ) );
+        for ( auto h : seed ) {
+            const FwdHitCov &cov = static_cast<FwdHit *>( h )->_covmat;
+            double s2 = 0.5 * ( cov( 0, 0 ) + cov( 1, 1 ) );
+            if ( s2 < sMinSigma * sMinSigma )
+                s2 = sMinSigma * sMinSigma;
+            points.push_back( Point( h->getX(), h->getY(), h->getZ(), 1.0 / s2 ) );
+        }
+
+        const size_t n = points.size();
+        if ( n < 4 )
+            return result; // the circle needs at least one degree of freedom
+
+        // weighted centroid, the fits are done relative to it for numerical stability
+        double sw = 0, mx = 0, my = 0;
+        for ( const auto &p : points ) {
+            sw += p.w;
+            mx += p.w * p.x;
+            my += p.w * p.y;
+        }
+        mx /= sw;
+        my /= sw;
+
+        // straight line: smallest eigenvalue of the weighted scatter matrix
+        double sxx = 0, syy = 0, sxy = 0;
+        for ( const auto &p : points ) {
+            const double u = p.x - mx, v = p.y - my;
+            sxx += p.w * u * u;
+            syy += p.w * v * v;
+            sxy += p.w * u * v;
+        }
+        result.chi2Line = 0.5 * ( sxx + syy ) - sqrt( 0.25 * ( sxx - syy ) * ( sxx - syy ) + sxy * sxy );
+
+        // circle (algebraic fit): minimize sum w ( u^2 + v^2 + D u + E v + F )^2
+        double A[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+        double b[3] = {0, 0, 0};
+        for ( const auto &p : points ) {
+            const double u = p.x - mx, v = p.y - my;
+            const double z = u * u + v * v;
+            const double row[3] = {u, v, 1.0};
+            for ( int i = 0; i < 3; i++ ) {
+                for ( int j = 0; j < 3; j++ )
+                    A[i][j] += p.w * row[i] * row[j];
+                b[i] -= p.w * row[i] * z;
+            }
+        }
+
+        double sol[3];
+        if ( false == solve3( A, b, sol ) )
+            return result;
+
+        const double uc = -0.5 * sol[0];
+        const double vc = -0.5 * sol[1];
+        const double r2 = uc * uc + vc * vc - sol[2];
+        if ( !( r2 > 0 ) )
+            return result;
+
+        result.R = sqrt( r2 );
+        result.xc = uc + mx;
+        result.yc = vc + my;
+        result.ndfCircle = n - 3;
+
+        for ( const auto &p : points ) {
+            const double d = sqrt( ( p.x - result.xc ) * ( p.x - result.xc ) + ( p.y - result.yc ) * ( p.y - result.yc ) ) - result.R;
+            result.chi2Circle += p.w * d * d;
+        }
+
+        // sense of rotation around the center, following the points along z
+        std::sort( points.begin(), points.end(), []( const Point &a, const Point &c ){ return a.z < c.z; } );
+        double turn = 0;
+        for ( size_t i = 0; i + 1 < n; i++ ) {
+            const double ax = points[i].x - result.xc, ay = points[i].y - result.yc;
+            const double bx = points[i + 1].x - result.xc, by = points[i + 1].y - result.yc;
+            turn += ax * by - ay * bx;
+        }
+        result.orientation = turn >= 0 ? 1 : -1;
+
+        result.valid = true;
+        return result;
+    }
+
+  protected:
+    static constexpr double sMinSigma = 1e-3; // cm, floor on the hit uncertainty
+
+    struct Point {
+        Point( double _x, double _y, double _z, double _w ) : x( _x ), y( _y ), z( _z ), w( _w ) {}
+        double x, y, z, w;
+    };
+
+    // solves A x = b by Cramer's rule, false if singular
+    static bool solve3( const double A[3][3], const double b[3], double x[3] ) {
+        const double det = A[0][0] * ( A[1][1] * A[2][2] - A[1][2] * A[2][1] )
+                         - A[0][1] * ( A[1][0] * A[2][2] - A[1][2] * A[2][0] )
+                         + A[0][2] * ( A[1][0] * A[2][1] - A[1][1] * A[2][0] );
+        if ( fabs( det ) < 1e-300 )
+            return false;
+
+        for ( int k = 0; k < 3; k++ ) {
+            double M[3][3];
+            for ( int i = 0; i < 3; i++ )
+                for ( int j = 0; j < 3; j++ )
+                    M[i][j] = ( j == k ) ? b[i] : A[i][j];
+            x[k] = ( M[0][0] * ( M[1][1] * M[2][2] - M[1][2] * M[2][1] )
+                   - M[0][1] * ( M[1][0] * M[2][2] - M[1][2] * M[2][0] )
+                   + M[0][2] * ( M[1][0] * M[2][1] - M[1][1] * M[2][0] ) ) / det;
+        }
+        return true;
+    }
+};
+
+#endif
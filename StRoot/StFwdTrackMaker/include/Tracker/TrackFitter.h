@@ -36,6 +36,7 @@
 #include "StFwdTrackMaker/include/Tracker/TrackFitter.h"
 #include "StFwdTrackMaker/include/Tracker/STARField.h"
 #include "StFwdTrackMaker/include/Tracker/FwdGeomUtils.h"
+#include "StFwdTrackMaker/include/Tracker/SeedPrefit.h"
 
 #include "StarGenerator/UTIL/StarRandom.h"
 
@@ -70,6 +71,19 @@ class TrackFitter {
         if (mConfig.get<bool>("TrackFitter:constB", false)) {
             mBField = std::unique_ptr<genfit::AbsBField>(new genfit::ConstField(0., 0., 5.)); // 0.5 T Bz
             LOG_INFO << "StFwdTrackMaker: Tracking with constant magnetic field" << endl;
+        } else if (mConfig.get<bool>("TrackFitter.FieldGrid:active", false)) {
+            mFieldGrid = new StarFieldGridAdaptor(
+                mConfig.get<double>("TrackFitter.FieldGrid:rmax", 220.0), // half width in x and y, the FCS projections reach r ~ 200 cm
+                mConfig.get<double>("TrackFitter.FieldGrid:zmin", 0.0),
+                mConfig.get<double>("TrackFitter.FieldGrid:zmax", 900.0),
+                mConfig.get<double>("TrackFitter.FieldGrid:dxy", 4.0),
+                mConfig.get<double>("TrackFitter.FieldGrid:dz", 5.0) );
+            // without the fallback, points outside of the grid take the field of the nearest grid point,
+            // so rmax and zmax must cover everything that is projected (see StarFieldGridAdaptor)
+            mFieldGrid->setFallback( mConfig.get<bool>("TrackFitter.FieldGrid:fallback", true) );
+            mBField = std::unique_ptr<genfit::AbsBField>(mFieldGrid);
+            LOG_INFO << "StFwdTrackMaker: Tracking with StarFieldGridAdaptor" << endl;
+            checkFieldGrid();
         } else {
             mBField = std::unique_ptr<genfit::AbsBField>(new StarFieldAdaptor());
             LOG_INFO << "StFwdTrackMaker: Tracking with StarFieldAdapter" << endl;
@@ -79,88 +93,52 @@ class TrackFitter {
         genfit::FieldManager::getInstance()->init(mBField.get()); 
 
         // initialize the main mFitter using a KalmanFitter with reference tracks
-        mFitter = std::unique_ptr<genfit::AbsKalmanFitter>(new genfit::KalmanFitterRefTrack());
+        setupFitter();
 
-        // Here we load several options from the config, 
-        // to customize the mFitter behavior
-        mFitter->setMaxFailedHits(mConfig.get<int>("TrackFitter.KalmanFitterRefTrack:MaxFailedHits", -1)); // default -1, no limit
-        mFitter->setDebugLvl(mConfig.get<int>("TrackFitter.KalmanFitterRefTrack:DebugLvl", 0)); // default 0, no output
-        mFitter->setMaxIterations(mConfig.get<int>("TrackFitter.KalmanFitterRefTrack:MaxIterations", 4)); // default 4 iterations
-        mFitter->setMinIterations(mConfig.get<int>("TrackFitter.KalmanFitterRefTrack:MinIterations", 0)); // default 0 iterations
-
-        // FwdGeomUtils looks into the loaded geometry and gets detector z locations if present
-        FwdGeomUtils fwdGeoUtils( gMan );
+        // look up the detector z locations in the loaded geometry (if present) and make the planes, once
 
         // these default values are the default if the detector is 
         // a) not found in the geometry 
         // b) not provided in config
 
         // NOTE: these defaults are needed since the geometry file might not include FST (bug being worked on separately)
-        mFSTZLocations = fwdGeoUtils.fstZ(
+        mGeomCache.build( gMan,
             mConfig.getVector<double>("TrackFitter.Geometry:fst", 
                 {140.286011, 154.286011, 168.286011 }
                 // 144.633,158.204,171.271
-            )
+            ),
+            // mConfig.getVector<>(...) requires a default, hence the 
+            mConfig.getVector<double>("TrackFitter.Geometry:ftt", {0.0f, 0.0f, 0.0f, 0.0f}),
+            mConfig.get<double>("TrackFitter.Geometry:ecal", 710.16),
+            mConfig.get<double>("TrackFitter.Geometry:hcal", 782.63)
         );
 
-        if ( fwdGeoUtils.fstZ( 0 ) < 1.0 ) { // returns 0.0 on failure
+        mFSTZLocations = mGeomCache.fstZ;
+        mFSTPlanes = mGeomCache.fstPlanes;
+        mFSTPlanesInner = mGeomCache.fstPlanesInner;
+        mFSTPlanesOuter = mGeomCache.fstPlanesOuter;
+
+        if ( false == mGeomCache.fstFromGeometry ) {
             LOG_WARN << "Using FST z-locations from config or defautl, may not match hits" << endm;
         }
 
-        const double dzInnerFst = 1.715 + 0.04; // cm relative to "center" of disk + residual...
-        const double dzOuterFst = 0.240 + 0.04; // cm relative to "center" of disk
+        const double dzInnerFst = FwdGeomCache::sDzInnerFst;
+        const double dzOuterFst = FwdGeomCache::sDzOuterFst;
 
-        // Now add the Si detector planes at the desired location
         std::stringstream sstr;
         sstr << "Adding FST Planes at: ";
         string delim = "";
         for (auto z : mFSTZLocations) {
-            mFSTPlanes.push_back(
-                genfit::SharedPlanePtr(
-                    // these normals make the planes face along z-axis
-                    new genfit::DetPlane(TVector3(0, 0, z), TVector3(1, 0, 0), TVector3(0, 1, 0) )
-                )
-            );
-
-            // Inner Module FST planes
-            mFSTPlanesInner.push_back(
-                genfit::SharedPlanePtr(
-                    // these normals make the planes face along z-axis
-                    new genfit::DetPlane(TVector3(0, 0, z - dzInnerFst), TVector3(1, 0, 0), TVector3(0, 1, 0) )
-                )
-            );
-            mFSTPlanesInner.push_back(
-                genfit::SharedPlanePtr(
-                    // these normals make the planes face along z-axis
-                    new genfit::DetPlane(TVector3(0, 0, z + dzInnerFst), TVector3(1, 0, 0), TVector3(0, 1, 0) )
-                )
-            );
-            // Outer Module FST planes
-            mFSTPlanesOuter.push_back(
-                genfit::SharedPlanePtr(
-                    // these normals make the planes face along z-axis
-                    new genfit::DetPlane(TVector3(0, 0, z - dzOuterFst), TVector3(1, 0, 0), TVector3(0, 1, 0) )
-                )
-            );
-            mFSTPlanesOuter.push_back(
-                genfit::SharedPlanePtr(
-                    // these normals make the planes face along z-axis
-                    new genfit::DetPlane(TVector3(0, 0, z + dzOuterFst), TVector3(1, 0, 0), TVector3(0, 1, 0) )
-                )
-            );
-
             sstr << delim << z << " (-dzInner=" << z - dzInnerFst << ", +dzInner=" << z+dzInnerFst << ", -dzOuter=" << z - dzOuterFst << ", +dzOuter=" << z + dzOuterFst << ")";
             delim = ", ";
         }
         LOG_INFO  << sstr.str() << endm;
 
-        // Now load FTT
-        // mConfig.getVector<>(...) requires a default, hence the 
-        mFTTZLocations = fwdGeoUtils.fttZ(
-            mConfig.getVector<double>("TrackFitter.Geometry:ftt", {0.0f, 0.0f, 0.0f, 0.0f})
-            );
+        // Now FTT
+        mFTTZLocations = mGeomCache.fttZ;
+        mFTTPlanes = mGeomCache.fttPlanes;
 
-        if ( fwdGeoUtils.fttZ( 0 ) < 1.0 ) { // returns 0.0 on failure
+        if ( false == mGeomCache.fttFromGeometry ) {
             LOG_WARN << "Using FTT z-locations from config or default, may not match hits" << endm;
         }
 
@@ -173,12 +151,6 @@ class TrackFitter {
         sstr << "Adding FTT Planes at: ";
         delim = "";
         for (auto z : mFTTZLocations) {
-            mFTTPlanes.push_back(
-                genfit::SharedPlanePtr(
-                    // these normals make the planes face along z-axis
-                    new genfit::DetPlane(TVector3(0, 0, z), TVector3(1, 0, 0), TVector3(0, 1, 0))
-                )
-            );
             sstr << delim << z;
             delim = ", ";
         }
@@ -190,10 +162,65 @@ class TrackFitter {
         mVertexPos = mConfig.getVector<double>("TrackFitter.Vertex:pos", {0.0,0.0,0.0});
         mIncludeVertexInFit = mConfig.get<bool>("TrackFitter.Vertex:includeInFit", false);
 
+        // analytic prefit, to reject bad seeds and pick the charge before the Kalman fit
+        mPrefitActive = mConfig.get<bool>("TrackFitter.Prefit:active", false);
+        mPrefitMaxChi2 = mConfig.get<double>("TrackFitter.Prefit:maxChi2", 50.0); // per ndf
+        mPrefitMinDeltaChi2 = mConfig.get<double>("TrackFitter.Prefit:minDeltaChi2", 9.0); // curvature significance to trust the charge
+
         if ( mGenHistograms )
             makeHistograms();
     }
 
+    // rebuilds the field grid (if used) when the StarMagField scale factor changes
+    // must not be called while fits are running
+    void updateField() {
+        if ( mFieldGrid && mFieldGrid->build() )
+            checkFieldGrid();
+
+        // the prefit only needs the sign of the field
+        if ( genfit::FieldManager::getInstance()->isInitialized() )
+            mBz = genfit::FieldManager::getInstance()->getFieldVal( TVector3( 0, 0, 300 ) ).Z();
+    }
+
+    /* compares the field grid with StarMagField at the cell centers (every TrackFitter.FieldGrid:checkStep-th
+     * cell along each axis) and warns if they differ by more than TrackFitter.FieldGrid:tolerance [kGauss],
+     * by default 0.05 kGauss (1% of the 5 kGauss central field)
+     */
+    void checkFieldGrid() {
+        double dev = mFieldGrid->maxDeviation( mConfig.get<int>("TrackFitter.FieldGrid:checkStep", 2) );
+        if ( dev < 0 ) // no StarMagField yet, checked when the grid is rebuilt
+            return;
+        double tolerance = mConfig.get<double>("TrackFitter.FieldGrid:tolerance", 0.05);
+        if ( dev > tolerance ) {
+            LOG_WARN << "StFwdTrackMaker: field grid differs from StarMagField by up to " << dev << " kGauss (tolerance " << tolerance
+                     << " kGauss), use a smaller TrackFitter.FieldGrid:dxy or dz" << endm;
+        } else {
+            LOG_INFO << "StFwdTrackMaker: field grid agrees with StarMagField within " << dev << " kGauss (tolerance " << tolerance << " kGauss)" << endm;
+        }
+    }
+
+    // creates the KalmanFitter with reference tracks and loads its options from the config
+    void setupFitter() {
+        mFitter = std::unique_ptr<genfit::AbsKalmanFitter>(new genfit::KalmanFitterRefTrack());
+
+        // Here we load several options from the config, 
+        // to customize the mFitter behavior
+        mFitter->setMaxFailedHits(mConfig.get<int>("TrackFitter.KalmanFitterRefTrack:MaxFailedHits", -1)); // default -1, no limit
+        mFitter->setDebugLvl(mConfig.get<int>("TrackFitter.KalmanFitterRefTrack:DebugLvl", 0)); // default 0, no output
+        mFitter->setMaxIterations(mConfig.get<int>("TrackFitter.KalmanFitterRefTrack:MaxIterations", 4)); // default 4 iterations
+        mFitter->setMinIterations(mConfig.get<int>("TrackFitter.KalmanFitterRefTrack:MinIterations", 0)); // default 0 iterations
+    }
+
+    // Draws a vertex from the simulated vertex distribution (used when the event vertex is unknown)
+    // This is what fitTrack does when no Vertex is given, exposed so that a batch of fits can draw
+    // their vertices before the fits
+    void sampleVertex( double *vertex ) {
+        StarRandom rand = StarRandom::Instance();
+        vertex[0] = mVertexPos[0] + rand.gauss(mVertexSigmaXY);
+        vertex[1] = mVertexPos[1] + rand.gauss(mVertexSigmaXY);
+        vertex[2] = mVertexPos[2] + rand.gauss(mVertexSigmaZ);
+    }
+
     void makeHistograms() {
         std::string n = "";
         mHist["ECalProjPosXY"] = new TH2F("ECalProjPosXY", ";X;Y", 1000, -500, 500, 1000, -500, 500);
@@ -239,8 +266,8 @@ class TrackFitter {
         mHist[n] = new TH1F(n.c_str(), ";#Delta( fit, seed ) phi", 500, -5, 5);
 
         n = "FitStatus";
-        mHist[n] = new TH1F(n.c_str(), ";", 5, 0, 5);
-        FwdTrackerUtils::labelAxis(mHist[n]->GetXaxis(), {"Total", "Pass", "Fail", "GoodCardinal", "Exception"});
+        mHist[n] = new TH1F(n.c_str(), ";", 7, 0, 7);
+        FwdTrackerUtils::labelAxis(mHist[n]->GetXaxis(), {"Total", "Pass", "Fail", "GoodCardinal", "Exception", "PrefitReject", "PrefitCharge"});
 
         n = "FitDuration";
         mHist[n] = new TH1F(n.c_str(), "; Duraton (ms)", 5000, 0, 50000);
@@ -659,11 +686,12 @@ class TrackFitter {
         // The PV information, if we want to use it
         TVectorD pv(3);
 
-        StarRandom rand = StarRandom::Instance();
         if (0 == Vertex) { // randomized from simulation
-            pv[0] = mVertexPos[0] + rand.gauss(mVertexSigmaXY);
-            pv[1] = mVertexPos[1] + rand.gauss(mVertexSigmaXY);
-            pv[2] = mVertexPos[2] + rand.gauss(mVertexSigmaZ);
+            double v[3];
+            sampleVertex( v );
+            pv[0] = v[0];
+            pv[1] = v[1];
+            pv[2] = v[2];
         } else {
             pv[0] = Vertex[0];
             pv[1] = Vertex[1];
@@ -674,9 +702,26 @@ class TrackFitter {
         TVector3 seedMom, seedPos;
         float curv = seedState(trackCand, seedPos, seedMom);
 
+        // Analytic prefit: seeds that are not helix-like are not given to GenFit at all,
+        // and if the curvature is significant only the matching charge hypothesis is fit
+        int prefitCharge = 0; // 0 = both charges
+        bool prefitRejected = false;
+        if ( mPrefitActive ) {
+            SeedPrefit::Result prefit = SeedPrefit::fit( trackCand, mIncludeVertexInFit ? pv.GetMatrixArray() : nullptr, mVertexSigmaXY );
+            if ( prefit.valid ) {
+                if ( prefit.chi2PerNdf() > mPrefitMaxChi2 ) {
+                    prefitRejected = true;
+                    if (mGenHistograms) this->mHist["FitStatus"]->Fill("PrefitReject", 1);
+                } else if ( prefit.deltaChi2() > mPrefitMinDeltaChi2 ) {
+                    prefitCharge = prefit.charge( mBz );
+                    if (mGenHistograms) this->mHist["FitStatus"]->Fill("PrefitCharge", 1);
+                }
+            }
+        }
+
         // create the track representations
-        auto trackRepPos = new genfit::RKTrackRep(mPdgPiPlus);
-        auto trackRepNeg = new genfit::RKTrackRep(mPdgPiMinus);
+        auto trackRepPos = prefitCharge >= 0 ? new genfit::RKTrackRep(mPdgPiPlus) : nullptr;
+        auto trackRepNeg = prefitCharge <= 0 ? new genfit::RKTrackRep(mPdgPiMinus) : nullptr;
 
         // If we use the PV, use that as the start pos for the track
         if (mIncludeVertexInFit) {
@@ -691,8 +736,9 @@ class TrackFitter {
             seedMom = *McSeedMom;
         }
 
-        mFitTrack = new genfit::Track(trackRepPos, seedPos, seedMom);
-        mFitTrack->addTrackRep(trackRepNeg);
+        mFitTrack = new genfit::Track(trackRepPos ? trackRepPos : trackRepNeg, seedPos, seedMom);
+        if ( trackRepPos && trackRepNeg )
+            mFitTrack->addTrackRep(trackRepNeg);
 
         LOG_DEBUG
             << "seedPos : (" << seedPos.X() << ", " << seedPos.Y() << ", " << seedPos.Z() << " )"
@@ -751,9 +797,11 @@ class TrackFitter {
         }
 
         try {
-            // do the fit
-            mFitter->processTrackWithRep(&fitTrack, trackRepPos);
-            mFitter->processTrackWithRep(&fitTrack, trackRepNeg);
+            // do the fit (rejected seeds are left unfitted, so they end up as failed fits below)
+            if ( !prefitRejected ) {
+                if ( trackRepPos ) mFitter->processTrackWithRep(&fitTrack, trackRepPos);
+                if ( trackRepNeg ) mFitter->processTrackWithRep(&fitTrack, trackRepNeg);
+            }
 
         } catch (genfit::Exception &e) {
             if (mGenHistograms) mHist["FitStatus"]->Fill("Exception", 1);
@@ -781,8 +829,8 @@ class TrackFitter {
                 this->mHist["FitStatus"]->Fill("GoodCardinal", 1);
             }
 
-            if (fitTrack.getFitStatus(trackRepPos)->isFitConverged() == false &&
-                fitTrack.getFitStatus(trackRepNeg)->isFitConverged() == false) {
+            if ((trackRepPos == nullptr || fitTrack.getFitStatus(trackRepPos)->isFitConverged() == false) &&
+                (trackRepNeg == nullptr || fitTrack.getFitStatus(trackRepNeg)->isFitConverged() == false)) {
         
                 p.SetXYZ(0, 0, 0);
                 long long duration = (FwdTrackerUtils::nowNanoSecond() - itStart) * 1e-6; // milliseconds
@@ -828,8 +876,23 @@ class TrackFitter {
     genfit::FitStatus getStatus() { return mFitStatus; }
     genfit::AbsTrackRep *getTrackRep() { return mTrackRep; }
     genfit::Track *getTrack() { return mFitTrack; }
+
+    // Hand ownership of the last fit result to the caller instead of deep-copying it
+    genfit::Track *releaseTrack() {
+        genfit::Track *t = mFitTrack;
+        mFitTrack = nullptr;
+        return t;
+    }
+    genfit::AbsTrackRep *releaseTrackRep() {
+        genfit::AbsTrackRep *r = mTrackRep;
+        mTrackRep = nullptr;
+        return r;
+    }
     void setGenerateHistograms( bool gen) { mGenHistograms = gen;}
 
+    // detector z locations and planes, looked up once in setup()
+    const FwdGeomCache &getGeometry() const { return mGeomCache; }
+
     // Store the planes for FTT and FST
     vector<genfit::SharedPlanePtr> mFTTPlanes;
     vector<genfit::SharedPlanePtr> mFSTPlanes;
@@ -838,6 +901,7 @@ class TrackFitter {
 
   protected:
     std::unique_ptr<genfit::AbsBField> mBField;
+    StarFieldGridAdaptor *mFieldGrid = nullptr; // aliases mBField when the field grid is used
 
     FwdTrackerConfig mConfig; // main config object
 
@@ -855,6 +919,7 @@ class TrackFitter {
 
     // det z locations loaded from geom or config
     vector<double> mFSTZLocations, mFTTZLocations;
+    FwdGeomCache mGeomCache;
 
     // parameter ALIASED from mConfig wrt PV vertex
     double mVertexSigmaXY = 1;
@@ -862,6 +927,12 @@ class TrackFitter {
     vector<double> mVertexPos;
     bool mIncludeVertexInFit = false;
 
+    // analytic prefit settings (TrackFitter.Prefit) and the Bz used for its charge
+    bool mPrefitActive = false;
+    double mPrefitMaxChi2 = 50.0;
+    double mPrefitMinDeltaChi2 = 9.0;
+    double mBz = 5.0; // kGauss
+
     // GenFit state
     genfit::FitStatus mFitStatus;
     genfit::AbsTrackRep *mTrackRep;
@@ -31,6 +31,7 @@ const char* StMuArrays::arrayNames [__NALLARRAYS__    ] = {"MuEvent","PrimaryVer
 /*fcsArrayNames    [__NFCSARRAYS__    ]*/                  "FcsHit","FcsCluster","FcsPoint", "FcsInfo",
 /*fttArrayNames    [__NFTTARRAYS__    ]*/                  "FttRawHit","FttCluster","FttPoint",
 /*fstArrayNames    [__NFSTARRAYS__    ]*/                  "FstRawHit", "FstHit",
+/*fwdTrackArrayNames[__NFWDTRACKARRAYS__]*/               "FwdTrack",
 /*tofArrayNames    [__NTOFARRAYS__    ]*/                  "TofHit","TofData", "TofRawData",
 /*btofArrayNames   [__NBTOFARRAYS__   ]*/                  "BTofHit","BTofRawHit","BTofHeader", // dongx
 /*etofArrayNames   [__NETOFARRAYS__   ]*/                  "ETofDigi","ETofHit","ETofHeader",   // jdb
@@ -51,7 +52,8 @@ const char** StMuArrays::fmsArrayNames = StMuArrays::pmdArrayNames    +__NPMDARR
 const char** StMuArrays::fcsArrayNames = StMuArrays::fmsArrayNames    +__NFMSARRAYS__;
 const char** StMuArrays::fttArrayNames = StMuArrays::fcsArrayNames    +__NFCSARRAYS__;
 const char** StMuArrays::fstArrayNames = StMuArrays::fttArrayNames    +__NFTTARRAYS__;
-const char** StMuArrays::tofArrayNames = StMuArrays::fstArrayNames    +__NFSTARRAYS__;
+const char** StMuArrays::fwdTrackArrayNames = StMuArrays::fstArrayNames +__NFSTARRAYS__;
+const char** StMuArrays::tofArrayNames = StMuArrays::fwdTrackArrayNames +__NFWDTRACKARRAYS__;
 const char** StMuArrays::btofArrayNames = StMuArrays::tofArrayNames   +__NTOFARRAYS__;  // dongx
 const char** StMuArrays::etofArrayNames = StMuArrays::btofArrayNames  +__NBTOFARRAYS__; // jdb
 const char** StMuArrays::epdArrayNames  = StMuArrays::etofArrayNames  +__NETOFARRAYS__; // MALisa
@@ -81,6 +83,7 @@ const char* StMuArrays::arrayTypes [__NALLARRAYS__    ] = {"StMuEvent","StMuPrim
 /*fcsArrayTypes   [__NFCSARRAYS__     ]*/                  "StMuFcsHit","StMuFcsCluster","StMuFcsPoint","StMuFcsInfo",
 /*fttArrayTypes   [__NFTTARRAYS__     ]*/                  "StMuFttRawHit","StMuFttCluster","StMuFttPoint",
 /*fstArrayTypes   [__NFSTARRAYS__     ]*/                  "StMuFstRawHit","StMuFstHit",
+/*fwdTrackArrayTypes[__NFWDTRACKARRAYS__]*/               "StMuFwdTrack",
 /*tofArrayTypes   [__NTOFARRAYS__     ]*/                  "StMuTofHit","StTofData","StTofRawData",
 /*btofArrayTypes  [__NBTOFARRAYS__    ]*/                  "StMuBTofHit","StBTofRawHit","StBTofHeader",  // dongx
 /*etofArrayTypes  [__NETOFARRAYS__    ]*/                  "StMuETofDigi","StMuETofHit","StMuETofHeader",  // jdb+fseck
@@ -100,7 +103,8 @@ const char** StMuArrays::fmsArrayTypes  = StMuArrays::pmdArrayTypes    +__NPMDAR
 const char** StMuArrays::fcsArrayTypes  = StMuArrays::fmsArrayTypes    +__NFMSARRAYS__;
 const char** StMuArrays::fttArrayTypes  = StMuArrays::fcsArrayTypes    +__NFCSARRAYS__;
 const char** StMuArrays::fstArrayTypes  = StMuArrays::fttArrayTypes    +__NFTTARRAYS__;
-const char** StMuArrays::tofArrayTypes  = StMuArrays::fstArrayTypes    +__NFSTARRAYS__;
+const char** StMuArrays::fwdTrackArrayTypes = StMuArrays::fstArrayTypes +__NFSTARRAYS__;
+const char** StMuArrays::tofArrayTypes  = StMuArrays::fwdTrackArrayTypes +__NFWDTRACKARRAYS__;
 const char** StMuArrays::btofArrayTypes = StMuArrays::tofArrayTypes    +__NTOFARRAYS__;  // dongx
 const char** StMuArrays::etofArrayTypes = StMuArrays::btofArrayTypes   +__NBTOFARRAYS__;  // jdb
 const char** StMuArrays::epdArrayTypes  = StMuArrays::etofArrayTypes   +__NETOFARRAYS__; // MALisa
@@ -124,6 +128,7 @@ int   StMuArrays::arraySizes       [__NALLARRAYS__    ] = {1,10,1000,1000,1000,1
 /*fcsArraySizes    [__NFCSARRAYS__    ]*/                  1,1,1,1,
 /*fttArraySizes    [__NFTTARRAYS__    ]*/                  1,1,1,
 /*fstArraySizes    [__NFSTARRAYS__    ]*/                  1,1,
+/*fwdTrackArraySizes[__NFWDTRACKARRAYS__]*/               100,
 /*tofArraySizes    [__NTOFARRAYS__    ]*/                  100, 200, 1000,
 /*btofArraySizes   [__NBTOFARRAYS__   ]*/                  1000,1000,1,   // dongx
 /*etofArraySizes   [__NETOFARRAYS__   ]*/                  1000,1000,1,   // jdb
@@ -143,7 +148,8 @@ int* StMuArrays::fmsArraySizes = StMuArrays::pmdArraySizes     +__NPMDARRAYS__;
 int* StMuArrays::fcsArraySizes = StMuArrays::fmsArraySizes     +__NFMSARRAYS__;
 int* StMuArrays::fttArraySizes = StMuArrays::fcsArraySizes     +__NFCSARRAYS__;
 int* StMuArrays::fstArraySizes = StMuArrays::fttArraySizes     +__NFTTARRAYS__;
-int* StMuArrays::tofArraySizes = StMuArrays::fstArraySizes     +__NFSTARRAYS__;
+int* StMuArrays::fwdTrackArraySizes = StMuArrays::fstArraySizes +__NFSTARRAYS__;
+int* StMuArrays::tofArraySizes = StMuArrays::fwdTrackArraySizes +__NFWDTRACKARRAYS__;
 int* StMuArrays::btofArraySizes = StMuArrays::tofArraySizes    +__NTOFARRAYS__;  // dongx
 int* StMuArrays::etofArraySizes = StMuArrays::btofArraySizes   +__NBTOFARRAYS__;  // jdb
 int* StMuArrays::epdArraySizes  = StMuArrays::etofArraySizes   +__NETOFARRAYS__;  // MALisa
@@ -164,6 +170,7 @@ int   StMuArrays::arrayCounters       [__NALLARRAYS__ ] = {0,0,0,0,0,0,0,0,0,0,0
 /*fcsArrayCounters    [__NFCSARRAYS__    ]*/               0,0,0,0,
 /*fttArrayCounters    [__NFTTARRAYS__    ]*/               0,0,0,
 /*fstArrayCounters    [__NFSTARRAYS__    ]*/               0,0,
+/*fwdTrackArrayCounters[__NFWDTRACKARRAYS__]*/            0,
 /*tofArrayCounters    [__NTOFARRAYS__    ]*/               0, 0, 0,
 /*btofArrayCounters   [__NBTOFARRAYS__   ]*/               0, 0, 0,      // dongx
 /*etofArrayCounters   [__NETOFARRAYS__   ]*/               0, 0, 0,      // jdb
@@ -185,7 +192,8 @@ int* StMuArrays::fmsArrayCounters = StMuArrays::pmdArrayCounters     +__NPMDARRA
 int* StMuArrays::fcsArrayCounters = StMuArrays::fmsArrayCounters     +__NFMSARRAYS__;
 int* StMuArrays::fttArrayCounters = StMuArrays::fcsArrayCounters     +__NFCSARRAYS__;
 int* StMuArrays::fstArrayCounters = StMuArrays::fttArrayCounters     +__NFTTARRAYS__;
-int* StMuArrays::tofArrayCounters = StMuArrays::fstArrayCounters     +__NFSTARRAYS__;
+int* StMuArrays::fwdTrackArrayCounters = StMuArrays::fstArrayCounters +__NFSTARRAYS__;
+int* StMuArrays::tofArrayCounters = StMuArrays::fwdTrackArrayCounters +__NFWDTRACKARRAYS__;
 int* StMuArrays::btofArrayCounters = StMuArrays::tofArrayCounters    +__NTOFARRAYS__;  // dongx
 int* StMuArrays::etofArrayCounters = StMuArrays::btofArrayCounters   +__NBTOFARRAYS__;  // jdb
 int* StMuArrays::epdArrayCounters = StMuArrays::etofArrayCounters    +__NETOFARRAYS__;  // MALisa
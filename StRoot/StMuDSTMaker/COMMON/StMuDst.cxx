@@ -67,6 +67,7 @@ TClonesArray** StMuDst::fmsArrays            = 0;
 TClonesArray** StMuDst::fcsArrays            = 0;
 TClonesArray** StMuDst::fttArrays            = 0;
 TClonesArray** StMuDst::fstArrays            = 0;
+TClonesArray** StMuDst::fwdTrackArrays       = 0;
 TClonesArray** StMuDst::pmdArrays            = 0;
 TClonesArray** StMuDst::tofArrays            = 0;
 TClonesArray** StMuDst::btofArrays           = 0;   /// dongx
@@ -108,6 +109,7 @@ void StMuDst::unset() {
     fcsArrays     = 0;
     fttArrays     = 0;
     fstArrays     = 0;
+    fwdTrackArrays = 0;
     pmdArrays     = 0;
     tofArrays     = 0;
     btofArrays    = 0;   // dongx
@@ -144,6 +146,7 @@ void StMuDst::set(StMuDstMaker* maker) {
   fcsArrays     = maker->mFcsArrays;
   fttArrays     = maker->mFttArrays;
   fstArrays     = maker->mFstArrays;
+  fwdTrackArrays = maker->mFwdTrackArrays;
   pmdArrays     = maker->mPmdArrays;
   tofArrays     = maker->mTofArrays;
   btofArrays    = maker->mBTofArrays;    // dongx
@@ -198,7 +201,8 @@ void StMuDst::set(TClonesArray** theArrays,
           StMuFttCollection *ftt,
           StMuFstCollection *fst,
           TClonesArray* pmd_arr,
-		  StMuPmdCollection *pmd)
+		  StMuPmdCollection *pmd,
+		  TClonesArray** theFwdTrackArrays)
 {
   // I don't understand why this method is still needed,
   // but cannot comile dictionary  when it is removed
@@ -213,6 +217,7 @@ void StMuDst::set(TClonesArray** theArrays,
   fcsArrays     = theFcsArrays;
   fttArrays     = theFttArrays;
   fstArrays     = theFstArrays;
+  fwdTrackArrays = theFwdTrackArrays;
   fgtArrays     = theFgtArrays;
   pmdArrays     = thePmdArrays;
   tofArrays     = theTofArrays;
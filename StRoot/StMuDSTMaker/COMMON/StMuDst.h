@@ -34,6 +34,7 @@ class StMuFmsCollection;
 class StMuFcsCollection;
 class StMuFttCollection;
 class StMuFstCollection;
+class StMuFwdTrack;
 class StMuPmdCollection;
 
 class StEvent;
@@ -133,7 +134,8 @@ public:
             StMuFttCollection *ftt_col=0, 
             StMuFstCollection *fst_col=0, 
 		    TClonesArray *pmd_tca=0, 
-		    StMuPmdCollection *pmd_col=0
+		    StMuPmdCollection *pmd_col=0,
+		    TClonesArray** fwdTrack_ptca=0
 );
   /// set pointer to current StEmcCollection
   static void setEmcCollection(StEmcCollection *emc_coll) { mEmcCollection=emc_coll; }
@@ -189,6 +191,8 @@ public:
   static TClonesArray** fttArrays;
   /// array of TClonesArrays for the stuff inherited from the Fst
   static TClonesArray** fstArrays;
+  /// array of TClonesArrays for the forward tracks
+  static TClonesArray** fwdTrackArrays;
   /// array of TClonesArrays for the stuff inherited from the Pmd 
   static TClonesArray** pmdArrays;
   /// array of TClonesArrays for the stuff inherited from the TOF
@@ -256,6 +260,8 @@ public:
   static TClonesArray* fttArray(int type) { return fttArrays[type]; }
   /// returns pointer to the n-th TClonesArray from the fst arrays
   static TClonesArray* fstArray(int type) { return fstArrays[type]; }
+  /// returns pointer to the n-th TClonesArray from the forward track arrays
+  static TClonesArray* fwdTrackArray(int type) { return fwdTrackArrays[type]; }
     /// returns pointer to the n-th TClonesArray from the pmd arrays
   static TClonesArray* pmdArray(int type) { return pmdArrays[type]; }
   /// returns pointer to the n-th TClonesArray from the tof arrays
@@ -272,6 +278,8 @@ public:
   static TClonesArray* eztArray(int type) { return eztArrays[type]; }
   /// returns pointer to the EpdHitCollection
   static TClonesArray* epdHits() { return epdArrays[muEpdHit]; }  // MALisa
+  /// returns pointer to the forward track list
+  static TClonesArray* fwdTracks() { return fwdTrackArrays[muFwdTrack]; }
   /// returns pointer to the primary vertex list
   static TClonesArray* primaryVertices() { return arrays[muPrimaryVertex]; }
   /// returns pointer to a list of tracks belonging to the selected primary vertex
@@ -404,6 +412,8 @@ public:
 
   static StMuEpdHit* epdHit(int i) { return (StMuEpdHit*)epdArrays[muEpdHit]->UncheckedAt(i); }  // MALisa
 
+  static StMuFwdTrack* fwdTrack(int i) { return (StMuFwdTrack*)fwdTrackArrays[muFwdTrack]->UncheckedAt(i); }
+
   static StMuMtdHit* mtdHit(int i) { return (StMuMtdHit*)mtdArrays[muMTDHit]->UncheckedAt(i); }
     static StMuMtdRawHit* mtdRawHit(int i) { return (StMuMtdRawHit*)mtdArrays[muMTDRawHit]->UncheckedAt(i); }
     static StMuMtdHeader* mtdHeader() { return (StMuMtdHeader*)mtdArrays[muMTDHeader]->UncheckedAt(0); } 
@@ -468,6 +478,8 @@ public:
 
   static unsigned int numberOfEpdHit()       { return epdArrays[muEpdHit]->GetEntriesFast(); }
 
+  static unsigned int numberOfFwdTrack()     { return fwdTrackArrays[muFwdTrack]->GetEntriesFast(); }
+
   static unsigned int numberOfMTDHit()       { return mtdArrays[muMTDHit]->GetEntriesFast(); }
   static unsigned int numberOfBMTDRawHit()    { return mtdArrays[muMTDRawHit]->GetEntriesFast(); }
     
@@ -505,6 +517,8 @@ public:
 
   static unsigned int GetNEpdHit()         { return numberOfEpdHit(); }
 
+  static unsigned int GetNFwdTrack()       { return numberOfFwdTrack(); }
+
   static unsigned int GetNMTDHit()         { return numberOfMTDHit(); }
   static unsigned int GetNMTDRawHit()      { return numberOfBMTDRawHit(); }
     
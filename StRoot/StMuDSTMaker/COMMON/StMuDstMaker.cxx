@@ -73,6 +73,8 @@
 #include "StMuFstUtil.h"
 #include "StMuFstRawHit.h"
 #include "StMuFstHit.h"
+#include "StMuFwdTrack.h"
+#include "StMuFcsCluster.h"
 #include "StMuEpdHit.h"  // MALisa
 #include "StMuEpdHitCollection.h"  // MALisa
 #include "StEvent/StEpdCollection.h" // MALisa
@@ -220,7 +222,8 @@ void StMuDstMaker::assignArrays()
   mFcsArrays      = mFmsArrays     + __NFMSARRAYS__;  
   mFttArrays      = mFcsArrays     + __NFCSARRAYS__;  
   mFstArrays      = mFttArrays     + __NFTTARRAYS__;  
-  mTofArrays      = mFstArrays     + __NFSTARRAYS__;    
+  mFwdTrackArrays = mFstArrays     + __NFSTARRAYS__;
+  mTofArrays      = mFwdTrackArrays + __NFWDTRACKARRAYS__;
   mBTofArrays     = mTofArrays     + __NTOFARRAYS__;    /// dongx
   mETofArrays     = mBTofArrays    + __NBTOFARRAYS__;   /// jdb
   mEpdArrays      = mETofArrays    + __NETOFARRAYS__;   /// MALisa
@@ -242,6 +245,7 @@ void StMuDstMaker::clearArrays()
     __NFCSARRAYS__+
     __NFTTARRAYS__+
     __NFSTARRAYS__+
+    __NFWDTRACKARRAYS__+
     __NTOFARRAYS__+
     __NBTOFARRAYS__+  /// dongx
     __NETOFARRAYS__+ //jdb
@@ -275,6 +279,7 @@ void StMuDstMaker::zeroArrays()
             __NFCSARRAYS__+
             __NFTTARRAYS__+
             __NFSTARRAYS__+
+            __NFWDTRACKARRAYS__+
             __NTOFARRAYS__+
             __NBTOFARRAYS__+ /// dongx
             __NETOFARRAYS__+ //jdb
@@ -296,6 +301,7 @@ void StMuDstMaker::zeroArrays()
    TofAll     - all branches related to Tof
    BTofAll    - all branches related to BTof  /// dongx
    ETofAll    - all branches related to ETof  /// fseck
+   FwdTrackAll - all branches related to forward tracks
    MTDAll     - all branches related to MTD
    FgtAll     - all branches related to Fgt
 
@@ -320,16 +326,16 @@ void StMuDstMaker::zeroArrays()
 void StMuDstMaker::SetStatus(const char *arrType,int status)
 {
 #ifndef __NO_STRANGE_MUDST__
-  static const char *specNames[]={"MuEventAll","StrangeAll","MCAll","EmcAll","PmdAll","FMSAll","FcsAll","FttAll","FstAll","TofAll","BTofAll","ETofAll","EpdAll","MTDAll","FgtAll","EztAll",0};  /// dongx, MALisa
+  static const char *specNames[]={"MuEventAll","StrangeAll","MCAll","EmcAll","PmdAll","FMSAll","FcsAll","FttAll","FstAll","FwdTrackAll","TofAll","BTofAll","ETofAll","EpdAll","MTDAll","FgtAll","EztAll",0};  /// dongx, MALisa
 #else
-  static const char *specNames[]={"MuEventAll",             "MCAll","EmcAll","PmdAll","FMSAll","FcsAll","FttAll","FstAll","TofAll","BTofAll","ETofAll","EpdAll","MTDAll","FgtAll","EztAll",0};  /// dongx, MALisa
+  static const char *specNames[]={"MuEventAll",             "MCAll","EmcAll","PmdAll","FMSAll","FcsAll","FttAll","FstAll","FwdTrackAll","TofAll","BTofAll","ETofAll","EpdAll","MTDAll","FgtAll","EztAll",0};  /// dongx, MALisa
 #endif
   static const int   specIndex[]={
   0, __NARRAYS__,
   #ifndef __NO_STRANGE_MUDST__
       __NSTRANGEARRAYS__,
   #endif
-  __NMCARRAYS__,__NEMCARRAYS__,__NPMDARRAYS__,__NFMSARRAYS__,__NFCSARRAYS__,__NFTTARRAYS__,__NFSTARRAYS__,__NTOFARRAYS__,__NBTOFARRAYS__,__NETOFARRAYS__,__NEPDARRAYS__,__NMTDARRAYS__,__NFGTARRAYS__,__NEZTARRAYS__,-1};
+  __NMCARRAYS__,__NEMCARRAYS__,__NPMDARRAYS__,__NFMSARRAYS__,__NFCSARRAYS__,__NFTTARRAYS__,__NFSTARRAYS__,__NFWDTRACKARRAYS__,__NTOFARRAYS__,__NBTOFARRAYS__,__NETOFARRAYS__,__NEPDARRAYS__,__NMTDARRAYS__,__NFGTARRAYS__,__NEZTARRAYS__,-1};
 
     // jdb fixed with new implementation, 
     // this method was broken for several years
@@ -1025,6 +1031,7 @@ void StMuDstMaker::fillTrees(StEvent* ev, StMuCut* cut){
     fillFcs(ev);
     fillFtt(ev);
     fillFst(ev);
+    fillFwdTrack(ev);
     fillTof(ev);
     fillBTof(ev); 
     fillETof(ev);
@@ -1224,6 +1231,55 @@ void StMuDstMaker::fillFst(StEvent* ev) {
 }
 //-----------------------------------------------------------------------
 //-----------------------------------------------------------------------
+/// The matched FCS clusters are stored as indices into the StMuFcsCollection
+/// cluster array, so this has to run after fillFcs
+void StMuDstMaker::fillFwdTrack(StEvent* ev) {
+  DEBUGMESSAGE2("");
+  StFwdTrackCollection* fwdcol=(StFwdTrackCollection*)ev->fwdTrackCollection();
+  if (!fwdcol)  return; //throw StMuExceptionNullPointer("no StFwdTrackCollection",__PRETTYF__);
+  StTimer timer;
+  timer.start();
+
+  const StSPtrVecFwdTrack& tracks = fwdcol->tracks();
+  for (unsigned int i=0; i<tracks.size(); i++) {
+    const StFwdTrack* track = tracks[i];
+    StMuFwdTrack muTrack;
+    muTrack.setStatus( (track->fitConverged() ? StMuFwdTrack::kFitConverged : 0) | (track->fstRefit() ? StMuFwdTrack::kFstRefit : 0) );
+    muTrack.setCharge( track->charge() );
+    muTrack.setChi2( track->chi2() );
+    muTrack.setNdf( track->ndf() );
+    muTrack.setNHits( track->nFttHits(), track->nFstHits() );
+    muTrack.setIdTruth( track->idTruth(), track->qaTruth() );
+    const StThreeVectorF& p = track->momentum();
+    const StThreeVectorF& x = track->origin();
+    muTrack.setMomentum( TVector3(p.x(), p.y(), p.z()) );
+    muTrack.setOrigin( TVector3(x.x(), x.y(), x.z()) );
+    // StFwdTrack and StMuFwdTrack number the projection planes the same way
+    for (int iPlane=0; iPlane<StFwdTrack::kNProjections; iPlane++) {
+      if ( !track->hasProjection(iPlane) ) continue;
+      const StThreeVectorF& proj = track->projection(iPlane);
+      muTrack.setProjection( iPlane, TVector3(proj.x(), proj.y(), proj.z()), track->projectionSigmaXY(iPlane) );
+    }
+    int ecal = fcsClusterIndex( track->ecalCluster() );
+    if ( ecal >= 0 ) muTrack.setEcalMatch( ecal, track->ecalMatchDistance(), track->ecalEoverP() );
+    int hcal = fcsClusterIndex( track->hcalCluster() );
+    if ( hcal >= 0 ) muTrack.setHcalMatch( hcal, track->hcalMatchDistance(), track->hcalEoverP() );
+    addType( mFwdTrackArrays[muFwdTrack], muTrack );
+  }
+
+  timer.stop();
+  DEBUGVALUE2(timer.elapsedTime());
+}
+//-----------------------------------------------------------------------
+//-----------------------------------------------------------------------
+/// Index of the StMuFcsCluster made from the cluster in the MuDst cluster array, -1 if none
+int StMuDstMaker::fcsClusterIndex(const StFcsCluster* cluster) {
+  if (!cluster || !mFcsCollection) return -1;
+  StMuFcsCluster* muCluster = mFcsUtil->getMuFcsCluster(cluster);
+  return muCluster ? mFcsArrays[muFcsCluster]->IndexOf(muCluster) : -1;
+}
+//-----------------------------------------------------------------------
+//-----------------------------------------------------------------------
 void StMuDstMaker::fillPmd(StEvent* ev) {
   DEBUGMESSAGE2("");
   StPhmdCollection* phmdColl=(StPhmdCollection*)ev->phmdCollection();
@@ -1548,7 +1604,7 @@ void StMuDstMaker::fillEzt(StEvent* ev) {
 #ifndef __NO_STRANGE_MUDST__
                       __NSTRANGEARRAYS__+
 #endif
-                      __NMCARRAYS__+__NEMCARRAYS__+__NPMDARRAYS__+__NFMSARRAYS__+__NFCSARRAYS__+__NFTTARRAYS__+__NFSTARRAYS__+
+                      __NMCARRAYS__+__NEMCARRAYS__+__NPMDARRAYS__+__NFMSARRAYS__+__NFCSARRAYS__+__NFTTARRAYS__+__NFSTARRAYS__+__NFWDTRACKARRAYS__+
 				      __NTOFARRAYS__+__NBTOFARRAYS__+__NETOFARRAYS__+__NEPDARRAYS__+__NMTDARRAYS__+__NFGTARRAYS__]; /// dongx, MALisa
   if(eztArrayStatus[muEztHead]){
     EztEventHeader* header = mEzTree->copyHeader(ev);
@@ -63,6 +63,7 @@ class StMuFmsUtil;
 /// fcs stuff
 #include "StMuFcsCollection.h"
 class StMuFcsUtil;
+class StFcsCluster;
 
 /// ftt stuff
 #include "StMuFttCollection.h"
@@ -307,6 +308,8 @@ virtual   void closeRead();
   void fillFcs(StEvent* ev);
   void fillFtt(StEvent* ev);
   void fillFst(StEvent* ev);
+  void fillFwdTrack(StEvent* ev);
+  int  fcsClusterIndex(const StFcsCluster* cluster);
 #ifndef __NO_STRANGE_MUDST__
   void fillStrange(StStrangeMuDstMaker*);
 #endif
@@ -377,6 +380,7 @@ virtual   void closeRead();
   TClonesArray** mFcsArrays;    //[__NFCSARRAYS__    ];
   TClonesArray** mFttArrays;    //[__NFTTARRAYS__    ];
   TClonesArray** mFstArrays;    //[__NFSTARRAYS__    ];
+  TClonesArray** mFwdTrackArrays; //[__NFWDTRACKARRAYS__];
   TClonesArray** mPmdArrays;    //[__NPMDARRAYS__    ];
   TClonesArray** mTofArrays;    //[__NTOFARRAYS__    ];
   /// dongx
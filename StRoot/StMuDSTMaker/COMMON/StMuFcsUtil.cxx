@@ -68,6 +68,12 @@ void StMuFcsUtil::fillFcs(StFcsCollection* fcscol,StMuFcsCollection* muFcs)
   fillFcsHits(fcscol, muFcs);
 } // fillFcs
 
+StMuFcsCluster* StMuFcsUtil::getMuFcsCluster(const StFcsCluster* cluster) const
+{
+  map< const StFcsCluster*, StMuFcsCluster* >::const_iterator it = mMapClusters.find( cluster );
+  return it == mMapClusters.end() ? 0 : it->second;
+} // getMuFcsCluster
+
 void StMuFcsUtil::fillMuFcsHits(StMuFcsCollection* muFcs,
                                 StFcsCollection* fcscol) {
   
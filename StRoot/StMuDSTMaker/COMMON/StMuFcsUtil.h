@@ -22,6 +22,8 @@ public:
   StFcsCollection*   getFcs(StMuFcsCollection*);
   void               fillMuFcs(StMuFcsCollection*,StFcsCollection*);
   void               fillFcs(StFcsCollection*,StMuFcsCollection*);
+  /** StMuFcsCluster filled from the StFcsCluster by the last fillMuFcs, 0 if none */
+  StMuFcsCluster*    getMuFcsCluster(const StFcsCluster*) const;
   
 
 private:
@@ -0,0 +1,47 @@
+/***************************************************************************
+ *
+ * StMuFwdTrack.cxx
+ *
+ ***************************************************************************
+ *
+ * Description: Implementation of StMuFwdTrack, the compact forward track
+ *
+ ***************************************************************************/
+#include "StMuFwdTrack.h"
+#include "St_base/StMessMgr.h"
+
+ClassImp(StMuFwdTrack)
+
+StMuFwdTrack::StMuFwdTrack() : TObject(),
+    mStatus(0), mCharge(0), mNdf(0), mNHits(0), mIdTruth(0), mQaTruth(0), mChi2(0),
+    mProjected(0), mEcalCluster(-1), mHcalCluster(-1),
+    mEcalMatchDist(0), mHcalMatchDist(0), mEcalEoverP(0), mHcalEoverP(0) {
+    for ( int i = 0; i < 3; i++ ) {
+        mMomentum[i] = 0;
+        mOrigin[i] = 0;
+    }
+    for ( int i = 0; i < kNProjections; i++ ) {
+        mProjX[i] = mProjY[i] = mProjZ[i] = 0;
+        mProjSigma[i] = 0;
+    }
+}
+
+StMuFwdTrack::~StMuFwdTrack() { /* no op */ }
+
+void StMuFwdTrack::setProjection(int plane, const TVector3& x, float sigmaXY) {
+    if ( plane < 0 || plane >= kNProjections )
+        return;
+    mProjected |= ( 1 << plane );
+    mProjX[plane] = x.X();
+    mProjY[plane] = x.Y();
+    mProjZ[plane] = x.Z();
+    mProjSigma[plane] = sigmaXY;
+}
+
+void StMuFwdTrack::print(int opt) {
+    LOG_INFO << "StMuFwdTrack: q = " << (int)mCharge << ", pt = " << pt() << ", eta = " << eta() << ", phi = " << phi()
+             << ", converged = " << fitConverged() << ", chi2/ndf = " << chi2() << "/" << ndf()
+             << ", nFtt = " << nFttHits() << ", nFst = " << nFstHits()
+             << ", ecal = " << mEcalCluster << " (d = " << ecalMatchDistance() << ", E/p = " << ecalEoverP() << ")"
+             << ", hcal = " << mHcalCluster << " (d = " << hcalMatchDistance() << ", E/p = " << hcalEoverP() << ")" << endm;
+}
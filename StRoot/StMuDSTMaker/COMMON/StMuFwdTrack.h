@@ -0,0 +1,142 @@
+/**************************************************************************
+ *
+ * StMuFwdTrack.h
+ *
+ **************************************************************************
+ *
+ * Description: Compact forward (FST + FTT) track in StMuDst
+ *
+ * Filled by StMuDstMaker from the StFwdTrack of StEvent: the fitted state at
+ * the first measurement, the projections of the track to the FST, FTT, FCS
+ * ECal and HCal planes and the FCS clusters matched to it.
+ * Floating point members are Float16_t with a truncated mantissa (3 bytes on
+ * disk). The 14 mantissa bits of the positions give a relative precision of
+ * 2^-14, i.e. ~0.006 cm for x, y < 100 cm and ~0.04 cm for z ~ 700 cm.
+ *
+ **************************************************************************/
+#ifndef StMuFwdTrack_h
+#define StMuFwdTrack_h
+
+#include <TVector3.h>
+#include <TObject.h>
+
+class StMuFwdTrack : public TObject {
+public:
+    /// planes the track is projected to
+    enum ProjectionPlane { kFst0=0, kFst1, kFst2, kFtt0, kFtt1, kFtt2, kFtt3, kEcal, kHcal, kNProjections };
+    enum StatusBit { kFitConverged=1, kFstRefit=2 };
+
+    StMuFwdTrack();
+    ~StMuFwdTrack();
+
+    bool    fitConverged() const;
+    bool    fstRefit()     const; // refit with the FST hits
+    short   charge()       const;
+    float   chi2()         const;
+    int     ndf()          const;
+    int     nFttHits()     const;
+    int     nFstHits()     const;
+    int     idTruth()      const; // dominant MC track of the seed
+    int     qaTruth()      const; // % of the seed hits from idTruth
+
+    TVector3 momentum() const; // at the first point of the fit
+    TVector3 origin()   const; // first point of the fit
+    float    pt()       const;
+    float    eta()      const;
+    float    phi()      const;
+
+    bool     hasProjection(int plane) const;
+    TVector3 projection(int plane)    const; // position on the plane (cm)
+    float    projectionSigmaXY(int plane) const; // sqrt(sx^2 + sy^2) of the projected position (cm)
+
+    // index of the matched FCS cluster in the cluster array of StMuFcsCollection, -1 if none
+    short ecalClusterIndex() const;
+    short hcalClusterIndex() const;
+    // x-y distance (cm) between the track and the matched cluster, at the z of the cluster, -1 if none
+    float ecalMatchDistance() const;
+    float hcalMatchDistance() const;
+    // energy of the matched cluster over the track momentum, 0 if none
+    float ecalEoverP() const;
+    float hcalEoverP() const;
+
+    void setStatus(UChar_t status);
+    void setCharge(short q);
+    void setChi2(float chi2);
+    void setNdf(int ndf);
+    void setNHits(int nFtt, int nFst);
+    void setIdTruth(int idTruth, int qaTruth);
+    void setMomentum(const TVector3& p);
+    void setOrigin(const TVector3& x);
+    void setProjection(int plane, const TVector3& x, float sigmaXY);
+    void setEcalClusterIndex(short index);
+    void setHcalClusterIndex(short index);
+    void setEcalMatch(short index, float distance, float eOverP);
+    void setHcalMatch(short index, float distance, float eOverP);
+
+    void print(int option=0);
+
+private:
+    UChar_t   mStatus;
+    Char_t    mCharge;
+    UChar_t   mNdf;
+    UChar_t   mNHits;                       // nFtt + 16*nFst
+    Int_t     mIdTruth;
+    UChar_t   mQaTruth;
+    Float16_t mChi2;                        //[0,0,10]
+    Float16_t mMomentum[3];                 //[0,0,14]
+    Float16_t mOrigin[3];                   //[0,0,14]
+
+    UShort_t  mProjected;                   // bit i set if the projection to plane i exists
+    Float16_t mProjX[kNProjections];        //[0,0,14]
+    Float16_t mProjY[kNProjections];        //[0,0,14]
+    Float16_t mProjZ[kNProjections];        //[0,0,14]
+    Float16_t mProjSigma[kNProjections];    //[0,0,8]
+
+    Short_t   mEcalCluster;
+    Short_t   mHcalCluster;
+    Float16_t mEcalMatchDist;               //[0,0,10]
+    Float16_t mHcalMatchDist;               //[0,0,10]
+    Float16_t mEcalEoverP;                  //[0,0,10]
+    Float16_t mHcalEoverP;                  //[0,0,10]
+
+    ClassDef(StMuFwdTrack, 1)
+};
+
+inline bool  StMuFwdTrack::fitConverged() const { return mStatus & kFitConverged; }
+inline bool  StMuFwdTrack::fstRefit() const { return mStatus & kFstRefit; }
+inline short StMuFwdTrack::charge() const { return mCharge; }
+inline float StMuFwdTrack::chi2() const { return mChi2; }
+inline int   StMuFwdTrack::ndf() const { return mNdf; }
+inline int   StMuFwdTrack::nFttHits() const { return mNHits & 0xF; }
+inline int   StMuFwdTrack::nFstHits() const { return mNHits >> 4; }
+inline int   StMuFwdTrack::idTruth() const { return mIdTruth; }
+inline int   StMuFwdTrack::qaTruth() const { return mQaTruth; }
+inline TVector3 StMuFwdTrack::momentum() const { return TVector3( mMomentum[0], mMomentum[1], mMomentum[2] ); }
+inline TVector3 StMuFwdTrack::origin() const { return TVector3( mOrigin[0], mOrigin[1], mOrigin[2] ); }
+inline float StMuFwdTrack::pt() const { return momentum().Perp(); }
+inline float StMuFwdTrack::eta() const { return momentum().Eta(); }
+inline float StMuFwdTrack::phi() const { return momentum().Phi(); }
+inline bool  StMuFwdTrack::hasProjection(int plane) const { return plane >= 0 && plane < kNProjections && ( mProjected >> plane & 1 ); }
+inline TVector3 StMuFwdTrack::projection(int plane) const { return hasProjection(plane) ? TVector3( mProjX[plane], mProjY[plane], mProjZ[plane] ) : TVector3( 0, 0, 0 ); }
+inline float StMuFwdTrack::projectionSigmaXY(int plane) const { return hasProjection(plane) ? (float)mProjSigma[plane] : -1; }
+inline short StMuFwdTrack::ecalClusterIndex() const { return mEcalCluster; }
+inline short StMuFwdTrack::hcalClusterIndex() const { return mHcalCluster; }
+inline float StMuFwdTrack::ecalMatchDistance() const { return mEcalCluster >= 0 ? (float)mEcalMatchDist : -1; }
+inline float StMuFwdTrack::hcalMatchDistance() const { return mHcalCluster >= 0 ? (float)mHcalMatchDist : -1; }
+inline float StMuFwdTrack::ecalEoverP() const { return mEcalEoverP; }
+inline float StMuFwdTrack::hcalEoverP() const { return mHcalEoverP; }
+
+inline void StMuFwdTrack::setStatus(UChar_t status) { mStatus = status; }
+inline void StMuFwdTrack::setCharge(short q) { mCharge = q; }
+inline void StMuFwdTrack::setChi2(float chi2) { mChi2 = chi2; }
+inline void StMuFwdTrack::setNdf(int ndf) { mNdf = ndf < 0 ? 0 : ( ndf > 255 ? 255 : ndf ); }
+inline void StMuFwdTrack::setNHits(int nFtt, int nFst) { mNHits = ( nFtt & 0xF ) | ( ( nFst & 0xF ) << 4 ); }
+inline void StMuFwdTrack::setIdTruth(int idTruth, int qaTruth) { mIdTruth = idTruth; mQaTruth = qaTruth; }
+inline void StMuFwdTrack::setMomentum(const TVector3& p) { mMomentum[0] = p.X(); mMomentum[1] = p.Y(); mMomentum[2] = p.Z(); }
+inline void StMuFwdTrack::setOrigin(const TVector3& x) { mOrigin[0] = x.X(); mOrigin[1] = x.Y(); mOrigin[2] = x.Z(); }
+inline void StMuFwdTrack::setEcalClusterIndex(short index) { mEcalCluster = index; }
+inline void StMuFwdTrack::setHcalClusterIndex(short index) { mHcalCluster = index; }
+inline void StMuFwdTrack::setEcalMatch(short index, float distance, float eOverP) { mEcalCluster = index; mEcalMatchDist = distance; mEcalEoverP = eOverP; }
+inline void StMuFwdTrack::setHcalMatch(short index, float distance, float eOverP) { mHcalCluster = index; mHcalMatchDist = distance; mHcalEoverP = eOverP; }
+
+#endif  // StMuFwdTrack_h
@@ -59,6 +59,7 @@
 #include "StMuDSTMaker/COMMON/StMuETofHeader.h"
 #include "StMuDSTMaker/COMMON/StMuMcTrack.h"
 #include "StMuDSTMaker/COMMON/StMuMcVertex.h"
+#include "StMuDSTMaker/COMMON/StMuFwdTrack.h"
 
 #include "StTriggerUtilities/StTriggerSimuMaker.h"
 #include "StTriggerUtilities/Bemc/StBemcTriggerSimu.h"
@@ -96,6 +97,7 @@
 #include "StPicoEvent/StPicoETofPidTraits.h"
 #include "StPicoEvent/StPicoMcVertex.h"
 #include "StPicoEvent/StPicoMcTrack.h"
+#include "StPicoEvent/StPicoFwdTrack.h"
 #include "StPicoEvent/StPicoArrays.h"
 #include "StPicoEvent/StPicoDst.h"
 #include "StPicoDstMaker/StPicoDstMaker.h"
@@ -247,6 +249,7 @@ void StPicoDstMaker::streamerOff() {
   StPicoETofPidTraits::Class()->IgnoreTObjectStreamer();
   StPicoMcVertex::Class()->IgnoreTObjectStreamer();
   StPicoMcTrack::Class()->IgnoreTObjectStreamer();
+  StPicoFwdTrack::Class()->IgnoreTObjectStreamer();
 }
 
 //_________________
@@ -893,6 +896,7 @@ Int_t StPicoDstMaker::MakeWrite() {
   fillEpdHits();
   fillBbcHits();
   fillETofHits();
+  fillFwdTracks();
 
   // Could be a good idea to move this call to Init() or InitRun()
   StFmsDbMaker* fmsDbMaker = static_cast<StFmsDbMaker*>(GetMaker("fmsDb"));
@@ -1002,6 +1006,51 @@ void StPicoDstMaker::fillMcTracks() {
   } // for (Int_t iVtx=0; iVtx<mcVertices->GetEntriesFast(); iVtx++)
 }
 
+//_________________
+void StPicoDstMaker::fillFwdTracks() {
+
+  // Loop over forward tracks
+  for (UInt_t iTrk=0; iTrk<mMuDst->numberOfFwdTrack(); iTrk++) {
+
+    // Retrieve i-th forward track from MuDst
+    StMuFwdTrack *muFwdTrack = mMuDst->fwdTrack(iTrk);
+    if ( !muFwdTrack ) continue;
+
+    // Obtain size of the forward track pico array
+    int counter = mPicoArrays[StPicoArrays::FwdTrack]->GetEntries();
+
+    // Create new empty StPicoFwdTrack and add it into collection
+    new((*(mPicoArrays[StPicoArrays::FwdTrack]))[counter]) StPicoFwdTrack();
+
+    // Return pointer to the picoFwdTrack
+    StPicoFwdTrack* picoFwdTrack = (StPicoFwdTrack*)mPicoArrays[StPicoArrays::FwdTrack]->At(counter);
+
+    UChar_t status = 0;
+    if ( muFwdTrack->fitConverged() ) status |= StPicoFwdTrack::kFitConverged;
+    if ( muFwdTrack->fstRefit() ) status |= StPicoFwdTrack::kFstRefit;
+    picoFwdTrack->setStatus( status );
+    picoFwdTrack->setCharge( muFwdTrack->charge() );
+    picoFwdTrack->setChi2( muFwdTrack->chi2(), muFwdTrack->ndf() );
+    picoFwdTrack->setNHits( muFwdTrack->nFttHits(), muFwdTrack->nFstHits() );
+    picoFwdTrack->setIdTruth( muFwdTrack->idTruth(), muFwdTrack->qaTruth() );
+    picoFwdTrack->setMomentum( muFwdTrack->momentum() );
+    picoFwdTrack->setOrigin( muFwdTrack->origin() );
+    for (Int_t iPlane=0; iPlane<StMuFwdTrack::kNProjections; iPlane++) {
+      if ( muFwdTrack->hasProjection(iPlane) ) {
+	picoFwdTrack->setProjection( iPlane, muFwdTrack->projection(iPlane),
+				     muFwdTrack->projectionSigmaXY(iPlane) );
+      }
+    }
+    if ( muFwdTrack->ecalClusterIndex() >= 0 ) {
+      picoFwdTrack->setEcalMatch( muFwdTrack->ecalMatchDistance(), muFwdTrack->ecalEoverP() );
+    }
+    if ( muFwdTrack->hcalClusterIndex() >= 0 ) {
+      picoFwdTrack->setHcalMatch( muFwdTrack->hcalMatchDistance(), muFwdTrack->hcalEoverP() );
+    }
+
+  } // for (UInt_t iTrk=0; iTrk<mMuDst->numberOfFwdTrack(); iTrk++)
+}
+
 //_________________
 void StPicoDstMaker::fillTracks() {
 
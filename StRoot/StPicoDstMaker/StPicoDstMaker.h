@@ -229,6 +229,8 @@ class StPicoDstMaker : public StMaker {
   void fillMcVertices();
   /// Fill MC track information
   void fillMcTracks();
+  /// Fill forward track information
+  void fillFwdTracks();
 
 
  /**
@@ -26,7 +26,8 @@ const char* StPicoArrays::picoArrayNames [NAllPicoArrays] = { "Event",
                                                               "ETofHit",
                                                               "ETofPidTraits",
 							      "McVertex",
-                                                              "McTrack"
+                                                              "McTrack",
+                                                              "FwdTrack"
 };
 
 //   ARRAY TYPES
@@ -50,7 +51,8 @@ const char* StPicoArrays::picoArrayTypes [NAllPicoArrays] = { "StPicoEvent",
                                                               "StPicoETofHit",
                                                               "StPicoETofPidTraits",
 							      "StPicoMcVertex",
-                                                              "StPicoMcTrack"
+                                                              "StPicoMcTrack",
+                                                              "StPicoFwdTrack"
 };
 
 //              ARRAY SIZES
@@ -77,7 +79,8 @@ int StPicoArrays::picoArraySizes [NAllPicoArrays] = { 1,    // StPicoEvent
                                                       100,  // StPicoETofHit
                                                       100,  // StPicoETofPidTraits
 						      10,   // StPicoMcVertex
-                                                      1000  // StPicoMcTrack
+                                                      1000, // StPicoMcTrack
+                                                      100   // StPicoFwdTrack
 };
 
 //_________________
@@ -21,6 +21,7 @@
 #include "StPicoETofPidTraits.h"
 #include "StPicoMcVertex.h"
 #include "StPicoMcTrack.h"
+#include "StPicoFwdTrack.h"
 #include "StPicoDst.h"          //MUST be the last one
 
 TClonesArray** StPicoDst::picoArrays = 0;
@@ -93,6 +94,23 @@ void StPicoDst::printMcTracks() {
   LOG_INFO << endm;
 }
 
+//_________________
+void StPicoDst::printFwdTracks() {
+  if(numberOfFwdTracks() == 0) {
+    LOG_INFO << "No forward tracks found!" << endm;
+    return;
+  }
+
+  LOG_INFO << "\n+++++++++ forward track list ( " << numberOfFwdTracks() << " entries )\n\n";
+  for(UInt_t iTrk=0; iTrk<numberOfFwdTracks(); iTrk++) {
+    LOG_INFO << "+++ forward track " << iTrk << "\n";
+    fwdTrack(iTrk)->Print();
+    LOG_INFO << "\n";
+  }
+
+  LOG_INFO << endm;
+}
+
 //_________________
 void StPicoDst::printTriggers() {
 
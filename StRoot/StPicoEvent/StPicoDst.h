@@ -35,6 +35,7 @@ class StPicoETofHit;
 class StPicoETofPidTraits;
 class StPicoMcVertex;
 class StPicoMcTrack;
+class StPicoFwdTrack;
 
 //_________________
 class StPicoDst {
@@ -99,6 +100,8 @@ class StPicoDst {
   static StPicoMcVertex* mcVertex(Int_t i) { return (StPicoMcVertex*)picoArrays[StPicoArrays::McVertex]->UncheckedAt(i); }
   /// Return pointer to i-th MC track
   static StPicoMcTrack* mcTrack(Int_t i) { return (StPicoMcTrack*)picoArrays[StPicoArrays::McTrack]->UncheckedAt(i); }
+  /// Return pointer to i-th forward track
+  static StPicoFwdTrack* fwdTrack(Int_t i) { return (StPicoFwdTrack*)picoArrays[StPicoArrays::FwdTrack]->UncheckedAt(i); }
 
   /// Return number of tracks
   static UInt_t numberOfTracks() { return picoArrays[StPicoArrays::Track]->GetEntriesFast(); }
@@ -138,6 +141,8 @@ class StPicoDst {
   static UInt_t numberOfMcVertices() { return picoArrays[StPicoArrays::McVertex]->GetEntriesFast(); }
   /// Return number of MC tracks
   static UInt_t numberOfMcTracks() { return picoArrays[StPicoArrays::McTrack]->GetEntriesFast(); }
+  /// Return number of forward tracks
+  static UInt_t numberOfFwdTracks() { return picoArrays[StPicoArrays::FwdTrack]->GetEntriesFast(); }
 
   /// Print information
   void print() const;
@@ -173,6 +178,8 @@ class StPicoDst {
   static void printMcVertices();
   /// Print MC track info
   static void printMcTracks();
+  /// Print forward track info
+  static void printFwdTracks();
 
 #if defined (__TFG__VERSION__)
   static StPicoDst *instance() {return fgPicoDst;}
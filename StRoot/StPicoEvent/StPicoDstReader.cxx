@@ -32,6 +32,7 @@
 #include "StPicoETofPidTraits.h"
 #include "StPicoMcVertex.h"
 #include "StPicoMcTrack.h"
+#include "StPicoFwdTrack.h"
 #include "StPicoArrays.h"
 #include "StPicoDst.h"
 
@@ -133,6 +134,7 @@ void StPicoDstReader::streamerOff() {
   StPicoETofPidTraits::Class()->IgnoreTObjectStreamer();
   StPicoMcVertex::Class()->IgnoreTObjectStreamer();
   StPicoMcTrack::Class()->IgnoreTObjectStreamer();
+  StPicoFwdTrack::Class()->IgnoreTObjectStreamer();
 }
 
 //_________________
@@ -0,0 +1,98 @@
+//
+// StPicoFwdTrack holds information about a forward (FST + FTT) track
+//
+
+// ROOT headers
+#include "TString.h"
+
+// PicoDst headers
+#include "StPicoMessMgr.h"
+#include "StPicoFwdTrack.h"
+
+ClassImp(StPicoFwdTrack)
+
+//_________________
+StPicoFwdTrack::StPicoFwdTrack() : TObject(),
+  mStatus(0), mCharge(0), mNdf(0), mNHits(0), mIdTruth(0), mQaTruth(0),
+  mChi2(0), mProjected(0),
+  mEcalMatchDist(0), mHcalMatchDist(0), mEcalEoverP(0), mHcalEoverP(0) {
+  // Default constructor
+  for (Int_t i = 0; i < 3; i++) {
+    mMomentum[i] = 0;
+    mOrigin[i] = 0;
+  }
+  for (Int_t i = 0; i < kNProjections; i++) {
+    mProjX[i] = 0;
+    mProjY[i] = 0;
+    mProjZ[i] = 0;
+    mProjSigma[i] = 0;
+  }
+}
+
+//_________________
+StPicoFwdTrack::StPicoFwdTrack(const StPicoFwdTrack& t) : TObject() {
+  // Copy constructor
+  mStatus = t.mStatus;
+  mCharge = t.mCharge;
+  mNdf = t.mNdf;
+  mNHits = t.mNHits;
+  mIdTruth = t.mIdTruth;
+  mQaTruth = t.mQaTruth;
+  mChi2 = t.mChi2;
+  for (Int_t i = 0; i < 3; i++) {
+    mMomentum[i] = t.mMomentum[i];
+    mOrigin[i] = t.mOrigin[i];
+  }
+  mProjected = t.mProjected;
+  for (Int_t i = 0; i < kNProjections; i++) {
+    mProjX[i] = t.mProjX[i];
+    mProjY[i] = t.mProjY[i];
+    mProjZ[i] = t.mProjZ[i];
+    mProjSigma[i] = t.mProjSigma[i];
+  }
+  mEcalMatchDist = t.mEcalMatchDist;
+  mHcalMatchDist = t.mHcalMatchDist;
+  mEcalEoverP = t.mEcalEoverP;
+  mHcalEoverP = t.mHcalEoverP;
+}
+
+//_________________
+StPicoFwdTrack::~StPicoFwdTrack() {
+  // Destructor
+  /* empty */
+}
+
+//_________________
+void StPicoFwdTrack::Print(const Char_t* option __attribute__((unused))) const {
+  LOG_INFO << "charge: " << charge() << " converged: " << fitConverged()
+	   << " chi2/ndf: " << chi2() << "/" << ndf()
+	   << " nFtt/nFst: " << nFttHits() << "/" << nFstHits()
+	   << Form(" pt/eta/phi: %5.2f/%5.2f/%5.2f", pt(), eta(), phi())
+	   << " ecal/hcal: " << hasEcalMatch() << "/" << hasHcalMatch()
+	   << " dist: " << ecalMatchDistance() << "/" << hcalMatchDistance()
+	   << " E/p: " << ecalEoverP() << "/" << hcalEoverP() << endm;
+}
+
+//_________________
+TVector3 StPicoFwdTrack::projection(Int_t plane) const {
+  if ( !hasProjection(plane) ) {
+    return TVector3(0, 0, 0);
+  }
+  return TVector3(mProjX[plane], mProjY[plane], mProjZ[plane]);
+}
+
+//_________________
+void StPicoFwdTrack::setChi2(Float_t chi2, Int_t ndf) {
+  mChi2 = chi2;
+  mNdf = ( ndf < 0 ) ? 0 : ( ( ndf > 255 ) ? 255 : ndf );
+}
+
+//_________________
+void StPicoFwdTrack::setProjection(Int_t plane, const TVector3 &x, Float_t sigmaXY) {
+  if ( plane < 0 || plane >= kNProjections ) return;
+  mProjected |= ( 1 << plane );
+  mProjX[plane] = x.X();
+  mProjY[plane] = x.Y();
+  mProjZ[plane] = x.Z();
+  mProjSigma[plane] = sigmaXY;
+}
@@ -0,0 +1,156 @@
+/**
+ * \class StPicoFwdTrack
+ * \brief Holds information about a forward (FST + FTT) track
+ *
+ * Copy of StMuFwdTrack: the fitted state at the first measurement, the
+ * projections of the track to the FST, FTT, FCS ECal and HCal planes
+ * and the match to the FCS clusters. The PicoDst has no FCS cluster
+ * array, so only the presence, distance and E/p of the matches are kept.
+ * Floating point members are stored as Float16_t with a truncated mantissa.
+ */
+
+#ifndef StPicoFwdTrack_h
+#define StPicoFwdTrack_h
+
+// ROOT headers
+#include "TObject.h"
+#include "TVector3.h"
+
+//_________________
+class StPicoFwdTrack : public TObject {
+
+ public:
+
+  /// Planes the track is projected to
+  enum ProjectionPlane { kFst0=0, kFst1, kFst2, kFtt0, kFtt1, kFtt2, kFtt3, kEcal, kHcal, kNProjections };
+  enum StatusBit { kFitConverged=1, kFstRefit=2, kEcalMatch=4, kHcalMatch=8 };
+
+  /// Default constructor
+  StPicoFwdTrack();
+  /// Copy constructor
+  StPicoFwdTrack(const StPicoFwdTrack &track);
+  /// Destructor
+  virtual ~StPicoFwdTrack();
+  /// Print forward track parameters
+  virtual void Print(const Char_t *option = "") const;
+
+  //
+  // Getters
+  //
+
+  /// Return true if the track fit converged
+  Bool_t fitConverged() const         { return mStatus & kFitConverged; }
+  /// Return true if the track was refit with FST hits
+  Bool_t fstRefit() const             { return mStatus & kFstRefit; }
+  /// Return fit status bits
+  UChar_t status() const              { return mStatus; }
+  /// Return charge
+  Short_t charge() const              { return mCharge; }
+  /// Return chi2 of the fit
+  Float_t chi2() const                { return mChi2; }
+  /// Return number of degrees of freedom of the fit
+  Int_t ndf() const                   { return mNdf; }
+  /// Return number of FTT hits
+  Int_t nFttHits() const              { return mNHits & 0xF; }
+  /// Return number of FST hits
+  Int_t nFstHits() const              { return mNHits >> 4; }
+  /// Return ID of the dominant MC track of the seed
+  Int_t idTruth() const               { return mIdTruth; }
+  /// Return percentage of the seed hits from idTruth
+  Int_t qaTruth() const               { return mQaTruth; }
+  /// Return momentum at the first point of the fit (GeV/c)
+  TVector3 momentum() const           { return TVector3(mMomentum[0], mMomentum[1], mMomentum[2]); }
+  /// Return first point of the fit (cm)
+  TVector3 origin() const             { return TVector3(mOrigin[0], mOrigin[1], mOrigin[2]); }
+  /// Return transverse momentum (GeV/c)
+  Float_t pt() const                  { return momentum().Perp(); }
+  /// Return pseudorapidity
+  Float_t eta() const                 { return momentum().Eta(); }
+  /// Return azimuthal angle
+  Float_t phi() const                 { return momentum().Phi(); }
+  /// Return true if the track has a projection to the plane
+  Bool_t hasProjection(Int_t plane) const { return plane >= 0 && plane < kNProjections && ( mProjected >> plane & 1 ); }
+  /// Return position of the track on the plane (cm)
+  TVector3 projection(Int_t plane) const;
+  /// Return sqrt(sx^2 + sy^2) of the projected position (cm), -1 if there is no projection
+  Float_t projectionSigmaXY(Int_t plane) const { return hasProjection(plane) ? (Float_t)mProjSigma[plane] : -1; }
+  /// Return true if the track is matched to an FCS ECal cluster
+  Bool_t hasEcalMatch() const         { return mStatus & kEcalMatch; }
+  /// Return true if the track is matched to an FCS HCal cluster
+  Bool_t hasHcalMatch() const         { return mStatus & kHcalMatch; }
+  /// Return x-y distance between the track and the matched ECal cluster (cm), -1 if none
+  Float_t ecalMatchDistance() const   { return hasEcalMatch() ? (Float_t)mEcalMatchDist : -1; }
+  /// Return x-y distance between the track and the matched HCal cluster (cm), -1 if none
+  Float_t hcalMatchDistance() const   { return hasHcalMatch() ? (Float_t)mHcalMatchDist : -1; }
+  /// Return energy of the matched ECal cluster over the track momentum, 0 if none
+  Float_t ecalEoverP() const          { return mEcalEoverP; }
+  /// Return energy of the matched HCal cluster over the track momentum, 0 if none
+  Float_t hcalEoverP() const          { return mHcalEoverP; }
+
+  //
+  // Setters
+  //
+
+  /// Set fit status bits
+  void setStatus(UChar_t status)      { mStatus = status; }
+  /// Set charge
+  void setCharge(Short_t q)           { mCharge = q; }
+  /// Set chi2 and number of degrees of freedom of the fit
+  void setChi2(Float_t chi2, Int_t ndf);
+  /// Set number of FTT and FST hits
+  void setNHits(Int_t nFtt, Int_t nFst) { mNHits = ( nFtt & 0xF ) | ( ( nFst & 0xF ) << 4 ); }
+  /// Set ID and percentage of the dominant MC track
+  void setIdTruth(Int_t id, Int_t qa) { mIdTruth = id; mQaTruth = qa; }
+  /// Set momentum at the first point of the fit
+  void setMomentum(const TVector3 &p) { mMomentum[0] = p.X(); mMomentum[1] = p.Y(); mMomentum[2] = p.Z(); }
+  /// Set first point of the fit
+  void setOrigin(const TVector3 &x)   { mOrigin[0] = x.X(); mOrigin[1] = x.Y(); mOrigin[2] = x.Z(); }
+  /// Set projection to the plane
+  void setProjection(Int_t plane, const TVector3 &x, Float_t sigmaXY);
+  /// Set matched FCS ECal cluster: distance and E/p
+  void setEcalMatch(Float_t distance, Float_t eOverP)
+  { mStatus |= kEcalMatch; mEcalMatchDist = distance; mEcalEoverP = eOverP; }
+  /// Set matched FCS HCal cluster: distance and E/p
+  void setHcalMatch(Float_t distance, Float_t eOverP)
+  { mStatus |= kHcalMatch; mHcalMatchDist = distance; mHcalEoverP = eOverP; }
+
+ private:
+  /// Fit status bits (StatusBit)
+  UChar_t   mStatus;
+  /// Charge
+  Char_t    mCharge;
+  /// Number of degrees of freedom of the fit
+  UChar_t   mNdf;
+  /// Number of hits: nFtt + 16*nFst
+  UChar_t   mNHits;
+  /// ID of the dominant MC track
+  Int_t     mIdTruth;
+  /// Percentage of the seed hits from idTruth
+  UChar_t   mQaTruth;
+  /// Chi2 of the fit
+  Float16_t mChi2;                      //[0,0,10]
+  /// Momentum at the first point of the fit
+  Float16_t mMomentum[3];               //[0,0,14]
+  /// First point of the fit
+  Float16_t mOrigin[3];                 //[0,0,14]
+
+  /// Bit i is set if the projection to plane i exists
+  UShort_t  mProjected;
+  /// Projected positions
+  Float16_t mProjX[kNProjections];      //[0,0,14]
+  Float16_t mProjY[kNProjections];      //[0,0,14]
+  Float16_t mProjZ[kNProjections];      //[0,0,14]
+  /// Uncertainty of the projected positions
+  Float16_t mProjSigma[kNProjections];  //[0,0,8]
+
+  /// Track-cluster distances at the z of the matched clusters
+  Float16_t mEcalMatchDist;             //[0,0,10]
+  Float16_t mHcalMatchDist;             //[0,0,10]
+  /// Energy of the matched clusters over the track momentum
+  Float16_t mEcalEoverP;                //[0,0,10]
+  Float16_t mHcalEoverP;                //[0,0,10]
+
+  ClassDef(StPicoFwdTrack, 1)
+};
+
+#endif
@@ -0,0 +1,59 @@
+/***************************************************************************
+ *
+ * StParallelFor.hh
+ *
+ ***************************************************************************
+ *
+ * Description:
+ * Runs func(index, worker) for every index in [0, n) on up to nThreads
+ * threads. The calling thread is worker 0, the others are 1 .. nThreads-1,
+ * so per-worker scratch space can be kept in a vector of nThreads entries.
+ * With nThreads <= 1 (or n <= 1) everything runs in index order on the
+ * calling thread.
+ *
+ * The indices are handed out dynamically, so the order in which they are
+ * processed depends on the scheduling. func must only write results that
+ * belong to its index (e.g. slot index of a preallocated vector), and not
+ * append to shared containers, so that the results do not depend on the
+ * number of threads.
+ *
+ * Example:
+ * std::vector<double> result(n);
+ * StParallelFor(n, nThreads, [&](size_t i, size_t worker){
+ *     result[i] = fit(input[i]);
+ * });
+ *
+ ***************************************************************************/
+#ifndef ST_PARALLEL_FOR_HH
+#define ST_PARALLEL_FOR_HH
+
+#include <cstddef>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+template<class Func>
+void StParallelFor(size_t n, size_t nThreads, Func func)
+{
+    if (nThreads > n) nThreads = n;
+    if (nThreads <= 1) {
+        for (size_t i = 0; i < n; i++)
+            func(i, 0);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    auto work = [&](size_t worker) {
+        for (size_t i = next++; i < n; i = next++)
+            func(i, worker);
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t w = 1; w < nThreads; w++)
+        threads.push_back(std::thread(work, w));
+    work(0);
+    for (auto &t : threads)
+        t.join();
+}
+
+#endif